@@ -48,6 +48,7 @@ class Bmp
 private:
    int width, height, imagesize, bytesPerLine, bits;
    unsigned char *data;
+   unsigned char *alfa; //mascara de transparencia (NULL = imagem opaca)
 
    HEADER     header;
    INFOHEADER info;
@@ -57,6 +58,8 @@ private:
 public:
    Bmp(const char *fileName);
    uchar* getImage();
+   uchar* getAlfa();
+   void   substituiDados(uchar *novosDados, uchar *novoAlfa, int novaLargura, int novaAltura);
    int    getWidth(void);
    int    getHeight(void);
    void   convertBGRtoRGB(void);
@@ -66,6 +69,7 @@ public:
    void aumentaBrilho(int fator);
    void flipV();
    void flipH();
+   void aplicaTabela(const unsigned char tabela[3][256]);
 };
 
 #endif
@@ -1,8 +1,13 @@
 #ifndef ___CAMADA__H___
 #define ___CAMADA__H___
 
+#include <vector>
+#include <stdint.h>
+
 #include "gl_canvas2d.h"
 #include "Bmp.h"
+#include "Reamostragem.h"
+#include "Histograma.h"
 
 class Camada
 {
@@ -14,6 +19,8 @@ class Camada
     Bmp *img;
     int imgX0, imgY0, imgWidth, imgHeight;
     int brilho;
+    int opacidade;    // 0 a 255
+    int modoMistura;  // ModoMistura (Composicao.h)
 
     unsigned char *data;
     //char *imagePath;
@@ -23,6 +30,16 @@ class Camada
     int idCamada;
     int idOriginalCamada;
 
+    // --- Transformacao (escala, rotacao, livre) ---
+    bool emTransformacao;
+    TransformacaoAfim transformacao;
+    std::vector<uint32_t> origemEmpacotada; // copia RGBA com borda, feita ao iniciar a transformacao
+    std::vector<uint32_t> preview;
+    int previewX0, previewY0, previewWidth, previewHeight;
+    bool previewSujo;
+
+    HistogramaCamada histograma;
+
 public:
     // Getters
     int getX0() const { return x0; }
@@ -41,6 +58,15 @@ public:
     int getImgX0() const { return imgX0; }
     int getImgY0() const { return imgY0; }
     int getBrilho() const { return brilho; }
+    bool getEmTransformacao() const { return emTransformacao; }
+    int getOpacidade() const { return opacidade; }
+    int getModoMistura() const { return modoMistura; }
+    const uint32_t* getPreview() const { return preview.empty() ? NULL : &preview[0]; }
+    int getPreviewX0() const { return previewX0; }
+    int getPreviewY0() const { return previewY0; }
+    int getPreviewWidth() const { return previewWidth; }
+    int getPreviewHeight() const { return previewHeight; }
+    HistogramaCamada& getHistograma() { return histograma; }
 
 
 
@@ -54,9 +80,11 @@ public:
     void setY1(int valor) { y1 = valor; }
     void setImgWidth(int valor) { imgWidth = valor; }
     void setImgHeight(int valor) { imgHeight = valor; }
-    void setImgX0(int valor) { imgX0 = valor; }
-    void setImgY0(int valor) { imgY0 = valor; }
+    void setImgX0(int valor) { marcaImagemSuja(); imgX0 = valor; marcaImagemSuja(); }
+    void setImgY0(int valor) { marcaImagemSuja(); imgY0 = valor; marcaImagemSuja(); }
     void setBrilho(int valor)  { brilho = valor; }
+    void setOpacidade(int valor) { opacidade = valor < 0 ? 0 : (valor > 255 ? 255 : valor); }
+    void setModoMistura(int valor) { modoMistura = valor; }
 
 
 
@@ -81,6 +109,9 @@ public:
         imgHeight=img->getHeight();
 
         visivel=_visible;
+        opacidade = 255;
+        modoMistura = 0;
+        cancelaTransformacao();
     }
 
     Camada(int _x0, int _y0, int _x1, int _y1, int _idCamada)
@@ -95,9 +126,13 @@ public:
         visivel = 0;
 
         hasImage = false;
+        opacidade = 255;
+        modoMistura = 0;
+        cancelaTransformacao();
     }
     void insereImagem(char *_imagePath)
     {
+        cancelaTransformacao();
         hasImage = true;
 
         imgX0 = 400;
@@ -106,13 +141,23 @@ public:
         img->convertBGRtoRGB();
         imgWidth=img->getWidth();
         imgHeight=img->getHeight();
+        histograma.marcaTudoSujo();
 
     }
 
 
+    // Marca no histograma os blocos cobertos pela imagem na posicao atual
+    void marcaImagemSuja()
+    {
+        if (hasImage)
+            histograma.marcaSujoTela(imgX0, imgY0, imgX0 + imgWidth, imgY0 + imgHeight);
+    }
+
     // Dentro da classe Camada
-    void inicializaMatriz(int largura, int altura)
+    void inicializaMatriz(int largura, int altura, int deslocX)
     {
+        histograma.inicializa(largura, altura, deslocX);
+
         matrizDesenho = (int **)malloc(altura * sizeof(int *));
         for (int i = 0; i < altura; i++)
             matrizDesenho[i] = (int *)malloc(largura * sizeof(int));
@@ -125,6 +170,149 @@ public:
 
 
 
+    // Copia a imagem atual para o buffer de origem e posiciona os cantos no retangulo da imagem.
+    void iniciaTransformacao()
+    {
+        if (!hasImage || emTransformacao)
+            return;
+
+        empacotaComBorda(img->getImage(), img->getAlfa(), imgWidth, imgHeight, origemEmpacotada);
+        transformacao.largura = imgWidth;
+        transformacao.altura = imgHeight;
+        transformacao.c0.set(imgX0, imgY0);
+        transformacao.c1.set(imgX0 + imgWidth, imgY0);
+        transformacao.c2.set(imgX0, imgY0 + imgHeight);
+        emTransformacao = true;
+        previewSujo = true;
+    }
+
+    Vector2 centroTransformacao() const
+    {
+        Vector2 c3 = transformacao.canto3();
+        return Vector2((transformacao.c0.x + c3.x) / 2, (transformacao.c0.y + c3.y) / 2);
+    }
+
+    void escalaTransformacao(float fatorX, float fatorY)
+    {
+        Vector2 centro = centroTransformacao();
+        Vector2 *cantos[3] = {&transformacao.c0, &transformacao.c1, &transformacao.c2};
+        for (int i = 0; i < 3; i++)
+            cantos[i]->set(centro.x + (cantos[i]->x - centro.x) * fatorX, centro.y + (cantos[i]->y - centro.y) * fatorY);
+        previewSujo = true;
+    }
+
+    void rotacionaTransformacao(float angulo)
+    {
+        Vector2 centro = centroTransformacao();
+        float c = cos(angulo), s = sin(angulo);
+        Vector2 *cantos[3] = {&transformacao.c0, &transformacao.c1, &transformacao.c2};
+        for (int i = 0; i < 3; i++)
+        {
+            float dx = cantos[i]->x - centro.x, dy = cantos[i]->y - centro.y;
+            cantos[i]->set(centro.x + dx * c - dy * s, centro.y + dx * s + dy * c);
+        }
+        previewSujo = true;
+    }
+
+    void moveTransformacao(float dx, float dy)
+    {
+        transformacao.c0.set(transformacao.c0.x + dx, transformacao.c0.y + dy);
+        transformacao.c1.set(transformacao.c1.x + dx, transformacao.c1.y + dy);
+        transformacao.c2.set(transformacao.c2.x + dx, transformacao.c2.y + dy);
+        previewSujo = true;
+    }
+
+    // Transformacao livre (afim): os cantos 0, 1 e 2 sao movidos diretamente; o canto 3
+    // divide o deslocamento entre os cantos 1 e 2 para continuar sendo c1 + c2 - c0.
+    void moveCantoTransformacao(int canto, float x, float y)
+    {
+        if (canto == 0) transformacao.c0.set(x, y);
+        else if (canto == 1) transformacao.c1.set(x, y);
+        else if (canto == 2) transformacao.c2.set(x, y);
+        else if (canto == 3)
+        {
+            Vector2 c3 = transformacao.canto3();
+            float dx = (x - c3.x) / 2, dy = (y - c3.y) / 2;
+            transformacao.c1.set(transformacao.c1.x + dx, transformacao.c1.y + dy);
+            transformacao.c2.set(transformacao.c2.x + dx, transformacao.c2.y + dy);
+        }
+        previewSujo = true;
+    }
+
+    // Retorna o canto (0..3) a ate "raio" pixels do mouse, ou -1.
+    int cantoProximo(int mouseX, int mouseY, int raio)
+    {
+        Vector2 cantos[4] = {transformacao.c0, transformacao.c1, transformacao.c2, transformacao.canto3()};
+        for (int i = 0; i < 4; i++)
+            if (abs(mouseX - (int)cantos[i].x) <= raio && abs(mouseY - (int)cantos[i].y) <= raio)
+                return i;
+        return -1;
+    }
+
+    // Recalcula o preview bilinear apenas quando a transformacao mudou. O resultado e
+    // recortado a area visivel, entao o custo nao depende do tamanho da imagem original.
+    void atualizaPreview(int clipX0, int clipY0, int clipX1, int clipY1)
+    {
+        if (!emTransformacao || !previewSujo)
+            return;
+
+        int bx0, by0, bx1, by1;
+        transformacao.caixaEnvolvente(bx0, by0, bx1, by1);
+        previewX0 = bx0 > clipX0 ? bx0 : clipX0;
+        previewY0 = by0 > clipY0 ? by0 : clipY0;
+        previewWidth = (bx1 < clipX1 ? bx1 : clipX1) - previewX0;
+        previewHeight = (by1 < clipY1 ? by1 : clipY1) - previewY0;
+        if (previewWidth < 0) previewWidth = 0;
+        if (previewHeight < 0) previewHeight = 0;
+
+        reamostraBilinear(origemEmpacotada, transformacao, previewX0, previewY0, previewWidth, previewHeight, preview);
+        previewSujo = false;
+        histograma.marcaTudoSujo();
+    }
+
+    void desenhaAlcasTransformacao()
+    {
+        Vector2 cantos[4] = {transformacao.c0, transformacao.c1, transformacao.canto3(), transformacao.c2};
+        CV::color(0, 0, 1);
+        for (int i = 0; i < 4; i++)
+        {
+            CV::line(cantos[i].x, cantos[i].y, cantos[(i + 1) % 4].x, cantos[(i + 1) % 4].y);
+            CV::rectFill(cantos[i].x - 4, cantos[i].y - 4, cantos[i].x + 4, cantos[i].y + 4);
+        }
+    }
+
+    // Aplica a transformacao definitiva com reamostragem bicubica sobre a imagem original.
+    void confirmaTransformacao()
+    {
+        if (!emTransformacao)
+            return;
+
+        int bx0, by0, bx1, by1;
+        transformacao.caixaEnvolvente(bx0, by0, bx1, by1);
+        int largura = bx1 - bx0, altura = by1 - by0;
+        if (largura > 0 && altura > 0)
+        {
+            unsigned char *rgb = new unsigned char[largura * altura * 3];
+            unsigned char *alfa = new unsigned char[largura * altura];
+            reamostraBicubica(origemEmpacotada, transformacao, bx0, by0, largura, altura, rgb, alfa);
+            img->substituiDados(rgb, alfa, largura, altura);
+            imgX0 = bx0;
+            imgY0 = by0;
+            imgWidth = largura;
+            imgHeight = altura;
+        }
+        cancelaTransformacao();
+    }
+
+    void cancelaTransformacao()
+    {
+        emTransformacao = false;
+        histograma.marcaTudoSujo();
+        std::vector<uint32_t>().swap(origemEmpacotada);
+        std::vector<uint32_t>().swap(preview);
+        previewWidth = previewHeight = 0;
+    }
+
     void desenhaMenuCamadas()
     {
         CV::color(0.8, 0.8, 0.8);
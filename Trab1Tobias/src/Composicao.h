@@ -0,0 +1,329 @@
+#ifndef ___COMPOSICAO__H___
+#define ___COMPOSICAO__H___
+
+// Composicao das camadas em um unico quadro RGBA 8 bits com alfa pre-multiplicado.
+// Cada linha de cada camada visivel e rasterizada (imagem + matriz de desenho),
+// escalada pela opacidade da camada e misturada no quadro com o modo de mistura
+// da camada. Os kernels de mistura trabalham com 4 pixels por iteracao em SSE2
+// (canais em 16 bits) e possuem versao escalar para o resto da linha e para
+// compiladores sem SSE2. O quadro e dividido em faixas de linhas paralelas.
+
+#include <vector>
+#include <string.h>
+#include <stdint.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "Camada.h"
+#include "Reamostragem.h"
+
+extern float Colors[15][3]; // paleta definida em gl_canvas2d.cpp
+
+enum ModoMistura
+{
+    MISTURA_NORMAL = 0,
+    MISTURA_MULTIPLICAR,
+    MISTURA_TELA,
+    MISTURA_SOBREPOR,
+    MISTURA_ADICAO,
+    MISTURA_DIFERENCA,
+    NUM_MODOS_MISTURA
+};
+
+static const char *nomesModoMistura[NUM_MODOS_MISTURA] = {"Normal", "Mult", "Tela", "Sobrep", "Adic", "Dif"};
+
+// x*y/255 arredondado, para valores de 8 bits.
+inline int mul255(int x, int y)
+{
+    int t = x * y + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+// Mistura de um pixel (versao escalar). s e d sao RGBA pre-multiplicados.
+inline uint32_t misturaPixel(uint32_t s, uint32_t d, int modo, int opacidade)
+{
+    int sc[4], dc[4], r[4];
+    for (int k = 0; k < 4; k++)
+    {
+        sc[k] = mul255((s >> (k * 8)) & 0xFF, opacidade);
+        dc[k] = (d >> (k * 8)) & 0xFF;
+    }
+    int sa = sc[3], da = dc[3];
+
+    for (int k = 0; k < 3; k++)
+    {
+        int S = sc[k], D = dc[k];
+        switch (modo)
+        {
+            case MISTURA_MULTIPLICAR: r[k] = mul255(S, 255 - da) + mul255(D, 255 - sa) + mul255(S, D); break;
+            case MISTURA_TELA:        r[k] = S + D - mul255(S, D); break;
+            case MISTURA_ADICAO:      r[k] = S + D; break;
+            case MISTURA_DIFERENCA:
+            {
+                int a = mul255(S, da), b = mul255(D, sa);
+                r[k] = S + D - 2 * (a < b ? a : b);
+                break;
+            }
+            case MISTURA_SOBREPOR:
+            {
+                int B = (2 * D <= da) ? 2 * mul255(S, D) : mul255(sa, da) - 2 * mul255(da - D, sa - S);
+                if (B < 0) B = 0;
+                r[k] = B + mul255(S, 255 - da) + mul255(D, 255 - sa);
+                break;
+            }
+            default:                  r[k] = S + mul255(D, 255 - sa); break;
+        }
+    }
+    r[3] = sa + da - mul255(sa, da);
+
+    uint32_t resultado = 0;
+    for (int k = 0; k < 4; k++)
+    {
+        int v = r[k] < 0 ? 0 : (r[k] > 255 ? 255 : r[k]);
+        resultado |= (uint32_t)v << (k * 8);
+    }
+    return resultado;
+}
+
+#if defined(__SSE2__)
+// Versao SSE2 de mul255 para 8 canais de 16 bits.
+inline __m128i mul255x8(__m128i x, __m128i y)
+{
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(x, y), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+inline __m128i replicaAlfa(__m128i x)
+{
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+// Mistura dois pixels (canais em 16 bits). O modo e parametro de template para que o
+// switch seja resolvido em tempo de compilacao dentro do laco da linha.
+template <int modo, bool comOpacidade>
+inline __m128i misturaDoisPixels(__m128i S, __m128i D, __m128i op)
+{
+    const __m128i max = _mm_set1_epi16(255);
+    const __m128i mascaraAlfa = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+
+    if (comOpacidade)
+        S = mul255x8(S, op);
+    __m128i sa = replicaAlfa(S), da = replicaAlfa(D);
+    __m128i r;
+    switch (modo)
+    {
+        case MISTURA_MULTIPLICAR:
+            r = _mm_add_epi16(_mm_add_epi16(mul255x8(S, _mm_sub_epi16(max, da)), mul255x8(D, _mm_sub_epi16(max, sa))), mul255x8(S, D));
+            break;
+        case MISTURA_TELA:
+            r = _mm_sub_epi16(_mm_add_epi16(S, D), mul255x8(S, D));
+            break;
+        case MISTURA_ADICAO:
+            r = _mm_add_epi16(S, D);
+            break;
+        case MISTURA_DIFERENCA:
+        {
+            __m128i m = _mm_min_epi16(mul255x8(S, da), mul255x8(D, sa));
+            r = _mm_sub_epi16(_mm_add_epi16(S, D), _mm_add_epi16(m, m));
+            break;
+        }
+        case MISTURA_SOBREPOR:
+        {
+            __m128i escuro = mul255x8(S, D);
+            escuro = _mm_add_epi16(escuro, escuro);
+            __m128i claro = mul255x8(_mm_sub_epi16(da, D), _mm_sub_epi16(sa, S));
+            claro = _mm_max_epi16(_mm_sub_epi16(mul255x8(sa, da), _mm_add_epi16(claro, claro)), _mm_setzero_si128());
+            __m128i usaClaro = _mm_cmpgt_epi16(_mm_add_epi16(D, D), da);
+            __m128i B = _mm_or_si128(_mm_and_si128(usaClaro, claro), _mm_andnot_si128(usaClaro, escuro));
+            r = _mm_add_epi16(_mm_add_epi16(B, mul255x8(S, _mm_sub_epi16(max, da))), mul255x8(D, _mm_sub_epi16(max, sa)));
+            break;
+        }
+        default:
+            r = _mm_add_epi16(S, mul255x8(D, _mm_sub_epi16(max, sa)));
+            break;
+    }
+    // alfa resultante e sempre sa + da - sa*da, independente do modo
+    __m128i alfa = _mm_sub_epi16(_mm_add_epi16(sa, da), mul255x8(sa, da));
+    return _mm_or_si128(_mm_andnot_si128(mascaraAlfa, r), _mm_and_si128(mascaraAlfa, alfa));
+}
+#endif
+
+template <int modo, bool comOpacidade>
+inline void misturaLinhaModo(uint32_t *destino, const uint32_t *fonte, int n, int opacidade)
+{
+    int x = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i op = _mm_set1_epi16((short)opacidade);
+    const __m128i alfaCheio = _mm_set1_epi32((int)0xFF000000);
+    for (; x + 4 <= n; x += 4)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i *)(fonte + x));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(s, zero)) == 0xFFFF)
+            continue; // 4 pixels transparentes nao alteram o destino
+        if (modo == MISTURA_NORMAL && !comOpacidade &&
+            _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(s, alfaCheio), alfaCheio)) == 0xFFFF)
+        {
+            _mm_storeu_si128((__m128i *)(destino + x), s); // 4 pixels opacos cobrem o destino
+            continue;
+        }
+        __m128i d = _mm_loadu_si128((const __m128i *)(destino + x));
+        __m128i lo = misturaDoisPixels<modo, comOpacidade>(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), op);
+        __m128i hi = misturaDoisPixels<modo, comOpacidade>(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), op);
+        _mm_storeu_si128((__m128i *)(destino + x), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for (; x < n; x++)
+        if (fonte[x] != 0)
+            destino[x] = misturaPixel(fonte[x], destino[x], modo, opacidade);
+}
+
+template <int modo>
+inline void misturaLinhaModo(uint32_t *destino, const uint32_t *fonte, int n, int opacidade)
+{
+    if (opacidade == 255)
+        misturaLinhaModo<modo, false>(destino, fonte, n, opacidade);
+    else
+        misturaLinhaModo<modo, true>(destino, fonte, n, opacidade);
+}
+
+// Mistura uma linha da fonte sobre o destino (ambos RGBA pre-multiplicados).
+inline void misturaLinha(uint32_t *destino, const uint32_t *fonte, int n, int modo, int opacidade)
+{
+    switch (modo)
+    {
+        case MISTURA_MULTIPLICAR: misturaLinhaModo<MISTURA_MULTIPLICAR>(destino, fonte, n, opacidade); break;
+        case MISTURA_TELA:        misturaLinhaModo<MISTURA_TELA>(destino, fonte, n, opacidade); break;
+        case MISTURA_SOBREPOR:    misturaLinhaModo<MISTURA_SOBREPOR>(destino, fonte, n, opacidade); break;
+        case MISTURA_ADICAO:      misturaLinhaModo<MISTURA_ADICAO>(destino, fonte, n, opacidade); break;
+        case MISTURA_DIFERENCA:   misturaLinhaModo<MISTURA_DIFERENCA>(destino, fonte, n, opacidade); break;
+        default:                  misturaLinhaModo<MISTURA_NORMAL>(destino, fonte, n, opacidade); break;
+    }
+}
+
+// Converte RGB + alfa opcional para RGBA pre-multiplicado.
+inline uint32_t preMultiplica(unsigned int r, unsigned int g, unsigned int b, unsigned int a)
+{
+    if (a == 0)
+        return 0;
+    if (a < 255)
+    {
+        r = mul255(r, a);
+        g = mul255(g, a);
+        b = mul255(b, a);
+    }
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+class Compositor
+{
+    int largura, altura;
+    int deslocX; // x de tela da coluna 0 da matriz (largura do menu)
+    std::vector<uint32_t> quadro;
+    uint32_t paleta[15];
+
+public:
+    Compositor(int _largura, int _altura, int _deslocX)
+    {
+        largura = _largura;
+        altura = _altura;
+        deslocX = _deslocX;
+        quadro.resize(largura * altura);
+        for (int i = 0; i < 15; i++)
+            paleta[i] = preMultiplica((unsigned int)(Colors[i][0] * 255), (unsigned int)(Colors[i][1] * 255), (unsigned int)(Colors[i][2] * 255), 255);
+    }
+
+    // Rasteriza as colunas [xIni, xFim) da linha y de uma camada (imagem ou preview da
+    // transformacao + desenho) em RGBA pre-multiplicado. saida[0] corresponde a xIni.
+    void rasterizaTrecho(Camada *camada, int y, int xIni, int xFim, uint32_t *saida)
+    {
+        int n = xFim - xIni;
+        memset(saida, 0, n * sizeof(uint32_t));
+
+        if (camada->getEmTransformacao())
+        {
+            int py = y - camada->getPreviewY0();
+            if (py >= 0 && py < camada->getPreviewHeight())
+            {
+                const uint32_t *src = camada->getPreview() + py * camada->getPreviewWidth();
+                int origem = camada->getPreviewX0() - deslocX; // coluna da matriz do pixel 0 do preview
+                int x0 = xIni > origem ? xIni : origem;
+                int x1 = xFim < origem + camada->getPreviewWidth() ? xFim : origem + camada->getPreviewWidth();
+                for (int j = x0; j < x1; j++)
+                {
+                    uint32_t p = src[j - origem];
+                    if (p != 0)
+                        saida[j - xIni] = preMultiplica(p & 0xFF, (p >> 8) & 0xFF, (p >> 16) & 0xFF, p >> 24);
+                }
+            }
+        }
+        else if (camada->getHasImage())
+        {
+            Bmp *img = camada->getImage();
+            int iy = y - camada->getImgY0();
+            if (iy >= 0 && iy < img->getHeight())
+            {
+                int w = img->getWidth();
+                const unsigned char *rgb = img->getImage() + iy * w * 3;
+                const unsigned char *alfa = img->getAlfa() ? img->getAlfa() + iy * w : NULL;
+                int origem = camada->getImgX0() - deslocX;
+                int x0 = xIni > origem ? xIni : origem;
+                int x1 = xFim < origem + w ? xFim : origem + w;
+                for (int j = x0; j < x1; j++)
+                {
+                    int x = j - origem;
+                    saida[j - xIni] = preMultiplica(rgb[x * 3], rgb[x * 3 + 1], rgb[x * 3 + 2], alfa ? alfa[x] : 255);
+                }
+            }
+        }
+
+        const int *m = camada->getMatrizDesenho()[y];
+        for (int j = xIni; j < xFim; j++)
+            if (m[j] != -1)
+                saida[j - xIni] = paleta[m[j]];
+    }
+
+    // Compoe as camadas da ultima (fundo) para a primeira (topo) sobre um fundo branco.
+    // A grade e misturada logo abaixo da camada ativa, como no desenho original.
+    void compoe(Camada **camadas, int numeroCamadas, int **grade)
+    {
+        uint32_t *dst = &quadro[0];
+        int w = largura;
+
+        executaEmFaixas(altura, [=](int yIni, int yFim)
+        {
+            std::vector<uint32_t> linhaCamada(w);
+            std::vector<uint32_t> linhaGrade(w);
+            for (int y = yIni; y < yFim; y++)
+            {
+                uint32_t *linhaQuadro = dst + y * w;
+                for (int x = 0; x < w; x++)
+                    linhaQuadro[x] = 0xFFFFFFFF;
+
+                for (int i = numeroCamadas - 1; i >= 0; i--)
+                {
+                    if (camadas[i]->getAtiva() == 1)
+                    {
+                        for (int x = 0; x < w; x++)
+                            linhaGrade[x] = grade[y][x] != -1 ? paleta[grade[y][x]] : 0;
+                        misturaLinha(linhaQuadro, &linhaGrade[0], w, MISTURA_NORMAL, 255);
+                    }
+                    if (camadas[i]->getVisivel() == 1 && camadas[i]->getOpacidade() > 0)
+                    {
+                        rasterizaTrecho(camadas[i], y, 0, w, &linhaCamada[0]);
+                        misturaLinha(linhaQuadro, &linhaCamada[0], w, camadas[i]->getModoMistura(), camadas[i]->getOpacidade());
+                    }
+                }
+            }
+        });
+    }
+
+    void desenha()
+    {
+        CV::image(deslocX, 0, largura, altura, (const unsigned char *)&quadro[0]);
+    }
+};
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef ___HISTOGRAMA__H___
+#define ___HISTOGRAMA__H___
+
+// Histograma incremental de uma camada. A area de desenho e dividida em blocos de
+// 64x64 pixels e cada bloco guarda seu proprio histograma (R, G, B e luminancia).
+// Pincel, movimento, brilho e flips apenas marcam os blocos afetados como sujos;
+// na atualizacao somente os blocos sujos sao recalculados (em paralelo) e os
+// histogramas dos blocos sao somados em paralelo, dividindo as faixas de bins.
+
+#include <vector>
+#include <string.h>
+#include <stdint.h>
+
+#include "Reamostragem.h"
+
+#define TAM_BLOCO_HISTOGRAMA 64
+#define BINS_HISTOGRAMA (4 * 256) // R, G, B e luminancia
+
+class HistogramaCamada
+{
+    int largura, altura;  // tamanho da area de desenho
+    int deslocX;          // x de tela da coluna 0 (largura do menu)
+    int blocosX, blocosY;
+    std::vector<uint32_t> blocos;       // BINS_HISTOGRAMA por bloco
+    std::vector<unsigned char> sujo;
+    bool algumSujo;
+    uint32_t total[BINS_HISTOGRAMA];
+
+public:
+    HistogramaCamada()
+    {
+        largura = altura = deslocX = blocosX = blocosY = 0;
+        algumSujo = false;
+        memset(total, 0, sizeof(total));
+    }
+
+    void inicializa(int _largura, int _altura, int _deslocX)
+    {
+        largura = _largura;
+        altura = _altura;
+        deslocX = _deslocX;
+        blocosX = (largura + TAM_BLOCO_HISTOGRAMA - 1) / TAM_BLOCO_HISTOGRAMA;
+        blocosY = (altura + TAM_BLOCO_HISTOGRAMA - 1) / TAM_BLOCO_HISTOGRAMA;
+        blocos.assign(blocosX * blocosY * BINS_HISTOGRAMA, 0);
+        sujo.assign(blocosX * blocosY, 1);
+        algumSujo = true;
+    }
+
+    // Marca como sujos os blocos que cobrem o retangulo [x0,x1] x [y0,y1] da matriz.
+    void marcaSujo(int x0, int y0, int x1, int y1)
+    {
+        if (blocosX == 0)
+            return;
+        int bx0 = x0 / TAM_BLOCO_HISTOGRAMA, bx1 = x1 / TAM_BLOCO_HISTOGRAMA;
+        int by0 = y0 / TAM_BLOCO_HISTOGRAMA, by1 = y1 / TAM_BLOCO_HISTOGRAMA;
+        if (bx0 < 0) bx0 = 0;
+        if (by0 < 0) by0 = 0;
+        if (bx1 >= blocosX) bx1 = blocosX - 1;
+        if (by1 >= blocosY) by1 = blocosY - 1;
+        for (int by = by0; by <= by1; by++)
+            for (int bx = bx0; bx <= bx1; bx++)
+            {
+                sujo[by * blocosX + bx] = 1;
+                algumSujo = true;
+            }
+    }
+
+    // Mesmo que marcaSujo, mas com x em coordenadas de tela (como imgX0).
+    void marcaSujoTela(int x0, int y0, int x1, int y1)
+    {
+        marcaSujo(x0 - deslocX, y0, x1 - deslocX, y1);
+    }
+
+    void marcaTudoSujo()
+    {
+        marcaSujo(0, 0, largura - 1, altura - 1);
+    }
+
+    // Recalcula os blocos sujos. rasteriza(y, x0, x1, saida) deve escrever os pixels
+    // RGBA pre-multiplicados da camada na linha y, colunas [x0, x1).
+    template <typename Rasterizador>
+    void atualiza(Rasterizador rasteriza)
+    {
+        if (!algumSujo)
+            return;
+
+        std::vector<int> pendentes;
+        for (int i = 0; i < blocosX * blocosY; i++)
+            if (sujo[i])
+                pendentes.push_back(i);
+
+        uint32_t *dadosBlocos = &blocos[0];
+        const int *lista = &pendentes[0];
+        int bX = blocosX, larg = largura, alt = altura;
+
+        // cada thread recalcula um subconjunto dos blocos sujos
+        executaEmFaixas((int)pendentes.size(), [=](int ini, int fim)
+        {
+            uint32_t linha[TAM_BLOCO_HISTOGRAMA];
+            for (int k = ini; k < fim; k++)
+            {
+                int bloco = lista[k];
+                int x0 = (bloco % bX) * TAM_BLOCO_HISTOGRAMA, y0 = (bloco / bX) * TAM_BLOCO_HISTOGRAMA;
+                int x1 = x0 + TAM_BLOCO_HISTOGRAMA < larg ? x0 + TAM_BLOCO_HISTOGRAMA : larg;
+                int y1 = y0 + TAM_BLOCO_HISTOGRAMA < alt ? y0 + TAM_BLOCO_HISTOGRAMA : alt;
+                uint32_t *bins = dadosBlocos + bloco * BINS_HISTOGRAMA;
+                memset(bins, 0, BINS_HISTOGRAMA * sizeof(uint32_t));
+
+                for (int y = y0; y < y1; y++)
+                {
+                    rasteriza(y, x0, x1, linha);
+                    for (int x = 0; x < x1 - x0; x++)
+                    {
+                        uint32_t p = linha[x];
+                        unsigned int a = p >> 24;
+                        if (a == 0)
+                            continue;
+                        unsigned int r = p & 0xFF, g = (p >> 8) & 0xFF, b = (p >> 16) & 0xFF;
+                        if (a < 255)
+                        {
+                            r = r * 255 / a;
+                            g = g * 255 / a;
+                            b = b * 255 / a;
+                        }
+                        bins[r]++;
+                        bins[256 + g]++;
+                        bins[512 + b]++;
+                        bins[768 + ((77 * r + 150 * g + 29 * b) >> 8)]++;
+                    }
+                }
+            }
+        }, 1);
+
+        // soma dos blocos: cada thread cuida de uma faixa de bins
+        uint32_t *soma = total;
+        int nBlocos = blocosX * blocosY;
+        executaEmFaixas(BINS_HISTOGRAMA, [=](int ini, int fim)
+        {
+            for (int bin = ini; bin < fim; bin++)
+            {
+                uint32_t acc = 0;
+                for (int k = 0; k < nBlocos; k++)
+                    acc += dadosBlocos[k * BINS_HISTOGRAMA + bin];
+                soma[bin] = acc;
+            }
+        });
+
+        memset(&sujo[0], 0, sujo.size());
+        algumSujo = false;
+    }
+
+    // canal: 0 = R, 1 = G, 2 = B, 3 = luminancia
+    const uint32_t *getCanal(int canal) const { return total + canal * 256; }
+
+    // Monta a tabela de niveis automaticos: para cada canal, os extremos que cortam
+    // "corte" (fracao) dos pixels em cada ponta sao esticados para 0 e 255.
+    // Retorna false se a camada nao tem pixels.
+    bool montaTabelaNiveis(unsigned char tabela[3][256], float corte = 0.005f) const
+    {
+        uint32_t quantidade = 0;
+        for (int v = 0; v < 256; v++)
+            quantidade += total[768 + v];
+        if (quantidade == 0)
+            return false;
+
+        uint32_t limite = (uint32_t)(quantidade * corte);
+        for (int c = 0; c < 3; c++)
+        {
+            const uint32_t *h = total + c * 256;
+            int baixo = 0, alto = 255;
+            uint32_t acc = 0;
+            while (baixo < 255 && (acc += h[baixo]) <= limite) baixo++;
+            acc = 0;
+            while (alto > 0 && (acc += h[alto]) <= limite) alto--;
+
+            for (int v = 0; v < 256; v++)
+            {
+                if (alto <= baixo)
+                {
+                    tabela[c][v] = v;
+                    continue;
+                }
+                int novo = (v - baixo) * 255 / (alto - baixo);
+                tabela[c][v] = novo < 0 ? 0 : (novo > 255 ? 255 : novo);
+            }
+        }
+        return true;
+    }
+};
+
+#endif
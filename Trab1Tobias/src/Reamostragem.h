@@ -0,0 +1,386 @@
+#ifndef ___REAMOSTRAGEM__H___
+#define ___REAMOSTRAGEM__H___
+
+// Funcoes de reamostragem usadas pela ferramenta de transformacao das camadas
+// (escala, rotacao e transformacao livre). A imagem de origem fica empacotada em
+// RGBA 32 bits com uma borda replicada de 1 pixel, o que permite ler a vizinhanca
+// 2x2 do bilinear sem testar limites. O preview usa bilinear em ponto fixo 16.16
+// (com kernel SSE2 quando disponivel) e a confirmacao usa bicubico (Keys, a = -0.5).
+// Os dois passos sao divididos em faixas de linhas processadas em paralelo, por threads
+// criadas uma vez e reaproveitadas (PoolDeFaixas).
+
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+#include <stdint.h>
+
+#include <algorithm>
+#include <functional>
+
+#if defined(_GLIBCXX_HAS_GTHREADS)
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "Vector2.h"
+
+// Transformacao afim definida pelos cantos de destino da imagem:
+// c0 = destino de (0,0), c1 = destino de (largura,0), c2 = destino de (0,altura).
+// O quarto canto e sempre c1 + c2 - c0 (paralelogramo).
+struct TransformacaoAfim
+{
+    Vector2 c0, c1, c2;
+    int largura, altura;
+
+    Vector2 canto3() const
+    {
+        return Vector2(c1.x + c2.x - c0.x, c1.y + c2.y - c0.y);
+    }
+
+    // Calcula a inversa (tela -> imagem): u = a*x + b*y + c, v = d*x + e*y + f.
+    // Retorna false se os cantos estiverem degenerados (area nula).
+    bool inversa(float &a, float &b, float &c, float &d, float &e, float &f) const
+    {
+        float ex = (c1.x - c0.x) / largura, ey = (c1.y - c0.y) / largura;
+        float fx = (c2.x - c0.x) / altura,  fy = (c2.y - c0.y) / altura;
+        float det = ex * fy - fx * ey;
+        if (fabs(det) < 1e-6f)
+            return false;
+
+        a =  fy / det;
+        b = -fx / det;
+        d = -ey / det;
+        e =  ex / det;
+        c = -(a * c0.x + b * c0.y);
+        f = -(d * c0.x + e * c0.y);
+        return true;
+    }
+
+    void caixaEnvolvente(int &x0, int &y0, int &x1, int &y1) const
+    {
+        Vector2 c3 = canto3();
+        float minX = fmin(fmin(c0.x, c1.x), fmin(c2.x, c3.x));
+        float maxX = fmax(fmax(c0.x, c1.x), fmax(c2.x, c3.x));
+        float minY = fmin(fmin(c0.y, c1.y), fmin(c2.y, c3.y));
+        float maxY = fmax(fmax(c0.y, c1.y), fmax(c2.y, c3.y));
+        x0 = (int)floor(minX);
+        y0 = (int)floor(minY);
+        x1 = (int)ceil(maxX);
+        y1 = (int)ceil(maxY);
+    }
+};
+
+#if defined(_GLIBCXX_HAS_GTHREADS)
+// Threads de trabalho criadas uma unica vez e reaproveitadas a cada chamada de
+// executaEmFaixas (a composicao e a reamostragem rodam a cada quadro; criar threads
+// em toda chamada custaria mais que o trabalho das faixas pequenas).
+// As faixas sao distribuidas sob o mutex, uma por vez; a thread que chama tambem
+// executa faixas e so retorna quando todas terminaram. Usado apenas pela thread principal
+// e sem chamadas aninhadas (uma faixa nao pode chamar executaEmFaixas).
+class PoolDeFaixas
+{
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable acorda, terminou;
+    const std::function<void(int, int)> *tarefa;
+    int altura, passo, faixas;
+    int proxima;    // proxima faixa a distribuir
+    int pendentes;  // faixas ainda nao concluidas
+    unsigned lote;  // muda a cada chamada, para acordar as threads
+    bool parando;
+
+    // Executa faixas do lote atual ate nao sobrar nenhuma para distribuir.
+    void executaFaixas()
+    {
+        for (;;)
+        {
+            const std::function<void(int, int)> *f;
+            int ini, fim;
+            {
+                std::lock_guard<std::mutex> trava(mutex);
+                if (proxima >= faixas)
+                    return;
+                ini = proxima++ * passo;
+                fim = ini + passo < altura ? ini + passo : altura;
+                f = tarefa;
+            }
+            (*f)(ini, fim);
+            std::lock_guard<std::mutex> trava(mutex);
+            if (--pendentes == 0)
+                terminou.notify_all();
+        }
+    }
+
+    void laco()
+    {
+        unsigned visto = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> trava(mutex);
+                acorda.wait(trava, [&] { return parando || lote != visto; });
+                if (parando)
+                    return;
+                visto = lote;
+            }
+            executaFaixas();
+        }
+    }
+
+public:
+    explicit PoolDeFaixas(int quantidade)
+        : tarefa(NULL), altura(0), passo(1), faixas(0), proxima(0), pendentes(0), lote(0), parando(false)
+    {
+        for (int i = 0; i < quantidade; i++)
+            threads.push_back(std::thread(&PoolDeFaixas::laco, this));
+    }
+
+    ~PoolDeFaixas()
+    {
+        {
+            std::lock_guard<std::mutex> trava(mutex);
+            parando = true;
+        }
+        acorda.notify_all();
+        for (size_t i = 0; i < threads.size(); i++)
+            threads[i].join();
+    }
+
+    // Pool compartilhado: uma thread por nucleo, alem da que chama.
+    static PoolDeFaixas &compartilhado()
+    {
+        static PoolDeFaixas pool(std::max(0, (int)std::thread::hardware_concurrency() - 1));
+        return pool;
+    }
+
+    int numeroDeThreads() const { return (int)threads.size(); }
+
+    // Executa funcao sobre [0, alturaTotal) dividido em quantidadeFaixas faixas.
+    void executa(int alturaTotal, int quantidadeFaixas, const std::function<void(int, int)> &funcao)
+    {
+        {
+            std::lock_guard<std::mutex> trava(mutex);
+            tarefa = &funcao;
+            altura = alturaTotal;
+            faixas = quantidadeFaixas;
+            passo = (alturaTotal + quantidadeFaixas - 1) / quantidadeFaixas;
+            proxima = 0;
+            pendentes = quantidadeFaixas;
+            lote++;
+        }
+        acorda.notify_all();
+        executaFaixas();
+        std::unique_lock<std::mutex> trava(mutex);
+        terminou.wait(trava, [&] { return pendentes == 0; });
+    }
+};
+#endif
+
+// Executa funcao(yInicio, yFim) sobre faixas de linhas [0, altura), nas threads do
+// PoolDeFaixas e na que chama. Faixas com menos de minimoPorFaixa linhas nao compensam
+// o custo de distribuir a tarefa.
+template <typename Funcao>
+void executaEmFaixas(int altura, Funcao funcao, int minimoPorFaixa = 64)
+{
+    int faixas = 1;
+#if defined(_GLIBCXX_HAS_GTHREADS)
+    int nucleos = PoolDeFaixas::compartilhado().numeroDeThreads() + 1;
+    faixas = altura / minimoPorFaixa;
+    if (faixas > nucleos) faixas = nucleos;
+    if (faixas < 1) faixas = 1;
+#endif
+    if (faixas == 1)
+    {
+        funcao(0, altura);
+        return;
+    }
+#if defined(_GLIBCXX_HAS_GTHREADS)
+    std::function<void(int, int)> tarefa(funcao);
+    PoolDeFaixas::compartilhado().executa(altura, faixas, tarefa);
+#endif
+}
+
+// Empacota uma imagem RGB 24 bits em RGBA 32 bits com borda replicada de 1 pixel.
+// O buffer resultante tem (largura+2) x (altura+2) pixels.
+inline void empacotaComBorda(const unsigned char *rgb, const unsigned char *alfa, int largura, int altura, std::vector<uint32_t> &saida)
+{
+    int stride = largura + 2;
+    saida.resize(stride * (altura + 2));
+    for (int y = -1; y <= altura; y++)
+    {
+        int ys = y < 0 ? 0 : (y >= altura ? altura - 1 : y);
+        uint32_t *linha = &saida[(y + 1) * stride];
+        for (int x = -1; x <= largura; x++)
+        {
+            int xs = x < 0 ? 0 : (x >= largura ? largura - 1 : x);
+            const unsigned char *p = rgb + (ys * largura + xs) * 3;
+            uint32_t a = alfa ? alfa[ys * largura + xs] : 255;
+            linha[x + 1] = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | (a << 24);
+        }
+    }
+}
+
+// Interpola um pixel em ponto fixo. s e t ja incluem o deslocamento da borda (+1 pixel).
+inline uint32_t amostraBilinear(const uint32_t *origem, int stride, int32_t s, int32_t t)
+{
+    const uint32_t *l0 = origem + (t >> 16) * stride + (s >> 16);
+    const uint32_t *l1 = l0 + stride;
+    int fx = (s >> 8) & 0xFF;
+    int fy = (t >> 8) & 0xFF;
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i pesoX = _mm_set_epi16(fx, fx, fx, fx, 256 - fx, 256 - fx, 256 - fx, 256 - fx);
+
+    // cada registrador guarda dois pixels vizinhos com os canais em 16 bits
+    __m128i cima  = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)l0), zero);
+    __m128i baixo = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)l1), zero);
+
+    cima  = _mm_mullo_epi16(cima, pesoX);
+    baixo = _mm_mullo_epi16(baixo, pesoX);
+    cima  = _mm_srli_epi16(_mm_add_epi16(cima,  _mm_srli_si128(cima,  8)), 8);
+    baixo = _mm_srli_epi16(_mm_add_epi16(baixo, _mm_srli_si128(baixo, 8)), 8);
+
+    __m128i r = _mm_add_epi16(_mm_mullo_epi16(cima,  _mm_set1_epi16(256 - fy)),
+                              _mm_mullo_epi16(baixo, _mm_set1_epi16(fy)));
+    r = _mm_srli_epi16(r, 8);
+    return (uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(r, zero));
+#else
+    uint32_t resultado = 0;
+    for (int canal = 0; canal < 32; canal += 8)
+    {
+        uint32_t p00 = (l0[0] >> canal) & 0xFF, p01 = (l0[1] >> canal) & 0xFF;
+        uint32_t p10 = (l1[0] >> canal) & 0xFF, p11 = (l1[1] >> canal) & 0xFF;
+        uint32_t cima  = (p00 * (256 - fx) + p01 * fx) >> 8;
+        uint32_t baixo = (p10 * (256 - fx) + p11 * fx) >> 8;
+        resultado |= ((cima * (256 - fy) + baixo * fy) >> 8) << canal;
+    }
+    return resultado;
+#endif
+}
+
+// Preview: reamostra a origem (ja empacotada com borda) para o retangulo de destino
+// [dx0, dx0+largDest) x [dy0, dy0+altDest) em coordenadas de tela. Pixels fora da
+// imagem ficam transparentes (RGBA = 0).
+inline void reamostraBilinear(const std::vector<uint32_t> &origem, const TransformacaoAfim &t,
+                              int dx0, int dy0, int largDest, int altDest, std::vector<uint32_t> &destino)
+{
+    destino.assign(largDest * altDest, 0);
+    float a, b, c, d, e, f;
+    if (largDest <= 0 || altDest <= 0 || !t.inversa(a, b, c, d, e, f))
+        return;
+
+    const uint32_t *src = &origem[0];
+    uint32_t *dst = &destino[0];
+    int stride = t.largura + 2;
+    // limites validos de s e t (coordenada da imagem + 0.5 de borda) em ponto fixo
+    int32_t sMax = (int32_t)(t.largura << 16) + 32768;
+    int32_t tMax = (int32_t)(t.altura << 16) + 32768;
+    int largura = largDest;
+
+    executaEmFaixas(altDest, [=](int yIni, int yFim)
+    {
+        int32_t ds = (int32_t)(a * 65536.0f);
+        int32_t dt = (int32_t)(d * 65536.0f);
+        for (int y = yIni; y < yFim; y++)
+        {
+            // centro do primeiro pixel da linha; +0.5 desloca para a convencao com borda
+            float px = dx0 + 0.5f, py = dy0 + y + 0.5f;
+            int32_t s  = (int32_t)((a * px + b * py + c + 0.5f) * 65536.0f);
+            int32_t tt = (int32_t)((d * px + e * py + f + 0.5f) * 65536.0f);
+            uint32_t *linha = dst + y * largura;
+            for (int x = 0; x < largura; x++, s += ds, tt += dt)
+            {
+                if (s >= 32768 && s < sMax && tt >= 32768 && tt < tMax)
+                    linha[x] = amostraBilinear(src, stride, s, tt);
+            }
+        }
+    });
+}
+
+// Peso do kernel cubico de Keys com a = -0.5 (Catmull-Rom).
+inline float pesoCubico(float x)
+{
+    x = fabs(x);
+    if (x < 1.0f)
+        return (1.5f * x - 2.5f) * x * x + 1.0f;
+    if (x < 2.0f)
+        return ((-0.5f * x + 2.5f) * x - 4.0f) * x + 2.0f;
+    return 0.0f;
+}
+
+// Confirmacao: reamostragem bicubica de alta qualidade para RGB 24 bits + mascara alfa.
+inline void reamostraBicubica(const std::vector<uint32_t> &origem, const TransformacaoAfim &t,
+                              int dx0, int dy0, int largDest, int altDest,
+                              unsigned char *rgbDestino, unsigned char *alfaDestino)
+{
+    float a, b, c, d, e, f;
+    if (!t.inversa(a, b, c, d, e, f))
+        return;
+
+    const uint32_t *src = &origem[0];
+    int stride = t.largura + 2;
+    int largOrig = t.largura, altOrig = t.altura;
+
+    executaEmFaixas(altDest, [=](int yIni, int yFim)
+    {
+        for (int y = yIni; y < yFim; y++)
+        for (int x = 0; x < largDest; x++)
+        {
+            float px = dx0 + x + 0.5f, py = dy0 + y + 0.5f;
+            float u = a * px + b * py + c;
+            float v = d * px + e * py + f;
+            int idx = y * largDest + x;
+
+            if (u < 0 || v < 0 || u >= largOrig || v >= altOrig)
+            {
+                rgbDestino[idx * 3] = rgbDestino[idx * 3 + 1] = rgbDestino[idx * 3 + 2] = 0;
+                alfaDestino[idx] = 0;
+                continue;
+            }
+
+            // coordenadas no buffer com borda (centro do pixel em +0.5)
+            float su = u + 0.5f, sv = v + 0.5f;
+            int ix = (int)floor(su), iy = (int)floor(sv);
+            float fx = su - ix, fy = sv - iy;
+            float wx[4], wy[4];
+            for (int k = 0; k < 4; k++)
+            {
+                wx[k] = pesoCubico(fx - (k - 1));
+                wy[k] = pesoCubico(fy - (k - 1));
+            }
+
+            float soma[4] = {0, 0, 0, 0};
+            for (int j = 0; j < 4; j++)
+            {
+                int yy = iy + j - 1;
+                yy = yy < 0 ? 0 : (yy > altOrig + 1 ? altOrig + 1 : yy);
+                const uint32_t *linha = src + yy * stride;
+                for (int i = 0; i < 4; i++)
+                {
+                    int xx = ix + i - 1;
+                    xx = xx < 0 ? 0 : (xx > largOrig + 1 ? largOrig + 1 : xx);
+                    uint32_t p = linha[xx];
+                    float w = wx[i] * wy[j];
+                    soma[0] += w * (p & 0xFF);
+                    soma[1] += w * ((p >> 8) & 0xFF);
+                    soma[2] += w * ((p >> 16) & 0xFF);
+                    soma[3] += w * (p >> 24);
+                }
+            }
+            for (int k = 0; k < 3; k++)
+            {
+                float val = soma[k] < 0 ? 0 : (soma[k] > 255 ? 255 : soma[k]);
+                rgbDestino[idx * 3 + k] = (unsigned char)(val + 0.5f);
+            }
+            alfaDestino[idx] = soma[3] < 128 ? 0 : 255;
+        }
+    });
+}
+
+#endif
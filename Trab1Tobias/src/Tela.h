@@ -4,6 +4,7 @@
 #include <Windows.h>
 
 #include "Camada.h"
+#include "Composicao.h"
 #include "gl_canvas2d.h"
 
 #define M_PI 3.14159265358979323846
@@ -67,6 +68,7 @@ class Tela
     int idMaximo=0;
     int numeroCamadas=3;
     int **grade;
+    Compositor *compositor;
 
     // Falta implementar a dinamicidade do eixo x e y na inicialização das camadas
     int camadaZeroX0 = 40;
@@ -78,6 +80,15 @@ class Tela
     int offsetMouseX, offsetMouseY;
     int brilhoImagem;
 
+    // --- Painel de histograma ---
+    bool mostraHistograma = true;
+    const int histogramaLargura = 256;
+    const int histogramaAltura = 100;
+
+    // --- Ferramenta de transformacao ---
+    int cantoArrastado = -1;
+    int ultimoMouseX = 0, ultimoMouseY = 0;
+
 
 public:
     Tela(int larguraDesenho, int alturaDesenho, int larguraMenu = 200)
@@ -116,10 +127,11 @@ public:
         camadas[2]=camada3;
         camadas[0]->setAtiva(1);
         inicializaGrade(&grade, matrizWidth, matrizHeight);
+        compositor = new Compositor(matrizWidth, matrizHeight, menuWidth);
 
         for (int i = 0; i < numeroCamadas; i++)
         {
-            camadas[i]->inicializaMatriz(matrizWidth, matrizHeight);
+            camadas[i]->inicializaMatriz(matrizWidth, matrizHeight, menuWidth);
             idMaximo++;
         }
 
@@ -142,7 +154,7 @@ public:
             exit(1);
         }
         camadas[numeroCamadas - 1] = new Camada(X0, Y0, X1, Y1, idMaximo);
-        camadas[numeroCamadas - 1]->inicializaMatriz(matrizWidth, matrizHeight);
+        camadas[numeroCamadas - 1]->inicializaMatriz(matrizWidth, matrizHeight, menuWidth);
 
         idMaximo++;
     }
@@ -464,6 +476,8 @@ public:
         acaoInserirImagem(mouseX, mouseY, click);
         acaoPreferenciaCamada(mouseX, mouseY, click);
         acaoScrollCamada(mouseX, mouseY, click);
+        acaoMisturaCamada(mouseX, mouseY, isPressed, click);
+        acaoHistograma(mouseX, mouseY, click);
         if(isPressed == 1)
         {
             int novaCamadaAtiva = qualCamadaFoiClicada(mouseX, mouseY);
@@ -507,7 +521,7 @@ public:
             }
 
             // Flip H
-            if (click == 1 && mouseX >= iconX + 42 && mouseX <= iconX + 74 &&
+            if (click == 1 && !camadas[idCamadaAtiva]->getEmTransformacao() && mouseX >= iconX + 42 && mouseX <= iconX + 74 &&
                 mouseY >= btnY && mouseY <= btnY + 32)
             {
                 flipHorizontal();
@@ -524,7 +538,7 @@ public:
             }
 
             // Flip V
-            if (click == 1 && mouseX >= iconX + 42 && mouseX <= iconX + 74 &&
+            if (click == 1 && !camadas[idCamadaAtiva]->getEmTransformacao() && mouseX >= iconX + 42 && mouseX <= iconX + 74 &&
                 mouseY >= btnY && mouseY <= btnY + 32)
             {
                 flipVertical();
@@ -576,7 +590,11 @@ public:
         int xRel = mouseX - menuWidth;
         int yRel = mouseY;
 
-        if (mouseX >= menuWidth && mouseX < screenWidth && mouseY >= 0 && mouseY < screenHeight)
+        if (camadas[idCamadaAtiva]->getEmTransformacao())
+        {
+            acaoTransformacao(mouseX, mouseY, isPressed);
+        }
+        else if (mouseX >= menuWidth && mouseX < screenWidth && mouseY >= 0 && mouseY < screenHeight)
         {
             if (isPressed == 1)
             {
@@ -584,6 +602,8 @@ public:
                     desenhaNaMatriz(camadas[idCamadaAtiva]->getMatrizDesenho(), yRel, xRel, tamanhoPincel, corSelecionada, tipoPincel);
                 else
                     desenhaNaMatriz(camadas[idCamadaAtiva]->getMatrizDesenho(), yRel, xRel, tamanhoPincel, -1, tipoPincel);
+                camadas[idCamadaAtiva]->getHistograma().marcaSujo(xRel - tamanhoPincel - 1, yRel - tamanhoPincel - 1,
+                                                                  xRel + tamanhoPincel + 1, yRel + tamanhoPincel + 1);
             }
 
             //ispressed == 2 é o botão direito do mouse, utilizado para movimentar a imagem
@@ -624,7 +644,7 @@ public:
         desenhaMenuTodasCamadas();
         desenhaMatrizesNaTela();
 
-        if(camadas[idCamadaAtiva]->getHasImage())
+        if(camadas[idCamadaAtiva]->getHasImage() && !camadas[idCamadaAtiva]->getEmTransformacao())
         {
 
             modificaBrilho();
@@ -633,6 +653,61 @@ public:
 
     }
 
+    // Teclas da ferramenta de transformacao da camada ativa:
+    // T inicia, +/- escala, Q/E rotaciona, Enter confirma e Esc cancela.
+    // Fora da transformacao, H mostra/esconde o histograma e L aplica niveis automaticos.
+    void teclado(int key)
+    {
+        Camada *camada = camadas[idCamadaAtiva];
+        if (!camada->getEmTransformacao())
+        {
+            if (key == 't' || key == 'T')
+                camada->iniciaTransformacao();
+            else if (key == 'h' || key == 'H')
+                mostraHistograma = !mostraHistograma;
+            else if (key == 'l' || key == 'L')
+                niveisAutomaticos();
+            return;
+        }
+
+        switch (key)
+        {
+            case '+': case '=': camada->escalaTransformacao(1.1f, 1.1f); break;
+            case '-': case '_': camada->escalaTransformacao(1 / 1.1f, 1 / 1.1f); break;
+            case 'q': case 'Q': camada->rotacionaTransformacao(5 * M_PI / 180); break;
+            case 'e': case 'E': camada->rotacionaTransformacao(-5 * M_PI / 180); break;
+            case 13: camada->confirmaTransformacao(); break;
+            case 27: camada->cancelaTransformacao(); break;
+        }
+    }
+
+    // Botao esquerdo arrasta as alcas dos cantos (transformacao livre), botao direito move a imagem.
+    void acaoTransformacao(int mouseX, int mouseY, int isPressed)
+    {
+        Camada *camada = camadas[idCamadaAtiva];
+
+        if (isPressed == 1)
+        {
+            if (cantoArrastado == -1)
+                cantoArrastado = camada->cantoProximo(mouseX, mouseY, 8);
+            if (cantoArrastado != -1)
+                camada->moveCantoTransformacao(cantoArrastado, mouseX, mouseY);
+        }
+        else if (isPressed == 2 && mouseX >= menuWidth)
+        {
+            if (movendoImagem)
+                camada->moveTransformacao(mouseX - ultimoMouseX, mouseY - ultimoMouseY);
+            movendoImagem = true;
+        }
+        else
+        {
+            cantoArrastado = -1;
+            movendoImagem = false;
+        }
+        ultimoMouseX = mouseX;
+        ultimoMouseY = mouseY;
+    }
+
     void desenhaMenu()
     {
         CV::color(0.7, 0.7, 0.7);
@@ -784,6 +859,7 @@ public:
         desenhaPreferenciaCamada();
         desenhaScrollCamada();
         desenhaMaisMenos();
+        desenhaMisturaCamada();
         camadas[idCamadaAtiva]->desenhaIsVisible();
     }
 
@@ -843,6 +919,7 @@ public:
     void flipHorizontal()
     {
         int **matrizDesenho = camadas[idCamadaAtiva]->getMatrizDesenho();
+        camadas[idCamadaAtiva]->getHistograma().marcaTudoSujo();
         for (int i = 0; i < matrizHeight; i++)
         {
             for (int j = 0; j < matrizWidth / 2; j++)
@@ -863,6 +940,7 @@ public:
     void flipVertical()
     {
         int **matrizDesenho = camadas[idCamadaAtiva]->getMatrizDesenho();
+        camadas[idCamadaAtiva]->getHistograma().marcaTudoSujo();
         for (int i = 0; i < matrizHeight / 2; i++)
         {
             for (int j = 0; j < matrizWidth; j++)
@@ -1020,36 +1098,136 @@ public:
 }
 
 
-    void desenhaMatrizNaTela(int **matrizDesenho)
+    void desenhaMatrizesNaTela()
     {
-        for (int i = 0; i < matrizHeight; i++)
-            for (int j = 0; j < matrizWidth; j++)
-                if (matrizDesenho[i][j] != -1)
-                {
-                    CV::color(matrizDesenho[i][j]);
-                    CV::point(j + menuWidth, i);
-                }
+        if(camadas[idCamadaAtiva]->getEmTransformacao())
+        {
+            camadas[idCamadaAtiva]->atualizaPreview(menuWidth, 0, screenWidth, screenHeight);
+        }
+
+        compositor->compoe(camadas, numeroCamadas, grade);
+        compositor->desenha();
+
+        if(mostraHistograma)
+        {
+            desenhaHistograma();
+        }
+
+        if(camadas[idCamadaAtiva]->getEmTransformacao())
+        {
+            camadas[idCamadaAtiva]->desenhaAlcasTransformacao();
+        }
     }
 
-    void desenhaMatrizesNaTela()
+    // Atualiza (so os blocos sujos) e desenha o histograma da camada ativa no canto
+    // superior direito da area de desenho, com o botao de niveis automaticos.
+    void desenhaHistograma()
     {
-
-        for(int i = numeroCamadas-1; i>=0; i--)
+        Camada *camada = camadas[idCamadaAtiva];
+        Compositor *comp = compositor;
+        camada->getHistograma().atualiza([=](int y, int x0, int x1, uint32_t *saida)
         {
-            if(camadas[i]->getAtiva()== 1)
-                {
-                    desenhaMatrizNaTela(grade);
-                }
-            if(camadas[i]->getVisivel() == 1)
+            comp->rasterizaTrecho(camada, y, x0, x1, saida);
+        });
+
+        int x0 = screenWidth - histogramaLargura - 10;
+        int y0 = screenHeight - histogramaAltura - 10;
+        CV::color(0, 0, 0, 0.6);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        CV::rectFill(x0, y0, x0 + histogramaLargura, y0 + histogramaAltura);
+        glDisable(GL_BLEND);
+
+        const uint32_t *lum = camada->getHistograma().getCanal(3);
+        uint32_t maximo = 1;
+        for (int v = 0; v < 256; v++)
+            if (lum[v] > maximo) maximo = lum[v];
+
+        CV::color(0.8, 0.8, 0.8);
+        for (int v = 0; v < 256; v++)
+            CV::line(x0 + v, y0, x0 + v, y0 + (float)lum[v] * histogramaAltura / maximo);
+
+        float cores[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+        for (int c = 0; c < 3; c++)
+        {
+            const uint32_t *h = camada->getHistograma().getCanal(c);
+            CV::color(cores[c][0], cores[c][1], cores[c][2]);
+            for (int v = 1; v < 256; v++)
             {
-                if(camadas[i]->getHasImage())
-                {
-                    camadas[i]->getImage()->renderLocalizado(camadas[i]->getImgX0(), camadas[i]->getImgY0());
-                }
-                desenhaMatrizNaTela(camadas[i]->getMatrizDesenho());
+                float ya = (float)h[v - 1] * histogramaAltura / maximo;
+                float yb = (float)h[v] * histogramaAltura / maximo;
+                CV::line(x0 + v - 1, y0 + (ya > histogramaAltura ? histogramaAltura : ya),
+                         x0 + v,     y0 + (yb > histogramaAltura ? histogramaAltura : yb));
             }
         }
+
+        CV::color(0.5, 0.5, 0.5);
+        CV::rectFill(x0, y0 - 24, x0 + 50, y0 - 4);
+        CV::color(0);
+        CV::text(x0 + 6, y0 - 19, "Auto");
+    }
+
+    void acaoHistograma(int mouseX, int mouseY, int click)
+    {
+        int x0 = screenWidth - histogramaLargura - 10;
+        int y0 = screenHeight - histogramaAltura - 10;
+        if (mostraHistograma && click == 1 && mouseX >= x0 && mouseX <= x0 + 50 && mouseY >= y0 - 24 && mouseY <= y0 - 4)
+        {
+            niveisAutomaticos();
+        }
+    }
+
+    // Niveis automaticos: estica cada canal da imagem da camada ativa usando uma LUT
+    // montada a partir do histograma ja agregado.
+    void niveisAutomaticos()
+    {
+        Camada *camada = camadas[idCamadaAtiva];
+        if (!camada->getHasImage() || camada->getEmTransformacao())
+            return;
+
+        unsigned char tabela[3][256];
+        if (camada->getHistograma().montaTabelaNiveis(tabela))
+        {
+            camada->getImage()->aplicaTabela(tabela);
+            camada->marcaImagemSuja();
+        }
     }
+
+    // Botao do modo de mistura e slider de opacidade da camada ativa (ao lado da lista de camadas)
+    void desenhaMisturaCamada()
+    {
+        Camada *camada = camadas[idCamadaAtiva];
+
+        CV::color(0.5, 0.5, 0.5);
+        CV::rectFill(165, 520, 235, 542);
+        CV::color(0);
+        CV::text(169, 526, nomesModoMistura[camada->getModoMistura()]);
+
+        CV::color(0.5, 0.5, 0.5);
+        CV::rectFill(170, 560, 230, 560 + sliderHeight);
+        int knobX = 170 + camada->getOpacidade() * 60 / 255;
+        CV::color(0);
+        CV::rectFill(knobX - 4, 556, knobX + 4, 564 + sliderHeight);
+
+        char label[20];
+        sprintf(label, "Op: %d%%", camada->getOpacidade() * 100 / 255);
+        CV::text(170, 578, label);
+    }
+
+    void acaoMisturaCamada(int mouseX, int mouseY, int isPressed, int click)
+    {
+        Camada *camada = camadas[idCamadaAtiva];
+
+        if (click == 1 && mouseX >= 165 && mouseX <= 235 && mouseY >= 520 && mouseY <= 542)
+        {
+            camada->setModoMistura((camada->getModoMistura() + 1) % NUM_MODOS_MISTURA);
+        }
+        if (isPressed == 1 && mouseX >= 166 && mouseX <= 234 && mouseY >= 552 && mouseY <= 572 + sliderHeight)
+        {
+            camada->setOpacidade((mouseX - 170) * 255 / 60);
+        }
+    }
+
     void modificaBrilho()
     {
         int brilhoAtual = camadas[idCamadaAtiva]->getBrilho();
@@ -1067,6 +1245,7 @@ public:
 
             }
             camadas[idCamadaAtiva]->setBrilho(brilhoSliderValue);
+            camadas[idCamadaAtiva]->marcaImagemSuja();
         }
     }
 };
@@ -14,6 +14,7 @@ Bmp::Bmp(const char *fileName)
 {
    width = height = 0;
    data = NULL;
+   alfa = NULL;
    if( fileName != NULL && strlen(fileName) > 0 )
    {
       load(fileName);
@@ -29,6 +30,23 @@ uchar* Bmp::getImage()
   return data;
 }
 
+uchar* Bmp::getAlfa()
+{
+  return alfa;
+}
+
+//troca o conteudo da imagem. A classe passa a ser dona dos buffers recebidos.
+void Bmp::substituiDados(uchar *novosDados, uchar *novoAlfa, int novaLargura, int novaAltura)
+{
+   delete[] data;
+   delete[] alfa;
+   data = novosDados;
+   alfa = novoAlfa;
+   width = novaLargura;
+   height = novaAltura;
+   imagesize = width*height*3;
+}
+
 int Bmp::getWidth(void)
 {
   return width;
@@ -89,6 +107,8 @@ void Bmp::renderLocalizado(int x0, int y0)
             for (int x = 0; x < width * 3; x += 3)
             {
                 int pos = y * width*3 + x;
+                if (alfa != NULL && alfa[pos/3] == 0)
+                    continue;
 
                 CV::color(
                     data[pos] / 255.0,
@@ -123,6 +143,12 @@ void Bmp::flipH()
         tmp = data[pos1+2];
         data[pos1+2] = data[pos2+2];
         data[pos2+2] = tmp;
+        if (alfa != NULL)
+        {
+           tmp = alfa[pos1/3];
+           alfa[pos1/3] = alfa[pos2/3];
+           alfa[pos2/3] = tmp;
+        }
      }
   }
 }
@@ -146,9 +172,29 @@ void Bmp::flipV()
         tmp = data[pos1+2];
         data[pos1+2] = data[pos2+2];
         data[pos2+2] = tmp;
+        if (alfa != NULL)
+        {
+           tmp = alfa[pos1/3];
+           alfa[pos1/3] = alfa[pos2/3];
+           alfa[pos2/3] = tmp;
+        }
      }
   }
 }
+//aplica uma tabela de conversao (LUT) por canal, usada nos niveis automaticos
+void Bmp::aplicaTabela(const unsigned char tabela[3][256])
+{
+  if( data != NULL )
+  {
+     for(int pos=0; pos<width*height*3; pos+=3)
+     {
+        data[pos]   = tabela[0][data[pos]];
+        data[pos+1] = tabela[1][data[pos+1]];
+        data[pos+2] = tabela[2][data[pos+2]];
+     }
+  }
+}
+
 void Bmp::aumentaBrilho(int fator)
 {
   if( data != NULL )
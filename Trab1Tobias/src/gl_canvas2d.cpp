@@ -215,6 +215,24 @@ void CV::color(float r, float g, float b, float alpha)
    glColor4d(r, g, b, alpha);
 }
 
+//desenha um bloco de pixels RGBA (8 bits por canal), linha 0 em y. Pixels com alfa zero nao sao desenhados.
+void CV::image(int x, int y, int w, int h, const unsigned char *rgba)
+{
+   if( w <= 0 || h <= 0 || rgba == NULL )
+      return;
+
+   //a posicao de raster e definida em (0,0) e deslocada com glBitmap, pois uma
+   //posicao inicial fora da viewport invalidaria o desenho inteiro.
+   glRasterPos2i(0, 0);
+   glBitmap(0, 0, 0, 0, (float)x, (float)y, NULL);
+
+   glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+   glEnable(GL_BLEND);
+   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+   glDrawPixels(w, h, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+   glDisable(GL_BLEND);
+}
+
 void special(int key, int , int )
 {
    keyboard(key+100);
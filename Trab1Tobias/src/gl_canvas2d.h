@@ -52,6 +52,9 @@ public:
 
     static void clear(float r, float g, float b);
 
+    //desenha um bloco de pixels RGBA com canto inicial em (x,y)
+    static void image(int x, int y, int w, int h, const unsigned char *rgba);
+
     //desenha texto na coordenada (x,y)
     static void text(float x, float y, const char *t);
     static void text(Vector2 pos, const char *t);  //varias funcoes ainda nao tem implementacao. Faca como exercicio
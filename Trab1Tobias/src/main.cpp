@@ -21,6 +21,7 @@ Abaixo há uma breve descrição do cumprimento das exigências:
 
 
     Cada imagem é exibida em sua própria camada com transparência binária.
+    Cada camada também tem opacidade e modo de mistura próprios (ver extras).
 
 
 4.Desenho com o mouse sobre a camada ativa
@@ -85,7 +86,20 @@ Abaixo há uma breve descrição do cumprimento das exigências:
 
 2.Redimensionamento e movimentação das imagens
 
-    As imagens das camadas podem ser movimentadas
+    As imagens das camadas podem ser movimentadas, escaladas, rotacionadas e
+    deformadas livremente (transformação afim pelos cantos). O preview usa
+    reamostragem bilinear em ponto fixo e a confirmação usa bicúbica.
+
+3.Opacidade e modos de mistura por camada
+
+    Normal, multiplicar, tela, sobrepor, adição e diferença. As camadas são compostas
+    em um único quadro RGBA pré-multiplicado (Composicao.h) e desenhado de uma vez.
+
+4.Histograma da camada ativa e níveis automáticos
+
+    Painel no canto superior direito (tecla H mostra/esconde) com os histogramas R, G, B
+    e de luminância. O histograma é mantido por blocos de 64x64 e só os blocos alterados
+    são recalculados. O botão "Auto" (ou a tecla L) aplica níveis automáticos na imagem.
 
 
 
@@ -131,6 +145,10 @@ tanto para a parte gráfica.
         Alterna a visibilidade da camada ativa (exibir ou ocultar).
 
 
+    Botão com o nome do modo (ao lado da lista de camadas)
+        Alterna o modo de mistura da camada ativa. O slider "Op" logo acima define a opacidade.
+
+
 
 🖌️ Seção de Desenho
     Formas pretas (quadrado, círculo, coração etc.)
@@ -166,6 +184,11 @@ tanto para a parte gráfica.
     Para mover:
         Selecione a camada e arraste a imagem pressionando o botão direito do mouse.
 
+    Para transformar (escala, rotação e transformação livre):
+        Com a camada ativa, pressione T. As teclas + e - escalam, Q e E rotacionam,
+        os cantos podem ser arrastados com o botão esquerdo e o botão direito move a imagem.
+        Enter confirma (reamostragem bicúbica) e Esc cancela.
+
 
 
 */
@@ -200,6 +223,7 @@ void render()
 // funcao chamada toda vez que uma tecla for pressionada.
 void keyboard(int key)
 {
+    screen->teclado(key);
 }
 
 // funcao chamada toda vez que uma tecla for liberada
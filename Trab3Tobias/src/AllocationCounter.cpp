@@ -0,0 +1,38 @@
+// Este arquivo implementa o contador de alocações: substitui o operator new e o
+// operator delete globais. As demais formas (new[], delete[], nothrow) chamam estas
+// por padrão, então também são contadas.
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<unsigned long> allocations(0);
+}
+
+namespace AllocationCounter
+{
+    unsigned long count()
+    {
+        return allocations.load(std::memory_order_relaxed);
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    for (;;) {
+        void* p = std::malloc(size);
+        if (p) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
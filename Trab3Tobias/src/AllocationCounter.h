@@ -0,0 +1,14 @@
+// Este arquivo declara o contador de alocações no heap do programa.
+// O operator new global é substituído (em AllocationCounter.cpp) por uma versão que
+// conta cada chamada antes de alocar com malloc; o benchmark o usa para verificar que os
+// ticks da simulação, depois do aquecimento, não alocam memória (ver FrameArena).
+#ifndef ___ALLOCATION_COUNTER__H___
+#define ___ALLOCATION_COUNTER__H___
+
+namespace AllocationCounter
+{
+    // Número de alocações (operator new) feitas desde o início do programa, em todas as threads.
+    unsigned long count();
+}
+
+#endif
@@ -0,0 +1,269 @@
+// Este arquivo define o AudioMixer, o mixer de efeitos sonoros em software.
+// O jogo só enfileira eventos (som, volume, panorâmica) numa SpscQueue sem travas e nunca
+// espera pelo mixer: com a fila cheia o evento é descartado e contado. Uma thread própria
+// retira os eventos, inicia as vozes e mistura os blocos de AUDIO_BLOCK_FRAMES quadros,
+// entregues a uma AudioSink (ex: WavFileSink).
+// Os sons são buffers PCM mono de 16 bits carregados antes de start (ver Sounds.h). No
+// máximo AUDIO_MAX_VOICES vozes tocam ao mesmo tempo; um som novo com todas ocupadas
+// toma a voz mais antiga (roubo de voz).
+// O relógio do áudio é o tempo do jogo: cada tick avança o relógio (advance) e os
+// eventos levam o quadro de áudio do tick em que foram gerados; o mixer só mistura os
+// quadros que o jogo já liberou e começa cada som no quadro exato do seu evento. Assim o
+// áudio acompanha o jogo tanto na janela quanto numa reprodução mais rápida que o tempo
+// real, e a mesma sequência de eventos gera sempre as mesmas amostras (ganhos inteiros).
+// Produtor (play, advance) e consumidor (a thread do mixer) seguem as regras da
+// SpscQueue: play pode ser chamado das fases seriais de escrita executadas pelo JobSystem,
+// nunca ao mesmo tempo por duas threads.
+// Sem suporte a threads (ex: MinGW sem gthreads), start falha e play ignora os eventos.
+// Não faz parte da simulação.
+#ifndef ___AUDIO_MIXER__H___
+#define ___AUDIO_MIXER__H___
+
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <stdint.h>
+#include "SpscQueue.h"
+#include "AudioSink.h"
+
+#if defined(_GLIBCXX_HAS_GTHREADS)
+#include <thread>
+#endif
+
+#define AUDIO_SAMPLE_RATE 22050     // quadros por segundo
+#define AUDIO_BLOCK_FRAMES 256      // quadros mixados de cada vez (~12 ms)
+#define AUDIO_MAX_VOICES 16         // sons tocando ao mesmo tempo
+#define AUDIO_MAX_SOUNDS 16         // sons carregados
+#define AUDIO_EVENT_QUEUE_SIZE 1024 // eventos pendentes (potência de dois)
+#define AUDIO_MASTER_GAIN 0.5f      // ganho geral, para várias vozes somadas não saturarem
+#define AUDIO_IDLE_SLEEP_MS 1       // espera da thread do mixer enquanto o jogo não libera quadros
+
+// Pedido para tocar um som.
+struct AudioEvent
+{
+    int sound;
+    float volume;   // 0 a 1
+    float pan;      // -1 = esquerda, 0 = centro, 1 = direita
+    uint64_t frame; // quadro de áudio em que o som começa
+};
+
+class AudioMixer
+{
+    // Uma voz toca um som do início ao fim; position < 0 = começa daqui a -position quadros.
+    struct Voice
+    {
+        const int16_t* samples;
+        int length;
+        int position;
+        int gainLeft, gainRight; // ganhos em ponto fixo (1 << 15 = 1)
+        uint64_t startFrame;     // para escolher a voz mais antiga no roubo
+        bool active;
+    };
+
+    std::vector<int16_t> sounds[AUDIO_MAX_SOUNDS];
+    SpscQueue<AudioEvent, AUDIO_EVENT_QUEUE_SIZE> events;
+    Voice voices[AUDIO_MAX_VOICES];
+    int32_t mixBuffer[AUDIO_BLOCK_FRAMES * 2];
+    int16_t outputBuffer[AUDIO_BLOCK_FRAMES * 2];
+    AudioSink* sink;
+
+    // lado do jogo
+    double producerSeconds;          // tempo do jogo liberado para o mixer
+    uint64_t producerFrame;          // producerSeconds em quadros (carimbo dos eventos)
+    unsigned long droppedEvents;     // eventos perdidos com a fila cheia
+
+    // compartilhados
+    std::atomic<uint64_t> releasedFrames; // quadros que o mixer pode misturar
+    std::atomic<bool> running;
+    std::atomic<bool> stopping;
+#if defined(_GLIBCXX_HAS_GTHREADS)
+    std::thread thread;
+#endif
+
+    // lado do mixer (lidos depois de stop)
+    uint64_t mixedFrames;
+    unsigned long startedVoices, stolenVoices, mixedBlocks;
+    double mixSeconds;
+
+    // Inicia uma voz para o evento, a offset quadros do início do bloco atual.
+    void startVoice(const AudioEvent& event, int offset)
+    {
+        if (event.sound < 0 || event.sound >= AUDIO_MAX_SOUNDS || sounds[event.sound].empty()) return;
+        int chosen = -1;
+        for (int i = 0; i < AUDIO_MAX_VOICES; ++i) {
+            if (!voices[i].active) {
+                chosen = i;
+                break;
+            }
+        }
+        if (chosen < 0) {
+            chosen = 0;
+            for (int i = 1; i < AUDIO_MAX_VOICES; ++i) {
+                if (voices[i].startFrame < voices[chosen].startFrame) chosen = i;
+            }
+            stolenVoices++;
+        }
+        // panorâmica de potência constante
+        float pan = std::max(-1.0f, std::min(1.0f, event.pan));
+        float volume = std::max(0.0f, std::min(1.0f, event.volume)) * AUDIO_MASTER_GAIN;
+        float angle = (pan + 1.0f) * 0.25f * 3.14159265f;
+        Voice& voice = voices[chosen];
+        voice.samples = &sounds[event.sound][0];
+        voice.length = (int)sounds[event.sound].size();
+        voice.position = -offset;
+        voice.gainLeft = (int)(cosf(angle) * volume * 32768.0f);
+        voice.gainRight = (int)(sinf(angle) * volume * 32768.0f);
+        voice.startFrame = event.frame;
+        voice.active = true;
+        startedVoices++;
+    }
+
+    // Mistura os próximos frames quadros (até AUDIO_BLOCK_FRAMES) e os entrega à saída.
+    void mix(int frames)
+    {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t blockEnd = mixedFrames + frames;
+        AudioEvent event;
+        for (const AudioEvent* next = events.front(); next && next->frame < blockEnd; next = events.front()) {
+            event = *next;
+            events.popFront();
+            startVoice(event, event.frame > mixedFrames ? (int)(event.frame - mixedFrames) : 0);
+        }
+
+        std::fill(mixBuffer, mixBuffer + frames * 2, 0);
+        for (Voice& voice : voices) {
+            if (!voice.active) continue;
+            int first = std::max(0, -voice.position);
+            int count = std::min(frames, voice.length - voice.position) - first;
+            const int16_t* in = voice.samples + voice.position + first;
+            int32_t* out = mixBuffer + first * 2;
+            for (int i = 0; i < count; ++i) {
+                int32_t sample = in[i];
+                out[2 * i] += (sample * voice.gainLeft) >> 15;
+                out[2 * i + 1] += (sample * voice.gainRight) >> 15;
+            }
+            voice.position += frames;
+            if (voice.position >= voice.length) voice.active = false;
+        }
+        for (int i = 0; i < frames * 2; ++i) {
+            outputBuffer[i] = (int16_t)std::max(-32768, std::min(32767, (int)mixBuffer[i]));
+        }
+        sink->write(outputBuffer, frames);
+
+        mixedFrames = blockEnd;
+        mixedBlocks++;
+        mixSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+#if defined(_GLIBCXX_HAS_GTHREADS)
+    // Laço da thread do mixer: mistura blocos inteiros enquanto o jogo libera quadros; ao
+    // parar, mistura o resto liberado (um bloco parcial).
+    void mixerLoop()
+    {
+        while (true) {
+            // stopping antes do relógio: depois de stop, o relógio lido já é o final
+            bool finishing = stopping.load(std::memory_order_acquire);
+            uint64_t released = releasedFrames.load(std::memory_order_acquire);
+            if (released - mixedFrames >= AUDIO_BLOCK_FRAMES) {
+                mix(AUDIO_BLOCK_FRAMES);
+                continue;
+            }
+            if (finishing) {
+                if (released > mixedFrames) mix((int)(released - mixedFrames));
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(AUDIO_IDLE_SLEEP_MS));
+        }
+    }
+#endif
+
+public:
+    AudioMixer()
+        : sink(nullptr), producerSeconds(0.0), producerFrame(0), droppedEvents(0), releasedFrames(0),
+          running(false), stopping(false), mixedFrames(0), startedVoices(0), stolenVoices(0),
+          mixedBlocks(0), mixSeconds(0.0)
+    {
+        for (Voice& voice : voices) {
+            voice.active = false;
+        }
+    }
+
+    ~AudioMixer() { stop(); }
+
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer& operator=(const AudioMixer&) = delete;
+
+    // Carrega o som de índice sound (PCM mono de 16 bits, AUDIO_SAMPLE_RATE). Só antes de start.
+    void load(int sound, const std::vector<int16_t>& samples)
+    {
+        if (sound < 0 || sound >= AUDIO_MAX_SOUNDS || running.load()) return;
+        sounds[sound] = samples;
+    }
+
+    // Inicia a thread do mixer, entregando o áudio a output (que deve existir até stop).
+    // Retorna false se já estava rodando ou se não há suporte a threads.
+    bool start(AudioSink* output)
+    {
+#if defined(_GLIBCXX_HAS_GTHREADS)
+        if (running.load() || !output) return false;
+        sink = output;
+        stopping = false;
+        running = true;
+        thread = std::thread(&AudioMixer::mixerLoop, this);
+        return true;
+#else
+        (void)output;
+        return false;
+#endif
+    }
+
+    // Mistura o que o jogo já liberou, encerra a thread e fecha a saída. Os eventos de
+    // quadros ainda não liberados são descartados.
+    void stop()
+    {
+#if defined(_GLIBCXX_HAS_GTHREADS)
+        if (!running.load()) return;
+        stopping.store(true, std::memory_order_release);
+        thread.join();
+        running = false;
+        sink->close();
+#endif
+    }
+
+    bool isRunning() const { return running.load(std::memory_order_relaxed); }
+
+    // Lado do jogo: toca sound no quadro atual. Nunca espera; retorna false se o mixer
+    // não está rodando ou se a fila está cheia (o evento é descartado).
+    bool play(int sound, float volume = 1.0f, float pan = 0.0f)
+    {
+        if (!running.load(std::memory_order_relaxed)) return false;
+        AudioEvent event = { sound, volume, pan, producerFrame };
+        if (!events.push(event)) {
+            droppedEvents++;
+            return false;
+        }
+        return true;
+    }
+
+    // Lado do jogo: avança o relógio do áudio em seconds (um tick), liberando os quadros
+    // correspondentes para o mixer.
+    void advance(float seconds)
+    {
+        producerSeconds += seconds;
+        producerFrame = (uint64_t)(producerSeconds * AUDIO_SAMPLE_RATE + 0.5);
+        releasedFrames.store(producerFrame, std::memory_order_release);
+    }
+
+    // Estatísticas (leituras exatas depois de stop).
+    unsigned long getDroppedEvents() const { return droppedEvents; }
+    unsigned long getStartedVoices() const { return startedVoices; }
+    unsigned long getStolenVoices() const { return stolenVoices; }
+    uint64_t getMixedFrames() const { return mixedFrames; }
+    unsigned long getMixedBlocks() const { return mixedBlocks; }
+    // Tempo médio de mixagem de um bloco, em microssegundos.
+    double getMicrosPerBlock() const { return mixedBlocks ? mixSeconds * 1e6 / mixedBlocks : 0.0; }
+};
+
+#endif
@@ -0,0 +1,117 @@
+// Este arquivo define AudioSink, a saída do AudioMixer, e WavFileSink, que grava o áudio
+// mixado num arquivo WAV (PCM de 16 bits, estéreo).
+// A saída recebe blocos de quadros estéreo intercalados (esquerdo, direito) na thread do
+// mixer. Uma saída para um dispositivo de áudio implementaria write bloqueando até haver
+// espaço no buffer do dispositivo; a saída em arquivo permite conferir o resultado da
+// mixagem e medir seu custo sem dispositivo de áudio (modo headless).
+// O cabeçalho do WAV é atualizado a cada WAV_HEADER_UPDATE_FRAMES quadros, então o arquivo
+// continua válido (até o último trecho atualizado) se o programa terminar sem close.
+#ifndef ___AUDIO_SINK__H___
+#define ___AUDIO_SINK__H___
+
+#include <cstdio>
+#include <stdint.h>
+
+#define WAV_HEADER_UPDATE_FRAMES 22050 // quadros gravados entre duas atualizações do cabeçalho
+
+// Saída do mixer: recebe os quadros mixados, na ordem.
+class AudioSink
+{
+public:
+    virtual ~AudioSink() {}
+
+    // Recebe frames quadros estéreo (2 * frames amostras intercaladas).
+    virtual void write(const int16_t* samples, int frames) = 0;
+
+    // Fim do áudio: grava o que estiver pendente.
+    virtual void close() {}
+};
+
+// Grava o áudio num arquivo WAV.
+class WavFileSink : public AudioSink
+{
+    FILE* file;
+    int sampleRate;
+    uint32_t framesWritten;
+    uint32_t framesSinceHeader;
+
+    static void putU32(unsigned char* out, uint32_t value)
+    {
+        out[0] = value & 0xff;
+        out[1] = (value >> 8) & 0xff;
+        out[2] = (value >> 16) & 0xff;
+        out[3] = (value >> 24) & 0xff;
+    }
+
+    static void putU16(unsigned char* out, uint16_t value)
+    {
+        out[0] = value & 0xff;
+        out[1] = (value >> 8) & 0xff;
+    }
+
+    // Escreve o cabeçalho RIFF/WAVE com o tamanho atual dos dados e volta ao fim do arquivo.
+    void writeHeader()
+    {
+        const int channels = 2, bytesPerSample = 2;
+        uint32_t dataBytes = framesWritten * channels * bytesPerSample;
+        unsigned char header[44] = { 'R', 'I', 'F', 'F', 0, 0, 0, 0, 'W', 'A', 'V', 'E',
+                                     'f', 'm', 't', ' ', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                     0, 0, 0, 0, 0, 0, 0, 0, 'd', 'a', 't', 'a', 0, 0, 0, 0 };
+        putU32(header + 4, 36 + dataBytes);
+        putU32(header + 16, 16);                                        // tamanho do bloco fmt
+        putU16(header + 20, 1);                                         // PCM
+        putU16(header + 22, channels);
+        putU32(header + 24, sampleRate);
+        putU32(header + 28, sampleRate * channels * bytesPerSample);    // bytes por segundo
+        putU16(header + 32, channels * bytesPerSample);                 // bytes por quadro
+        putU16(header + 34, bytesPerSample * 8);
+        putU32(header + 40, dataBytes);
+        fseek(file, 0, SEEK_SET);
+        fwrite(header, 1, sizeof(header), file);
+        fseek(file, 0, SEEK_END);
+        fflush(file);
+        framesSinceHeader = 0;
+    }
+
+public:
+    WavFileSink(const char* path, int sampleRate)
+        : file(fopen(path, "wb")), sampleRate(sampleRate), framesWritten(0), framesSinceHeader(0)
+    {
+        if (file) writeHeader();
+    }
+
+    ~WavFileSink() { close(); }
+
+    // O arquivo foi criado.
+    bool isOpen() const { return file != NULL; }
+
+    void write(const int16_t* samples, int frames)
+    {
+        if (!file || frames <= 0) return;
+        // o WAV é little-endian
+        unsigned char bytes[512];
+        int total = frames * 2;
+        for (int i = 0; i < total; ) {
+            int n = 0;
+            for (; i < total && n + 2 <= (int)sizeof(bytes); ++i, n += 2) {
+                putU16(bytes + n, (uint16_t)samples[i]);
+            }
+            fwrite(bytes, 1, n, file);
+        }
+        framesWritten += frames;
+        framesSinceHeader += frames;
+        if (framesSinceHeader >= WAV_HEADER_UPDATE_FRAMES) writeHeader();
+    }
+
+    void close()
+    {
+        if (!file) return;
+        writeHeader();
+        fclose(file);
+        file = NULL;
+    }
+
+    uint32_t getFramesWritten() const { return framesWritten; }
+};
+
+#endif
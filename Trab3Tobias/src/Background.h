@@ -9,11 +9,25 @@
 // - Utiliza a forma da pista (Track) para delimitar a ilha e posicionar objetos.
 // - Os objetos decorativos e as features da água são gerados com sementes de aleatoriedade
 //   para garantir consistência visual entre execuções ou quando a pista muda.
+// - Quando só um trecho da pista muda (edição de um ponto de controle), apenas os objetos
+//   ancorados nos segmentos alterados são refeitos (ver Track::getDirtySegments).
+// - O cenário é desenhado em coordenadas do mundo, pela câmera. As features da água e os
+//   objetos decorativos ficam em SpatialHashes e só os que cruzam a área visível são
+//   desenhados, então o custo não depende do tamanho do mundo.
+// - O cenário composto (mar, ilha e objetos) é guardado em uma textura (ScreenCache): uma
+//   região do mundo maior que a tela, com BACKGROUND_CACHE_MARGIN de cada lado da área
+//   visível, desenhada deslocada pela câmera. Ela só é redesenhada quando a revisão da pista
+//   ou o tamanho da tela mudam ou quando a área visível sai da região guardada; nos outros
+//   quadros custa um retângulo. Os vértices montados no desenho ficam na FrameArena.
 #ifndef BACKGROUND_H_INCLUDED
 #define BACKGROUND_H_INCLUDED
 
 #include "gl_canvas2d.h"
 #include "Track.h"
+#include "ScreenCache.h"
+#include "SpatialHash.h"
+#include "Camera.h"
+#include "FrameArena.h"
 #include <vector>
 #include <cmath>
 #include <cstdlib> 
@@ -23,6 +37,9 @@
 #ifndef PI
 #define PI 3.14159265359
 #endif
+#define BACKGROUND_CELL_SIZE 128.0f   // células das SpatialHashes do cenário
+#define BACKGROUND_DECOR_RADIUS 50.0f // maior distância do desenho de um objeto até sua posição
+#define BACKGROUND_CACHE_MARGIN 0.25f // margem da região guardada em cada lado, em frações da tela
 #ifndef PI_2 
 #define PI_2 6.28318530718
 #endif
@@ -61,52 +78,84 @@ struct DecorativeObject {
 
     
     std::vector<BushClumpInfo> bushClumpDetails;
+
+    int anchorSegment; // segmento da curva externa da pista ao lado do qual o objeto foi posicionado
 };
 
 class Background {
 public:
     // Construtor da classe Background.
-    // Inicializa a semente para a geração de features da água e as gera.
-    Background(int screenWidth, int screenHeight) {
+    // Inicializa a semente para a geração de features da água e as gera sobre o mundo
+    // inteiro (a quantidade é proporcional à área do mundo em telas de screenWidth x screenHeight).
+    Background(int worldWidth, int worldHeight, int screenWidth, int screenHeight)
+        : decorGenerated(false), decorRevision(0), waterHash(BACKGROUND_CELL_SIZE), decorHash(BACKGROUND_CELL_SIZE) {
         srand(12345); 
 
-        
-        generateWaterFeatures(screenWidth, screenHeight, 80, 50.0f, 150.0f, 8.0f, 25.0f, 0.05f, 0.3f, 0.6f, 0.7f);
-        generateWaterFeatures(screenWidth, screenHeight, 100, 30.0f, 120.0f, 6.0f, 20.0f, 0.1f, 0.4f, 0.7f, 0.6f);
-        generateWaterFeatures(screenWidth, screenHeight, 120, 15.0f, 80.0f, 4.0f, 15.0f, 0.3f, 0.6f, 0.85f, 0.8f);
-        generateWaterFeatures(screenWidth, screenHeight, 150, 5.0f, 40.0f, 3.0f, 8.0f, 0.7f, 0.85f, 0.95f, 0.75f);
+        float screens = std::max(1.0f, (worldWidth / (float)screenWidth) * (worldHeight / (float)screenHeight));
+        generateWaterFeatures(worldWidth, worldHeight, (int)(80 * screens), 50.0f, 150.0f, 8.0f, 25.0f, 0.05f, 0.3f, 0.6f, 0.7f);
+        generateWaterFeatures(worldWidth, worldHeight, (int)(100 * screens), 30.0f, 120.0f, 6.0f, 20.0f, 0.1f, 0.4f, 0.7f, 0.6f);
+        generateWaterFeatures(worldWidth, worldHeight, (int)(120 * screens), 15.0f, 80.0f, 4.0f, 15.0f, 0.3f, 0.6f, 0.85f, 0.8f);
+        generateWaterFeatures(worldWidth, worldHeight, (int)(150 * screens), 5.0f, 40.0f, 3.0f, 8.0f, 0.7f, 0.85f, 0.95f, 0.75f);
+
+        waterHash.clear();
+        for (const auto& feature : waterFeatures) {
+            waterHash.insert(feature.vertices);
+        }
+        waterHash.build();
     }
 
-    // Desenha todos os elementos do background.
-    // Verifica se a pista mudou para regenerar os objetos decorativos.
-    // Desenha o mar, a ilha/praia e os objetos decorativos.
-    void draw(int screenWidth, int screenHeight, const Track& track) {
-        const auto& currentOuterTrackPoints = track.getOuterCurvePoints();
-        bool trackChanged = false;
-
-        if (currentOuterTrackPoints.size() != lastOuterTrackPointsForDecor.size()) {
-            trackChanged = true;
-        } else {
-            for (size_t i = 0; i < currentOuterTrackPoints.size(); ++i) {
-                
-                
-                if (std::fabs(currentOuterTrackPoints[i].x - lastOuterTrackPointsForDecor[i].x) > 0.001f ||
-                    std::fabs(currentOuterTrackPoints[i].y - lastOuterTrackPointsForDecor[i].y) > 0.001f) {
-                    trackChanged = true;
-                    break;
-                }
-            }
+    // Desenha todos os elementos do background na área visível da câmera (a câmera já
+    // deve estar ativa, ver Camera::begin).
+    // Se a revisão da pista e o tamanho da tela não mudaram e a área visível está dentro da
+    // região guardada, desenha a textura guardada. Senão atualiza os objetos decorativos (se
+    // só um trecho da curva externa mudou, apenas os objetos desse trecho são refeitos),
+    // desenha o mar, a ilha/praia e os objetos de uma região em volta da área visível e a
+    // guarda na textura.
+    void draw(int screenWidth, int screenHeight, const Track& track, const Camera& camera) {
+        if (cache.covers(track.getRevision(), screenWidth, screenHeight,
+                         camera.getMinX(), camera.getMinY(), camera.getMaxX(), camera.getMaxY())) {
+            cache.draw();
+            return;
         }
 
-        if (trackChanged || lastOuterTrackPointsForDecor.empty()) {
+        int dirtyFirst, dirtyCount;
+        if (!decorGenerated || !track.getDirtySegments(decorRevision, false, dirtyFirst, dirtyCount)) {
             srand(54321); 
             generateDecorativeObjects(screenWidth, screenHeight, track);
-            lastOuterTrackPointsForDecor = currentOuterTrackPoints; 
+            decorGenerated = true;
+            rebuildDecorHash();
+        } else if (dirtyCount > 0) {
+            updateDecorativeObjects(track, dirtyFirst, dirtyCount);
+            rebuildDecorHash();
         }
-
-        drawSea(screenWidth, screenHeight);
-        drawIslandAndBeach(screenWidth, screenHeight, track);
-        drawDecorativeObjects(screenWidth, screenHeight);
+        decorRevision = track.getRevision();
+
+        if (cache.isSupported()) {
+            // região guardada: a área visível com a margem, limitada ao mundo (ou à área
+            // visível, se ela passa do mundo) e ao tamanho de textura aceito pelo driver
+            int maxSize = ScreenCache::getMaxTextureSize();
+            float marginX = std::min(screenWidth * BACKGROUND_CACHE_MARGIN, std::max(0.0f, (maxSize - screenWidth) * 0.5f - 1.0f));
+            float marginY = std::min(screenHeight * BACKGROUND_CACHE_MARGIN, std::max(0.0f, (maxSize - screenHeight) * 0.5f - 1.0f));
+            int x0 = (int)std::floor(std::max(std::min(camera.getMinX(), 0.0f), camera.getMinX() - marginX));
+            int y0 = (int)std::floor(std::max(std::min(camera.getMinY(), 0.0f), camera.getMinY() - marginY));
+            int x1 = (int)std::ceil(std::min(std::max(camera.getMaxX(), camera.getWorldWidth()), camera.getMaxX() + marginX));
+            int y1 = (int)std::ceil(std::min(std::max(camera.getMaxY(), camera.getWorldHeight()), camera.getMaxY() + marginY));
+            bool captured = cache.capture(track.getRevision(), screenWidth, screenHeight, x0, y0, x1 - x0, y1 - y0,
+                                          [&](float tileX, float tileY) {
+                Camera tile = camera.movedTo(Vector2(tileX, tileY));
+                drawSea(tile);
+                drawIslandAndBeach(tile, track);
+                drawDecorativeObjects(tile);
+            });
+            camera.begin();
+            if (captured) {
+                cache.draw();
+                return;
+            }
+        }
+        drawSea(camera);
+        drawIslandAndBeach(camera, track);
+        drawDecorativeObjects(camera);
     }
 
 private:
@@ -116,7 +165,14 @@ private:
     };
     std::vector<WaterFeature> waterFeatures;
     std::vector<DecorativeObject> decorativeObjects;
-    std::vector<Vector2> lastOuterTrackPointsForDecor; 
+    bool decorGenerated;     // os objetos decorativos já foram gerados para alguma pista
+    unsigned decorRevision;  // revisão da pista usada na última atualização dos objetos
+    ScreenCache cache;       // cenário composto de uma região em volta da última área visível desenhada
+    SpatialHash waterHash;   // caixas das features da água (handle = índice em waterFeatures)
+    SpatialHash decorHash;   // posições dos objetos decorativos (handle = índice em decorativeObjects)
+    std::vector<int> visible; // itens visíveis no quadro, em ordem de índice (ordem de desenho)
+    const float minDecorOffsetFromTrack = 20.0f; // distância dos objetos até a borda externa
+    const float maxDecorOffsetFromTrack = 75.0f;
 
     // Gera "features" de água (formas poligonais sinuosas) para adicionar detalhe visual ao mar.
     // Os parâmetros controlam o número, tamanho, forma e cor dessas features.
@@ -184,17 +240,39 @@ private:
         }
     }
 
-    // Desenha o mar, incluindo uma cor base e as features de água geradas.
-    void drawSea(int screenWidth, int screenHeight) {
+    // Reconstrói a SpatialHash dos objetos decorativos (depois de gerá-los ou atualizá-los).
+    void rebuildDecorHash() {
+        decorHash.clear();
+        for (const auto& obj : decorativeObjects) {
+            decorHash.insert(obj.position.x - BACKGROUND_DECOR_RADIUS, obj.position.y - BACKGROUND_DECOR_RADIUS,
+                             obj.position.x + BACKGROUND_DECOR_RADIUS, obj.position.y + BACKGROUND_DECOR_RADIUS);
+        }
+        decorHash.build();
+    }
+
+    // Preenche visible com os itens da SpatialHash que cruzam a área visível, em ordem de
+    // índice (a ordem da consulta depende das células e mudaria a sobreposição ao mover a câmera).
+    void collectVisible(const SpatialHash& hash, const Camera& camera) {
+        visible.clear();
+        hash.query(camera.getMinX(), camera.getMinY(), camera.getMaxX(), camera.getMaxY(), [this](int handle) {
+            visible.push_back(handle);
+            return true;
+        });
+        std::sort(visible.begin(), visible.end());
+    }
+
+    // Desenha o mar na área visível, incluindo uma cor base e as features de água.
+    void drawSea(const Camera& camera) {
         
         CV::color(0.02f, 0.1f, 0.2f); 
-        CV::rectFill(0, 0, screenWidth, screenHeight);
+        CV::rectFill(camera.getMinX(), camera.getMinY(), camera.getMaxX(), camera.getMaxY());
 
-        
-        for (const auto& feature : waterFeatures) {
+        collectVisible(waterHash, camera);
+        for (int index : visible) {
+            const WaterFeature& feature = waterFeatures[index];
             if (feature.vertices.size() < 3) continue;
 
-            std::vector<float> vx, vy;
+            FrameVector<float> vx, vy;
             vx.reserve(feature.vertices.size());
             vy.reserve(feature.vertices.size());
             for (const auto& p : feature.vertices) {
@@ -220,12 +298,12 @@ private:
     }
 
     // Desloca um conjunto de pontos para fora a partir de um centroide por um valor de offset.
-    // Cada ponto é movido ao longo da linha que o conecta ao centroide.
-    std::vector<Vector2> offsetPoints(const std::vector<Vector2>& originalPoints, float offsetValue, const Vector2& centroid) {
-        std::vector<Vector2> newPoints;
-        if (originalPoints.empty()) {
-            return newPoints;
-        }
+    // Cada ponto é movido ao longo da linha que o conecta ao centroide. O resultado vai para
+    // newPoints (um vetor comum ou um FrameVector, no desenho).
+    template <typename Points>
+    void offsetPoints(const std::vector<Vector2>& originalPoints, float offsetValue, const Vector2& centroid, Points& newPoints) {
+        newPoints.clear();
+        newPoints.reserve(originalPoints.size());
 
         for (const auto& p : originalPoints) {
             Vector2 direction = p - centroid;
@@ -240,12 +318,12 @@ private:
             }
             newPoints.push_back(p + direction * offsetValue);
         }
-        return newPoints;
     }
     // Desenha a ilha e a praia.
     // Utiliza os pontos da curva externa da pista como base e cria camadas
     // progressivamente maiores (offset) para simular a praia e a massa de terra da ilha.
-    void drawIslandAndBeach(int screenWidth, int screenHeight, const Track& track) {
+    // Camadas fora da área visível são descartadas pela caixa.
+    void drawIslandAndBeach(const Camera& camera, const Track& track) {
         const auto& outerTrackPoints = track.getOuterCurvePoints();
 
         if (outerTrackPoints.size() < 3) {
@@ -262,7 +340,7 @@ private:
             float r, g, b;     
         };
 
-        std::vector<IslandLayer> layers = {
+        static const IslandLayer layers[] = {
             
             {80.0f, 0.1f, 0.35f, 0.1f},  
             
@@ -273,42 +351,163 @@ private:
             {20.0f, 0.96f, 0.87f, 0.70f}  
         };
 
+        // pontos temporários do quadro, na FrameArena
+        FrameVector<Vector2> layerBoundaryPoints;
         for (const auto& layer : layers) {
-            std::vector<Vector2> layerBoundaryPoints = offsetPoints(outerTrackPoints, layer.offset, centroid);
+            offsetPoints(outerTrackPoints, layer.offset, centroid, layerBoundaryPoints);
 
             if (layerBoundaryPoints.size() >= 3) {
                 CV::color(layer.r, layer.g, layer.b);
 
                 
-                std::vector<float> vx, vy;
+                FrameVector<float> vx, vy;
                 vx.reserve(layerBoundaryPoints.size());
                 vy.reserve(layerBoundaryPoints.size());
+                float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
                 for (const auto& p : layerBoundaryPoints) {
                     vx.push_back(p.x);
                     vy.push_back(p.y);
+                    minX = std::min(minX, p.x); maxX = std::max(maxX, p.x);
+                    minY = std::min(minY, p.y); maxY = std::max(maxY, p.y);
                 }
+                if (!camera.isVisible(minX, minY, maxX, maxY)) continue;
                 CV::polygonFill(vx.data(), vy.data(), layerBoundaryPoints.size());
             }
         }
     }
 
+    // Dados da pista usados no posicionamento dos objetos decorativos, calculados uma vez
+    // por geração (e não a cada tentativa).
+    struct DecorPlacementContext {
+        const Track* track;
+        Vector2 trackCentroid;
+        std::vector<Vector2> outermostIslandBoundary;
+    };
+
+    DecorPlacementContext makePlacementContext(const Track& track) {
+        const auto& outerTrack = track.getOuterCurvePoints();
+        DecorPlacementContext context;
+        context.track = &track;
+        context.trackCentroid = calculateCentroid(track.getInnerCurvePoints().empty() ? outerTrack : track.getInnerCurvePoints());
+        offsetPoints(outerTrack, maxDecorOffsetFromTrack + 20.0f, calculateCentroid(outerTrack), context.outermostIslandBoundary);
+        return context;
+    }
+
+    // Cria um objeto decorativo do tipo dado com parâmetros aleatórios.
+    DecorativeObject createDecorativeObject(ObjectType type, const Vector2& position, int anchorSegment) {
+        DecorativeObject newObj;
+        newObj.type = type;
+        newObj.position = position;
+        newObj.anchorSegment = anchorSegment;
+        newObj.rotation = (rand() / (float)RAND_MAX) * PI_2;
+
+        if (type == ObjectType::HOUSE) {
+            newObj.size_param1 = 20 + rand() % 15; 
+            newObj.size_param2 = 15 + rand() % 10; 
+            newObj.r1 = 0.6f + (rand() % 40) / 100.0f; newObj.g1 = 0.4f + (rand() % 40) / 100.0f; newObj.b1 = 0.2f + (rand() % 30) / 100.0f; 
+            newObj.r2 = 0.4f + (rand() % 30) / 100.0f; newObj.g2 = 0.2f + (rand() % 20) / 100.0f; newObj.b2 = 0.1f + (rand() % 20) / 100.0f; 
+        } else if (type == ObjectType::PALM_TREE) {
+            newObj.size_param1 = 25 + rand() % 20; 
+            newObj.size_param2 = 15 + rand() % 10; 
+            newObj.r1 = 0.4f; newObj.g1 = 0.25f; newObj.b1 = 0.1f; 
+            newObj.r2 = 0.1f; newObj.g2 = 0.5f + (rand()%30)/100.0f; newObj.b2 = 0.1f; 
+
+            int num_leaves_generated = 7 + rand() % 4;
+            newObj.palmLeafDetails.reserve(num_leaves_generated);
+            for (int k = 0; k < num_leaves_generated; ++k) {
+                LeafInfo leaf;
+                
+                
+                
+                leaf.angle = ((float)k / num_leaves_generated) * PI_2 + (rand() / (float)RAND_MAX - 0.5f) * (PI_2 / num_leaves_generated * 0.5f); 
+                leaf.length = newObj.size_param2 * (0.7f + (rand() / (float)RAND_MAX) * 0.5f); 
+                newObj.palmLeafDetails.push_back(leaf);
+            }
+        } else if (type == ObjectType::ROCK) {
+            newObj.size_param1 = 5 + rand() % 10; 
+            newObj.size_param2 = 0; 
+            newObj.r1 = 0.4f + (rand()%20)/100.0f; newObj.g1 = newObj.r1; newObj.b1 = newObj.r1; 
+
+            int numRockVertices = 4 + rand() % 4; 
+            newObj.rockVertices.reserve(numRockVertices);
+            for(int v=0; v<numRockVertices; ++v) {
+                float angle_v = (float)v / numRockVertices * PI_2 + (rand()/(float)RAND_MAX - 0.5f) * 0.5f;
+                float radius_v = newObj.size_param1 * (0.7f + (rand()/(float)RAND_MAX) * 0.6f);
+                newObj.rockVertices.push_back(Vector2(cos(angle_v)*radius_v, sin(angle_v)*radius_v));
+            }
+        } else if (type == ObjectType::BUSH) {
+            newObj.size_param1 = 8 + rand() % 8; 
+            newObj.size_param2 = 0;
+            newObj.r1 = 0.1f + (rand()%10)/100.0f; newObj.g1 = 0.3f + (rand()%20)/100.0f; newObj.b1 = 0.05f + (rand()%10)/100.0f; 
+
+            int num_clumps_generated = 3 + rand()%3;
+            newObj.bushClumpDetails.reserve(num_clumps_generated);
+            for (int c = 0; c < num_clumps_generated; ++c) {
+                BushClumpInfo clump;
+                clump.offset.x = (rand()/(float)RAND_MAX - 0.5f) * newObj.size_param1 * 0.5f;
+                clump.offset.y = (rand()/(float)RAND_MAX - 0.5f) * newObj.size_param1 * 0.5f;
+                clump.radius = newObj.size_param1 * (0.4f + (rand()/(float)RAND_MAX)*0.3f);
+                newObj.bushClumpDetails.push_back(clump);
+            }
+        }
+        return newObj;
+    }
+
+    // Posiciona count objetos do tipo dado perto da borda externa da pista, ancorados em pontos
+    // da curva externa sorteados no trecho circular [firstAnchor, firstAnchor + anchorCount).
+    void placeDecorativeObjects(ObjectType type, int count, const DecorPlacementContext& context,
+                                int firstAnchor, int anchorCount) {
+        const auto& outerTrack = context.track->getOuterCurvePoints();
+        if (outerTrack.empty() || anchorCount <= 0) return;
+
+        for (int i = 0; i < count; ++i) {
+            int attempts = 0;
+            bool placed = false;
+            while (!placed && attempts < 50) {
+                attempts++;
+                int randomTrackPointIndex = (firstAnchor + rand() % anchorCount) % outerTrack.size();
+                Vector2 pointOnTrackEdge = outerTrack[randomTrackPointIndex];
+
+                // a normal da borda é orientada para fora da pista (longe do centroide)
+                Vector2 p1 = outerTrack[randomTrackPointIndex];
+                Vector2 p2 = outerTrack[(randomTrackPointIndex + 1) % outerTrack.size()];
+                Vector2 tangent = (p2 - p1).normalized();
+                Vector2 normal = tangent.perpendicular(); 
+                if ((pointOnTrackEdge + normal * 10.0f - context.trackCentroid).lengthSquared() < (pointOnTrackEdge - normal * 10.0f - context.trackCentroid).lengthSquared()) {
+                    normal = normal * -1.0f; 
+                }
+
+                float randomOffset = minDecorOffsetFromTrack + (rand() / (float)RAND_MAX) * (maxDecorOffsetFromTrack - minDecorOffsetFromTrack);
+                Vector2 candidatePos = pointOnTrackEdge + normal * randomOffset;
+
+                if (context.track->isPointInsideTrack(candidatePos)) continue; 
+                if (context.outermostIslandBoundary.empty() || !isPointInPolygon(candidatePos, context.outermostIslandBoundary)) continue;
+
+                bool tooCloseToOtherObject = false;
+                for (const auto& obj : decorativeObjects) {
+                    if ((candidatePos - obj.position).lengthSquared() < (20.0f * 20.0f)) { 
+                        tooCloseToOtherObject = true;
+                        break;
+                    }
+                }
+                if (tooCloseToOtherObject) continue;
+
+                int anchorSegment = context.track->getSegmentOfPoint(false, randomTrackPointIndex);
+                decorativeObjects.push_back(createDecorativeObject(type, candidatePos, anchorSegment));
+                placed = true;
+            }
+        }
+    }
+
     // Gera os objetos decorativos (casas, palmeiras, pedras, arbustos).
     // Os objetos são posicionados aleatoriamente em uma área ao redor da pista,
     // evitando sobreposição com a própria pista e com outros objetos.
     // A quantidade de cada tipo de objeto é baseada no comprimento estimado da pista.
     void generateDecorativeObjects(int sWidth, int sHeight, const Track& track) {
         decorativeObjects.clear();
-        if (track.getOuterCurvePoints().empty()) return;
-
         const auto& outerTrack = track.getOuterCurvePoints();
-        Vector2 islandCentroid = calculateCentroid(outerTrack);
-
-        
-        
-        float minOffsetFromTrack = 20.0f; 
-        float maxOffsetFromTrack = 75.0f; 
+        if (outerTrack.empty()) return;
 
-        
         float trackLength = 0.0f;
         if (outerTrack.size() > 1) {
             for (size_t i = 0; i < outerTrack.size(); ++i) {
@@ -322,131 +521,53 @@ private:
         int numRocks = std::max(0, (int)(trackLength / 100.0f));
         int numBushes = std::max(0, (int)(trackLength / 120.0f));
 
-        auto placeObject = [&](ObjectType type, int count) {
-            for (int i = 0; i < count; ++i) {
-                int attempts = 0;
-                bool placed = false;
-                while (!placed && attempts < 50) {
-                    attempts++;
-                    if (outerTrack.empty()) break; 
-                    int randomTrackPointIndex = rand() % outerTrack.size();
-                    Vector2 pointOnTrackEdge = outerTrack[randomTrackPointIndex];
-
-                    
-                    
-                    
-                                                               
-
-                    
-                    
-                    
-                    Vector2 p1 = outerTrack[randomTrackPointIndex];
-                    Vector2 p2 = outerTrack[(randomTrackPointIndex + 1) % outerTrack.size()];
-                    Vector2 tangent = (p2 - p1).normalized();
-                    Vector2 normal = tangent.perpendicular(); 
-
-                    
-                    
-                    Vector2 trackCentroid = calculateCentroid(track.getInnerCurvePoints().empty() ? outerTrack : track.getInnerCurvePoints());
-                    if ((pointOnTrackEdge + normal * 10.0f - trackCentroid).lengthSquared() < (pointOnTrackEdge - normal * 10.0f - trackCentroid).lengthSquared()) {
-                        normal = normal * -1.0f; 
-                    }
-
-                    float randomOffset = minOffsetFromTrack + (rand() / (float)RAND_MAX) * (maxOffsetFromTrack - minOffsetFromTrack);
-                    Vector2 candidatePos = pointOnTrackEdge + normal * randomOffset;
-
-                    
-                    if (track.isPointInsideTrack(candidatePos)) continue; 
-
-                    
-                    bool insideIslandArea = false;
-                    std::vector<Vector2> outermostIslandBoundary = offsetPoints(outerTrack, maxOffsetFromTrack + 20.0f, islandCentroid);
-                    if (!outermostIslandBoundary.empty() && isPointInPolygon(candidatePos, outermostIslandBoundary)) {
-                         insideIslandArea = true;
-                    }
-                    if(!insideIslandArea) continue;
+        DecorPlacementContext context = makePlacementContext(track);
+        int n = (int)outerTrack.size();
+        placeDecorativeObjects(ObjectType::HOUSE, numHouses, context, 0, n);
+        placeDecorativeObjects(ObjectType::PALM_TREE, numPalmTrees, context, 0, n);
+        placeDecorativeObjects(ObjectType::ROCK, numRocks, context, 0, n);
+        placeDecorativeObjects(ObjectType::BUSH, numBushes, context, 0, n);
+    }
 
-                    
-                    bool tooCloseToOtherObject = false;
-                    for (const auto& obj : decorativeObjects) {
-                        if ((candidatePos - obj.position).lengthSquared() < (20.0f * 20.0f)) { 
-                            tooCloseToOtherObject = true;
-                            break;
-                        }
-                    }
-                    if (tooCloseToOtherObject) continue;
-
-                    DecorativeObject newObj;
-                    newObj.type = type;
-                    newObj.position = candidatePos;
-                    newObj.rotation = (rand() / (float)RAND_MAX) * PI_2;
-
-                    if (type == ObjectType::HOUSE) {
-                        newObj.size_param1 = 20 + rand() % 15; 
-                        newObj.size_param2 = 15 + rand() % 10; 
-                        newObj.r1 = 0.6f + (rand() % 40) / 100.0f; newObj.g1 = 0.4f + (rand() % 40) / 100.0f; newObj.b1 = 0.2f + (rand() % 30) / 100.0f; 
-                        newObj.r2 = 0.4f + (rand() % 30) / 100.0f; newObj.g2 = 0.2f + (rand() % 20) / 100.0f; newObj.b2 = 0.1f + (rand() % 20) / 100.0f; 
-                    } else if (type == ObjectType::PALM_TREE) {
-                        newObj.size_param1 = 25 + rand() % 20; 
-                        newObj.size_param2 = 15 + rand() % 10; 
-                        newObj.r1 = 0.4f; newObj.g1 = 0.25f; newObj.b1 = 0.1f; 
-                        newObj.r2 = 0.1f; newObj.g2 = 0.5f + (rand()%30)/100.0f; newObj.b2 = 0.1f; 
-
-                        int num_leaves_generated = 7 + rand() % 4;
-                        newObj.palmLeafDetails.reserve(num_leaves_generated);
-                        for (int k = 0; k < num_leaves_generated; ++k) {
-                            LeafInfo leaf;
-                            
-                            
-                            
-                            leaf.angle = ((float)k / num_leaves_generated) * PI_2 + (rand() / (float)RAND_MAX - 0.5f) * (PI_2 / num_leaves_generated * 0.5f); 
-                            leaf.length = newObj.size_param2 * (0.7f + (rand() / (float)RAND_MAX) * 0.5f); 
-                            newObj.palmLeafDetails.push_back(leaf);
-                        }
-                    } else if (type == ObjectType::ROCK) {
-                        newObj.size_param1 = 5 + rand() % 10; 
-                        newObj.size_param2 = 0; 
-                        newObj.r1 = 0.4f + (rand()%20)/100.0f; newObj.g1 = newObj.r1; newObj.b1 = newObj.r1; 
-
-                        int numRockVertices = 4 + rand() % 4; 
-                        newObj.rockVertices.reserve(numRockVertices);
-                        for(int v=0; v<numRockVertices; ++v) {
-                            float angle_v = (float)v / numRockVertices * PI_2 + (rand()/(float)RAND_MAX - 0.5f) * 0.5f;
-                            float radius_v = newObj.size_param1 * (0.7f + (rand()/(float)RAND_MAX) * 0.6f);
-                            newObj.rockVertices.push_back(Vector2(cos(angle_v)*radius_v, sin(angle_v)*radius_v));
-                        }
-                    } else if (type == ObjectType::BUSH) {
-                        newObj.size_param1 = 8 + rand() % 8; 
-                        newObj.size_param2 = 0;
-                        newObj.r1 = 0.1f + (rand()%10)/100.0f; newObj.g1 = 0.3f + (rand()%20)/100.0f; newObj.b1 = 0.05f + (rand()%10)/100.0f; 
-
-                        int num_clumps_generated = 3 + rand()%3;
-                        newObj.bushClumpDetails.reserve(num_clumps_generated);
-                        for (int c = 0; c < num_clumps_generated; ++c) {
-                            BushClumpInfo clump;
-                            clump.offset.x = (rand()/(float)RAND_MAX - 0.5f) * newObj.size_param1 * 0.5f;
-                            clump.offset.y = (rand()/(float)RAND_MAX - 0.5f) * newObj.size_param1 * 0.5f;
-                            clump.radius = newObj.size_param1 * (0.4f + (rand()/(float)RAND_MAX)*0.3f);
-                            newObj.bushClumpDetails.push_back(clump);
-                        }
-                    }
-                    decorativeObjects.push_back(newObj);
-                    placed = true;
-                }
+    // Atualiza os objetos decorativos depois que só os segmentos [firstSegment, firstSegment +
+    // segmentCount) (circular) da curva externa mudaram: os objetos ancorados nesses segmentos,
+    // ou que ficaram sobre a pista, são removidos e a mesma quantidade de cada tipo é
+    // reposicionada nos pontos desses segmentos.
+    void updateDecorativeObjects(const Track& track, int firstSegment, int segmentCount) {
+        int segments = track.getSegmentCount(false);
+        if (track.getOuterCurvePoints().empty() || segments <= 0) return;
+
+        int removed[4] = { 0, 0, 0, 0 };
+        size_t kept = 0;
+        for (size_t i = 0; i < decorativeObjects.size(); ++i) {
+            const DecorativeObject& obj = decorativeObjects[i];
+            bool inSpan = ((obj.anchorSegment - firstSegment) % segments + segments) % segments < segmentCount;
+            if (inSpan || track.isPointInsideTrack(obj.position)) {
+                removed[(int)obj.type]++;
+            } else {
+                if (kept != i) decorativeObjects[kept] = std::move(decorativeObjects[i]);
+                kept++;
             }
-        };
-
-        placeObject(ObjectType::HOUSE, numHouses);
-        placeObject(ObjectType::PALM_TREE, numPalmTrees);
-        placeObject(ObjectType::ROCK, numRocks);
-        placeObject(ObjectType::BUSH, numBushes);
+        }
+        decorativeObjects.resize(kept);
+
+        int firstPoint, pointCount;
+        track.getSegmentPointSpan(false, firstSegment, segmentCount, firstPoint, pointCount);
+        srand(54321 + firstSegment);
+        DecorPlacementContext context = makePlacementContext(track);
+        const ObjectType types[4] = { ObjectType::HOUSE, ObjectType::PALM_TREE, ObjectType::ROCK, ObjectType::BUSH };
+        for (ObjectType type : types) {
+            placeDecorativeObjects(type, removed[(int)type], context, firstPoint, pointCount);
+        }
     }
 
-    // Desenha todos os objetos decorativos que foram gerados.
+    // Desenha os objetos decorativos visíveis.
     // Cada tipo de objeto tem sua própria lógica de desenho.
     // Utiliza transformações OpenGL (translate, rotate) para posicionar e orientar os objetos.
-    void drawDecorativeObjects(int sWidth, int sHeight) {
-        for (const auto& obj : decorativeObjects) {
+    void drawDecorativeObjects(const Camera& camera) {
+        collectVisible(decorHash, camera);
+        for (int index : visible) {
+            const DecorativeObject& obj = decorativeObjects[index];
             glPushMatrix();
             glTranslatef(obj.position.x, obj.position.y, 0);
             glRotatef(obj.rotation * 180.0f / PI, 0, 0, 1);
@@ -502,7 +623,7 @@ private:
             } else if (obj.type == ObjectType::ROCK) {
                 CV::color(obj.r1, obj.g1, obj.b1);
                 if (obj.rockVertices.size() >= 3) {
-                    std::vector<float> vx, vy;
+                    FrameVector<float> vx, vy;
                     vx.reserve(obj.rockVertices.size());
                     vy.reserve(obj.rockVertices.size());
                     for(const auto& p_local : obj.rockVertices) {
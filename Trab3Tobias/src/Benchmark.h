@@ -0,0 +1,132 @@
+// Este arquivo define o benchmark de estresse da simulação (modo headless).
+// Para cada configuração, o jogo é mantido com um número fixo de inimigos (dos quatro
+// níveis), projéteis (do jogador e estilhaços), explosões e um mínimo de partículas: antes
+// de cada tick o que foi destruído ou expirou é reposto em pontos aleatórios da pista,
+// fora da medição.
+// O tanque é controlado por entradas aleatórias e tem vida suficiente para não ser destruído.
+// Cada eixo (inimigos, projéteis, explosões, partículas) é variado separadamente a partir de uma
+// configuração base, e o resultado é o tempo médio por tick, total e por subsistema,
+// em microssegundos, e o número médio de alocações no heap por tick (deve ser zero
+// depois do aquecimento). Executado por "trab3 --bench".
+#ifndef ___BENCHMARK__H___
+#define ___BENCHMARK__H___
+
+#include <cstdio>
+#include <cstdlib>
+#include "Game.h"
+#include "HeadlessDriver.h"
+
+class Benchmark
+{
+    struct Config {
+        int enemies;
+        int projectiles;
+        int explosions;
+        int particles;
+    };
+
+    int screenWidth, screenHeight;
+    int warmupTicks, measuredTicks;
+
+    // Sorteia um ponto da pista a pelo menos margin pixels da borda.
+    Vector2 randomTrackPoint(const Track& track, float margin) const
+    {
+        Vector2 p;
+        for (int attempt = 0; attempt < 1000; ++attempt) {
+            p.set((float)(rand() % screenWidth), (float)(rand() % screenHeight));
+            if (track.signedDistance(p) > margin) break;
+        }
+        return p;
+    }
+
+    // Repõe inimigos, projéteis, explosões e partículas até as quantidades da configuração.
+    void topUp(Game& game, const Config& config) const
+    {
+        Tank* tank = game.getTank();
+        EnemyStore& enemies = game.getEnemies();
+        const Track& track = game.getTrack();
+
+        tank->health = 1e9f;
+        while (enemies.size() < config.enemies) {
+            enemies.spawn(randomTrackPoint(track, 20.0f), 1 + rand() % 4, game.getRandom());
+            // vida ampliada para que os projéteis não destruam todos os inimigos em um tick
+            // (o que encerraria o nível)
+            Enemy& enemy = enemies[enemies.size() - 1];
+            enemy.health *= 20;
+            enemy.initialHealth = enemy.health;
+        }
+        while (tank->projectiles.size() < config.projectiles) {
+            float angle = (rand() / (float)RAND_MAX) * 2.0f * M_PI;
+            ProjectileOwner owner = (rand() % 4 == 0) ? ProjectileOwner::ENEMY_SHRAPNEL : ProjectileOwner::PLAYER;
+            if (!tank->projectiles.spawn(randomTrackPoint(track, 5.0f), Vector2(cos(angle), sin(angle)), 300.0f,
+                                         5.0f, 10.0f, owner, 1.0f)) {
+                break;
+            }
+        }
+        while (tank->explosions.size() < config.explosions) {
+            tank->addExplosion(randomTrackPoint(track, 0.0f), 1.0f);
+        }
+        while (tank->particles.size() < config.particles) {
+            if (tank->particles.emitExplosion(randomTrackPoint(track, 0.0f), 1.0f) == 0) break;
+        }
+    }
+
+    void runConfig(const Config& config) const
+    {
+        srand(1234);
+        Game game(screenWidth, screenHeight);
+        game.getEnemies().clear();
+        HeadlessDriver driver(game);
+
+        for (int t = 0; t < warmupTicks + measuredTicks; ++t) {
+            if (t == warmupTicks) game.getProfile().reset();
+            topUp(game, config);
+            driver.step(HeadlessDriver::randomInput(screenWidth, screenHeight));
+        }
+
+        const TickProfile& p = game.getProfile();
+        printf("%8d %8d %8d %10d | %9.1f | %8.1f %8.1f %8.1f %8.1f %8.1f | %7.2f%s\n",
+               config.enemies, config.projectiles, config.explosions, game.getTank()->particles.size(),
+               p.perTick(p.total), p.perTick(p.enemyHash), p.perTick(p.tank),
+               p.perTick(p.projectiles), p.perTick(p.enemies), p.perTick(p.explosions),
+               p.perTick((double)p.allocations),
+               game.getCurrentGameState() == Game::GameState::PLAYING ? "" : " (fora do estado PLAYING)");
+    }
+
+public:
+    Benchmark(int screenWidth, int screenHeight, int warmupTicks = 30, int measuredTicks = 300)
+        : screenWidth(screenWidth), screenHeight(screenHeight), warmupTicks(warmupTicks), measuredTicks(measuredTicks) {}
+
+    void run() const
+    {
+        const Config base = { 200, 500, 50, 0 };
+        const int enemyCounts[] = { 100, 1000, 4000, 10000 };
+        const int projectileCounts[] = { 100, 2000, 10000, 30000 };
+        const int explosionCounts[] = { 10, 500, 2000 };
+        const int particleCounts[] = { 10000, 50000, 100000 };
+
+        printf("Benchmark headless: %d ticks medidos (+%d de aquecimento), dt fixo de 1/60 s\n", measuredTicks, warmupTicks);
+        printf("tempos medios por tick em microssegundos; alocs = alocacoes no heap por tick\n\n");
+        printf("%8s %8s %8s %10s | %9s | %8s %8s %8s %8s %8s | %7s\n",
+               "inimigos", "projeteis", "explosoes", "particulas", "total", "hash", "tanque", "projeteis", "inimigos", "explosoes", "alocs");
+
+        for (int n : enemyCounts) {
+            Config c = base; c.enemies = n;
+            runConfig(c);
+        }
+        for (int n : projectileCounts) {
+            Config c = base; c.projectiles = n;
+            runConfig(c);
+        }
+        for (int n : explosionCounts) {
+            Config c = base; c.explosions = n;
+            runConfig(c);
+        }
+        for (int n : particleCounts) {
+            Config c = base; c.particles = n;
+            runConfig(c);
+        }
+    }
+};
+
+#endif
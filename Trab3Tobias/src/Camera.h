@@ -0,0 +1,87 @@
+// Este arquivo define a classe Camera, a câmera 2D dos mundos maiores que a tela.
+// A câmera guarda a área visível do mundo (um retângulo do tamanho da tela) e a mantém
+// centrada no alvo (o tanque), sem mostrar nada fora do mundo; se o mundo for menor que
+// a tela em um eixo, ele fica centralizado nesse eixo. Com o mundo do tamanho da tela a
+// área visível é a própria tela e nada muda em relação ao desenho sem câmera.
+// - begin()/end(): desenho em coordenadas do mundo / da tela (interface), via CV::camera;
+// - screenToWorld: converte a posição do mouse (tela) para o mundo;
+// - isVisible: teste de uma caixa contra a área visível, para o recorte (culling) do desenho.
+// A posição da câmera faz parte da simulação (a mira do mouse depende dela), então é
+// atualizada nos ticks e não no desenho.
+#ifndef ___CAMERA__H___
+#define ___CAMERA__H___
+
+#include <algorithm>
+#include "gl_canvas2d.h"
+#include "Vector2.h"
+
+class Camera
+{
+    float worldWidth, worldHeight;
+    float viewWidth, viewHeight;
+    Vector2 origin; // canto inferior esquerdo da área visível, no mundo
+
+    static float clampAxis(float value, float view, float world)
+    {
+        if (world <= view) return (world - view) * 0.5f;
+        return std::max(0.0f, std::min(world - view, value));
+    }
+
+public:
+    Camera(float worldWidth = 0, float worldHeight = 0, float viewWidth = 0, float viewHeight = 0)
+        : worldWidth(worldWidth), worldHeight(worldHeight), viewWidth(viewWidth), viewHeight(viewHeight)
+    {
+        lookAt(Vector2(worldWidth * 0.5f, worldHeight * 0.5f));
+    }
+
+    // Centraliza a área visível em target, limitada ao mundo.
+    void lookAt(const Vector2& target)
+    {
+        origin.set(clampAxis(target.x - viewWidth * 0.5f, viewWidth, worldWidth),
+                   clampAxis(target.y - viewHeight * 0.5f, viewHeight, worldHeight));
+    }
+
+    // Desloca a área visível (limitada ao mundo).
+    void scroll(float dx, float dy)
+    {
+        origin.set(clampAxis(origin.x + dx, viewWidth, worldWidth), clampAxis(origin.y + dy, viewHeight, worldHeight));
+    }
+
+    // Cópia da câmera com a área visível em newOrigin, sem o limite do mundo (ex: os
+    // ladrilhos de uma captura maior que a tela, ver ScreenCache).
+    Camera movedTo(const Vector2& newOrigin) const
+    {
+        Camera moved(*this);
+        moved.origin = newOrigin;
+        return moved;
+    }
+
+    // Passa a desenhar em coordenadas do mundo.
+    void begin() const { CV::camera(origin.x, origin.y); }
+    // Volta a desenhar em coordenadas da tela.
+    static void end() { CV::camera(0, 0); }
+
+    // Converte uma posição da tela (mouse) para o mundo.
+    Vector2 screenToWorld(float x, float y) const { return Vector2(origin.x + x, origin.y + y); }
+
+    // Indica se a caixa dada (no mundo) cruza a área visível.
+    bool isVisible(float minX, float minY, float maxX, float maxY) const
+    {
+        return maxX >= getMinX() && minX <= getMaxX() && maxY >= getMinY() && minY <= getMaxY();
+    }
+
+    bool isVisible(const Vector2& center, float radius) const
+    {
+        return isVisible(center.x - radius, center.y - radius, center.x + radius, center.y + radius);
+    }
+
+    float getMinX() const { return origin.x; }
+    float getMinY() const { return origin.y; }
+    float getMaxX() const { return origin.x + viewWidth; }
+    float getMaxY() const { return origin.y + viewHeight; }
+    float getWorldWidth() const { return worldWidth; }
+    float getWorldHeight() const { return worldHeight; }
+    const Vector2& getOrigin() const { return origin; }
+};
+
+#endif
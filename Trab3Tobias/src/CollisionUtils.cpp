@@ -3,6 +3,8 @@
 // As implementações detalham como projetar formas em eixos,
 // como obter os eixos de um polígono e como verificar a sobreposição
 // dessas projeções para determinar colisões entre polígonos e círculos.
+// Os testes contínuos (sweepPointCircle e sweepCirclePolygon) calculam o tempo de impacto
+// de uma forma em movimento retilíneo, para que objetos rápidos não atravessem os alvos.
 #include "CollisionUtils.h"
 
 namespace CollisionUtils
@@ -50,40 +52,29 @@ namespace CollisionUtils
         return true;
     }
 
-    // Calcula e retorna os vetores normais a cada aresta de um polígono.
-    // Estes são os eixos potenciais de separação para o SAT.
-    std::vector<Vector2> getPolygonAxes(const std::vector<Vector2> &vertices)
-    {
-        std::vector<Vector2> axes;
-        if (vertices.size() < 2)
-        {
-            return axes;
-        }
-        for (size_t i = 0; i < vertices.size(); ++i)
-        {
-            Vector2 p1 = vertices[i];
-            Vector2 p2 = vertices[(i + 1) % vertices.size()]; 
-            Vector2 edge = p2 - p1;
-            Vector2 normal = edge.perpendicular().normalized(); 
-            axes.push_back(normal);
-        }
-        return axes;
-    }
-
     // Verifica se um polígono e um círculo colidem usando o Teorema do Eixo Separador.
     // Testa os eixos normais do polígono e o eixo do centro do círculo ao vértice mais próximo do polígono.
+    // Os eixos são calculados aresta a aresta, sem montar um vetor de eixos.
     bool checkPolygonCircleCollision(const std::vector<Vector2> &polygonVertices, const Vector2 &circleCenter, float circleRadius)
     {
         if (polygonVertices.empty())
             return false;
 
-        std::vector<Vector2> axes = getPolygonAxes(polygonVertices);
+        size_t n = polygonVertices.size();
+        for (size_t i = 0; n >= 2 && i < n; ++i)
+        {
+            Vector2 axis = (polygonVertices[(i + 1) % n] - polygonVertices[i]).perpendicular().normalized();
+            if (!doProjectionsOverlap(projectPolygon(axis, polygonVertices), projectCircle(axis, circleCenter, circleRadius)))
+            {
+                return false; 
+            }
+        }
 
         
         Vector2 closestVertex = polygonVertices[0];
         float minDistSq = (circleCenter - closestVertex).lengthSquared();
 
-        for (size_t i = 1; i < polygonVertices.size(); ++i)
+        for (size_t i = 1; i < n; ++i)
         {
             float distSq = (circleCenter - polygonVertices[i]).lengthSquared();
             if (distSq < minDistSq)
@@ -96,56 +87,208 @@ namespace CollisionUtils
         Vector2 circleToClosestVertexAxis = (closestVertex - circleCenter);
         if (circleToClosestVertexAxis.lengthSquared() > 0.0001f) 
         {
-            axes.push_back(circleToClosestVertexAxis.normalized());
-        } 
-
-        
-        for (const auto &axis : axes)
-        {
-            Projection polyProjection = projectPolygon(axis, polygonVertices);
-            Projection circleProjection = projectCircle(axis, circleCenter, circleRadius);
-
-            if (!doProjectionsOverlap(polyProjection, circleProjection))
+            Vector2 axis = circleToClosestVertexAxis.normalized();
+            if (!doProjectionsOverlap(projectPolygon(axis, polygonVertices), projectCircle(axis, circleCenter, circleRadius)))
             {
                 return false; 
             }
-        }
+        } 
 
         return true; 
     }
 
     // Verifica se dois polígonos colidem usando o Teorema do Eixo Separador.
-    // Testa os eixos normais de ambos os polígonos.
+    // Testa os eixos normais de ambos os polígonos. Para comparar projeções de polígonos
+    // o eixo não precisa ser normalizado, então a normal da aresta é usada diretamente.
     bool checkPolygonPolygonCollision(const std::vector<Vector2>& polygonAVertices, const std::vector<Vector2>& polygonBVertices)
     {
         if (polygonAVertices.empty() || polygonBVertices.empty())
             return false;
 
-        std::vector<Vector2> axesA = getPolygonAxes(polygonAVertices);
-        std::vector<Vector2> axesB = getPolygonAxes(polygonBVertices);
+        const std::vector<Vector2>* polygons[2] = { &polygonAVertices, &polygonBVertices };
+        for (int p = 0; p < 2; ++p)
+        {
+            const std::vector<Vector2>& vertices = *polygons[p];
+            size_t n = vertices.size();
+            for (size_t i = 0; n >= 2 && i < n; ++i)
+            {
+                Vector2 axis = (vertices[(i + 1) % n] - vertices[i]).perpendicular();
+                Projection pA = projectPolygon(axis, polygonAVertices);
+                Projection pB = projectPolygon(axis, polygonBVertices);
+                if (!doProjectionsOverlap(pA, pB))
+                {
+                    return false; 
+                }
+            }
+        }
 
-        
-        for (const auto& axis : axesA)
+        return true; 
+    }
+
+    // Projeta os vértices de um ConvexPolygon sobre um eixo.
+    Projection projectPolygon(const Vector2 &axis, const ConvexPolygon &polygon)
+    {
+        if (polygon.empty())
+        {
+            return {0, 0};
+        }
+        float min = axis.dot(polygon[0]);
+        float max = min;
+        for (size_t i = 1; i < polygon.size(); ++i)
+        {
+            float p = axis.dot(polygon[i]);
+            if (p < min) min = p;
+            else if (p > max) max = p;
+        }
+        return {min, max};
+    }
+
+    // Colisão polígono-círculo com ConvexPolygon: descarta pela AABB e usa os eixos em cache.
+    bool checkPolygonCircleCollision(const ConvexPolygon &polygon, const Vector2 &circleCenter, float circleRadius)
+    {
+        if (polygon.empty())
+            return false;
+        if (circleCenter.x + circleRadius < polygon.getMinX() || circleCenter.x - circleRadius > polygon.getMaxX() ||
+            circleCenter.y + circleRadius < polygon.getMinY() || circleCenter.y - circleRadius > polygon.getMaxY())
+            return false;
+
+        const Vector2* axes = polygon.getAxes();
+        for (size_t i = 0; i < polygon.size(); ++i)
         {
-            Projection pA = projectPolygon(axis, polygonAVertices);
-            Projection pB = projectPolygon(axis, polygonBVertices);
-            if (!doProjectionsOverlap(pA, pB))
+            if (!doProjectionsOverlap(projectPolygon(axes[i], polygon), projectCircle(axes[i], circleCenter, circleRadius)))
             {
-                return false; 
+                return false;
             }
         }
 
-        
-        for (const auto& axis : axesB)
+        Vector2 closestVertex = polygon[0];
+        float minDistSq = (circleCenter - closestVertex).lengthSquared();
+        for (size_t i = 1; i < polygon.size(); ++i)
+        {
+            float distSq = (circleCenter - polygon[i]).lengthSquared();
+            if (distSq < minDistSq)
+            {
+                minDistSq = distSq;
+                closestVertex = polygon[i];
+            }
+        }
+        Vector2 circleToClosestVertexAxis = (closestVertex - circleCenter);
+        if (minDistSq > 0.0001f)
         {
-            Projection pA = projectPolygon(axis, polygonAVertices);
-            Projection pB = projectPolygon(axis, polygonBVertices);
-            if (!doProjectionsOverlap(pA, pB))
+            Vector2 axis = circleToClosestVertexAxis * (1.0f / std::sqrt(minDistSq));
+            if (!doProjectionsOverlap(projectPolygon(axis, polygon), projectCircle(axis, circleCenter, circleRadius)))
             {
-                return false; 
+                return false;
             }
         }
+        return true;
+    }
 
-        return true; 
+    // Colisão polígono-polígono com ConvexPolygon: descarta pela AABB e usa os eixos em cache.
+    bool checkPolygonPolygonCollision(const ConvexPolygon &polygonA, const ConvexPolygon &polygonB)
+    {
+        if (polygonA.empty() || polygonB.empty() || !polygonA.boundsOverlap(polygonB))
+            return false;
+
+        const ConvexPolygon* polygons[2] = { &polygonA, &polygonB };
+        for (int p = 0; p < 2; ++p)
+        {
+            const Vector2* axes = polygons[p]->getAxes();
+            for (size_t i = 0; i < polygons[p]->size(); ++i)
+            {
+                if (!doProjectionsOverlap(projectPolygon(axes[i], polygonA), projectPolygon(axes[i], polygonB)))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Tempo de impacto de um ponto que vai de from até to contra o círculo (center, radius):
+    // menor raiz em [0, 1] de |from + d*t - center|^2 = radius^2.
+    bool sweepPointCircle(const Vector2 &from, const Vector2 &to, const Vector2 &center, float radius, float &t)
+    {
+        Vector2 m = from - center;
+        float c = m.lengthSquared() - radius * radius;
+        if (c <= 0.0f)
+        {
+            t = 0.0f;
+            return true;
+        }
+        Vector2 d = to - from;
+        float a = d.lengthSquared();
+        float b = m.dot(d);
+        if (a <= 0.0f || b >= 0.0f)
+            return false; // parado ou se afastando do círculo
+        float discriminant = b * b - a * c;
+        if (discriminant < 0.0f)
+            return false;
+        float s = (-b - std::sqrt(discriminant)) / a;
+        if (s > 1.0f)
+            return false;
+        t = std::max(0.0f, s);
+        return true;
+    }
+
+    // Tempo de impacto de um círculo que vai de from até to contra um polígono convexo.
+    // É o mesmo que um ponto contra o polígono "arredondado" (soma de Minkowski com o círculo):
+    // o primeiro contato é com uma aresta deslocada de radius para fora ou com o círculo de
+    // raio radius em um vértice.
+    bool sweepCirclePolygon(const ConvexPolygon &polygon, const Vector2 &from, const Vector2 &to, float radius, float &t)
+    {
+        if (polygon.empty())
+            return false;
+        float minX = std::min(from.x, to.x) - radius, maxX = std::max(from.x, to.x) + radius;
+        float minY = std::min(from.y, to.y) - radius, maxY = std::max(from.y, to.y) + radius;
+        if (maxX < polygon.getMinX() || minX > polygon.getMaxX() || maxY < polygon.getMinY() || minY > polygon.getMaxY())
+            return false;
+        if (checkPolygonCircleCollision(polygon, from, radius))
+        {
+            t = 0.0f;
+            return true;
+        }
+
+        Vector2 centroid(0, 0);
+        for (size_t i = 0; i < polygon.size(); ++i)
+        {
+            centroid = centroid + polygon[i];
+        }
+        centroid = centroid * (1.0f / (float)polygon.size());
+
+        Vector2 d = to - from;
+        const Vector2* axes = polygon.getAxes();
+        float best = 2.0f;
+        for (size_t i = 0; i < polygon.size(); ++i)
+        {
+            const Vector2 &p1 = polygon[i];
+            const Vector2 &p2 = polygon[i + 1 < polygon.size() ? i + 1 : 0];
+            Vector2 normal = axes[i];
+            if (normal.dot(p1 - centroid) < 0.0f)
+                normal = normal * -1.0f; // normal para fora do polígono
+
+            // aresta deslocada: só é atingida por quem se move contra a normal
+            float approach = normal.dot(d);
+            if (approach < 0.0f)
+            {
+                float s = (normal.dot(p1) + radius - normal.dot(from)) / approach;
+                if (s >= 0.0f && s < best)
+                {
+                    Vector2 edge = p2 - p1;
+                    float edgeLengthSquared = edge.lengthSquared();
+                    float u = (edgeLengthSquared > 0.0f) ? (from + d * s - p1).dot(edge) / edgeLengthSquared : 0.0f;
+                    if (u >= 0.0f && u <= 1.0f)
+                        best = s;
+                }
+            }
+
+            float s;
+            if (sweepPointCircle(from, to, p1, radius, s) && s < best)
+                best = s;
+        }
+        if (best > 1.0f)
+            return false;
+        t = best;
+        return true;
     }
-}
\ No newline at end of file
+}
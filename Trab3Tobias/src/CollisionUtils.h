@@ -2,6 +2,7 @@
 #define COLLISION_UTILS_H_INCLUDED
 
 #include "Vector2.h"
+#include "ConvexPolygon.h"
 #include <vector>
 #include <limits>    // Para std::numeric_limits
 #include <algorithm> // Para std::min/max
@@ -25,14 +26,24 @@ namespace CollisionUtils
     // Verifica se duas projeções (intervalos 1D) se sobrepõem
     bool doProjectionsOverlap(const Projection &p1, const Projection &p2);
 
-    // Obtém os eixos de projeção (normais às arestas) de um polígono
-    std::vector<Vector2> getPolygonAxes(const std::vector<Vector2> &vertices);
-
     // Verifica a colisão entre um polígono e um círculo usando o Teorema do Eixo Separador (SAT)
     bool checkPolygonCircleCollision(const std::vector<Vector2> &polygonVertices, const Vector2 &circleCenter, float circleRadius);
 
     // Verifica a colisão entre dois polígonos usando o Teorema do Eixo Separador (SAT)
     bool checkPolygonPolygonCollision(const std::vector<Vector2>& polygonAVertices, const std::vector<Vector2>& polygonBVertices);
+
+    // Versões para ConvexPolygon: usam os eixos em cache e testam as AABBs antes do SAT. Não alocam memória.
+    Projection projectPolygon(const Vector2 &axis, const ConvexPolygon &polygon);
+    bool checkPolygonCircleCollision(const ConvexPolygon &polygon, const Vector2 &circleCenter, float circleRadius);
+    bool checkPolygonPolygonCollision(const ConvexPolygon &polygonA, const ConvexPolygon &polygonB);
+
+    // Testes contínuos (swept): a forma se move em linha reta de from até to durante o passo.
+    // Retornam true se há contato durante o passo e preenchem t, a fração do passo (0 a 1)
+    // no instante do primeiro contato (tempo de impacto). t = 0 se já há contato em from.
+    // Ponto que se move contra um círculo parado.
+    bool sweepPointCircle(const Vector2 &from, const Vector2 &to, const Vector2 &center, float radius, float &t);
+    // Círculo de raio radius que se move contra um polígono convexo parado.
+    bool sweepCirclePolygon(const ConvexPolygon &polygon, const Vector2 &from, const Vector2 &to, float radius, float &t);
 } // namespace CollisionUtils
 
 #endif // COLLISION_UTILS_H_INCLUDED
\ No newline at end of file
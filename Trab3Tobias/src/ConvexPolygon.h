@@ -0,0 +1,129 @@
+// Este arquivo define a classe ConvexPolygon, um polígono convexo de capacidade fixa
+// usado como hitbox pelo tanque e pelos inimigos.
+// Os vértices ficam em um array interno (sem alocação dinâmica) e o polígono guarda:
+// - a caixa envolvente (AABB), atualizada junto com os vértices;
+// - os eixos de separação do SAT (normais normalizadas das arestas), recalculados
+//   apenas quando a forma muda. Uma translação desloca a AABB e mantém os eixos.
+//   O cálculo é preguiçoso (feito na primeira consulta), então um polígono que será lido
+//   por várias threads ao mesmo tempo deve ter os eixos preparados antes (prepareAxes).
+// A interface imita a de std::vector (size, operator[], push_back, begin/end) para
+// que o código de desenho continue percorrendo os vértices da mesma forma.
+#ifndef ___CONVEX_POLYGON__H___
+#define ___CONVEX_POLYGON__H___
+
+#include <cstddef>
+#include "Vector2.h"
+
+#define CONVEX_POLYGON_MAX_VERTICES 8
+
+class ConvexPolygon
+{
+    Vector2 points[CONVEX_POLYGON_MAX_VERTICES];
+    mutable Vector2 axes[CONVEX_POLYGON_MAX_VERTICES];
+    int count;
+    mutable bool axesValid;
+    float minX, minY, maxX, maxY;
+
+    void includeInBounds(const Vector2& p)
+    {
+        if (count == 0) {
+            minX = maxX = p.x;
+            minY = maxY = p.y;
+            return;
+        }
+        if (p.x < minX) minX = p.x;
+        if (p.x > maxX) maxX = p.x;
+        if (p.y < minY) minY = p.y;
+        if (p.y > maxY) maxY = p.y;
+    }
+
+    // Recalcula as normais das arestas (só quando a forma mudou).
+    void updateAxes() const
+    {
+        for (int i = 0; i < count; ++i) {
+            const Vector2& p1 = points[i];
+            const Vector2& p2 = points[i + 1 < count ? i + 1 : 0];
+            axes[i] = (p2 - p1).perpendicular().normalized();
+        }
+        axesValid = true;
+    }
+
+public:
+    ConvexPolygon() : count(0), axesValid(false), minX(0), minY(0), maxX(0), maxY(0) {}
+
+    void clear()
+    {
+        count = 0;
+        axesValid = false;
+    }
+
+    // Adiciona um vértice. Vértices além da capacidade são ignorados.
+    void push_back(const Vector2& p)
+    {
+        if (count >= CONVEX_POLYGON_MAX_VERTICES) return;
+        includeInBounds(p);
+        points[count++] = p;
+        axesValid = false;
+    }
+
+    // Desloca todos os vértices; eixos continuam válidos e a AABB é apenas deslocada.
+    void translate(float dx, float dy)
+    {
+        for (int i = 0; i < count; ++i) {
+            points[i].x += dx;
+            points[i].y += dy;
+        }
+        minX += dx; maxX += dx;
+        minY += dy; maxY += dy;
+    }
+
+    // Retorna uma cópia deslocada (na pilha, sem alocação).
+    ConvexPolygon translated(float dx, float dy) const
+    {
+        ConvexPolygon result = *this;
+        result.translate(dx, dy);
+        return result;
+    }
+
+    // Substitui os vértices pela forma local rotacionada (cosA, sinA) e posicionada em center.
+    void setTransformed(const Vector2* localPoints, int n, const Vector2& center, float cosA, float sinA)
+    {
+        clear();
+        for (int i = 0; i < n; ++i) {
+            const Vector2& lp = localPoints[i];
+            push_back(Vector2(center.x + lp.x * cosA - lp.y * sinA, center.y + lp.x * sinA + lp.y * cosA));
+        }
+    }
+
+    // Retorna os eixos de separação (count normais normalizadas).
+    const Vector2* getAxes() const
+    {
+        if (!axesValid) updateAxes();
+        return axes;
+    }
+
+    // Calcula os eixos agora, se a forma mudou desde o último cálculo.
+    void prepareAxes() const
+    {
+        if (!axesValid) updateAxes();
+    }
+
+    size_t size() const { return (size_t)count; }
+    bool empty() const { return count == 0; }
+    const Vector2& operator[](size_t i) const { return points[i]; }
+    const Vector2* begin() const { return points; }
+    const Vector2* end() const { return points + count; }
+
+    float getMinX() const { return minX; }
+    float getMinY() const { return minY; }
+    float getMaxX() const { return maxX; }
+    float getMaxY() const { return maxY; }
+
+    // Teste rápido de sobreposição das caixas envolventes.
+    bool boundsOverlap(const ConvexPolygon& other) const
+    {
+        return !(maxX < other.minX || other.maxX < minX || maxY < other.minY || other.maxY < minY);
+    }
+};
+
+#endif
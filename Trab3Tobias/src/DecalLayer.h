@@ -0,0 +1,279 @@
+// Este arquivo define a classe DecalLayer, a camada de marcas persistentes sobre a pista
+// (queimaduras das explosões e dos impactos, rastro das esteiras do tanque).
+// Cada marca é carimbada uma única vez numa imagem RGBA do mundo inteiro, guardada na CPU
+// com DECAL_LAYER_RESOLUTION texels por pixel do mundo; sem janela (modo headless) a
+// camada é só essa imagem. Com janela, a imagem é espelhada em texturas de blocos de
+// DECAL_LAYER_TILE_SIZE texels: um carimbo marca como sujo apenas o retângulo que alterou
+// em cada bloco, que é reenviado (glTexSubImage2D) no próximo desenho. Um quadro sem
+// marcas novas custa um retângulo texturizado por bloco visível já marcado, independente
+// de quantas marcas foram carimbadas.
+// O OpenGL 1.1 não tem framebuffers de textura, por isso as marcas são rasterizadas na
+// CPU (cada uma cobre poucas centenas de texels) em vez de desenhadas na textura.
+// As marcas só são carimbadas dentro da pista (campo de distância de Track). A camada é
+// apagada quando a pista muda (sync) e a cada troca de nível (clear).
+// Não faz parte da simulação: não usa o gerador do jogo nem entra em stateHash.
+// Carimbos podem vir das fases seriais de escrita executadas por outra thread (JobSystem),
+// nunca ao mesmo tempo que draw.
+#ifndef ___DECAL_LAYER__H___
+#define ___DECAL_LAYER__H___
+
+#include "gl_canvas2d.h"
+#include "Vector2.h"
+#include "Track.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#define DECAL_LAYER_RESOLUTION 0.5f // texels por pixel do mundo
+#define DECAL_LAYER_TILE_SIZE 126   // texels úteis por lado de um bloco (a textura tem uma borda de 1 texel)
+#define DECAL_SCORCH_RADIUS 18.0f   // raio da queimadura de uma explosão de escala 1, em pixels
+#define DECAL_SCORCH_OPACITY 0.6f
+#define DECAL_TREAD_RADIUS 3.0f     // raio de uma marca da esteira, em pixels
+#define DECAL_TREAD_OPACITY 0.2f
+
+class DecalLayer
+{
+    // Um bloco da imagem e a textura que o espelha. O retângulo sujo está em texels da
+    // imagem (dirtyMaxX < dirtyMinX = nada a enviar).
+    struct Tile
+    {
+        GLuint texture;
+        bool used;   // tem alguma marca desde o último clear
+        int dirtyMinX, dirtyMinY, dirtyMaxX, dirtyMaxY;
+    };
+
+    std::vector<unsigned char> pixels; // RGBA, sem pré-multiplicação; borda de 1 texel em volta do mundo
+    std::vector<Tile> tiles;
+    int width, height;   // texels da imagem, com a borda
+    int tilesX, tilesY;
+    int worldWidth, worldHeight;
+    const Track* track;  // pista que recorta as marcas
+    unsigned trackRevision;
+
+    static int textureSize() { return DECAL_LAYER_TILE_SIZE + 2; }
+
+    // Ruído em [0, 1) fixo por texel, para as bordas irregulares das queimaduras.
+    static float texelNoise(int x, int y)
+    {
+        unsigned h = (unsigned)x * 73856093u ^ (unsigned)y * 19349663u;
+        h ^= h >> 13;
+        h *= 0x5bd1e995u;
+        h ^= h >> 15;
+        return (h & 0xffff) / 65536.0f;
+    }
+
+    // Marca como sujo o retângulo de texels (x0, y0)-(x1, y1) em todos os blocos cuja
+    // textura (com a borda) o contém.
+    void markDirty(int x0, int y0, int x1, int y1)
+    {
+        int tx0 = std::max(0, (x0 - 2) / DECAL_LAYER_TILE_SIZE), tx1 = std::min(tilesX - 1, x1 / DECAL_LAYER_TILE_SIZE);
+        int ty0 = std::max(0, (y0 - 2) / DECAL_LAYER_TILE_SIZE), ty1 = std::min(tilesY - 1, y1 / DECAL_LAYER_TILE_SIZE);
+        for (int ty = ty0; ty <= ty1; ++ty) {
+            for (int tx = tx0; tx <= tx1; ++tx) {
+                Tile& tile = tiles[ty * tilesX + tx];
+                tile.used = true;
+                tile.dirtyMinX = std::min(tile.dirtyMinX, x0);
+                tile.dirtyMinY = std::min(tile.dirtyMinY, y0);
+                tile.dirtyMaxX = std::max(tile.dirtyMaxX, x1);
+                tile.dirtyMaxY = std::max(tile.dirtyMaxY, y1);
+            }
+        }
+    }
+
+    // Envia para a textura do bloco a parte suja (recortada à textura), criando-a se preciso.
+    void upload(Tile& tile, int tx, int ty)
+    {
+        int size = textureSize();
+        int originX = tx * DECAL_LAYER_TILE_SIZE, originY = ty * DECAL_LAYER_TILE_SIZE;
+        if (!tile.texture) {
+            glGenTextures(1, &tile.texture);
+            glBindTexture(GL_TEXTURE_2D, tile.texture);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+            // textura nova: o conteúdo é indefinido, envia o bloco inteiro
+            tile.dirtyMinX = originX;
+            tile.dirtyMinY = originY;
+            tile.dirtyMaxX = originX + size - 1;
+            tile.dirtyMaxY = originY + size - 1;
+        } else {
+            glBindTexture(GL_TEXTURE_2D, tile.texture);
+        }
+        int x0 = std::max(tile.dirtyMinX, originX), x1 = std::min(tile.dirtyMaxX, originX + size - 1);
+        int y0 = std::max(tile.dirtyMinY, originY), y1 = std::min(tile.dirtyMaxY, originY + size - 1);
+        if (x0 <= x1 && y0 <= y1) {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+            glPixelStorei(GL_UNPACK_SKIP_PIXELS, x0);
+            glPixelStorei(GL_UNPACK_SKIP_ROWS, y0);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, x0 - originX, y0 - originY, x1 - x0 + 1, y1 - y0 + 1,
+                            GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]);
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+            glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+            glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+        }
+        tile.dirtyMinX = tile.dirtyMinY = 1 << 30;
+        tile.dirtyMaxX = tile.dirtyMaxY = -1;
+    }
+
+public:
+    DecalLayer() : width(0), height(0), tilesX(0), tilesY(0), worldWidth(0), worldHeight(0),
+                   track(nullptr), trackRevision(0) {}
+
+    ~DecalLayer()
+    {
+        for (Tile& tile : tiles) {
+            if (tile.texture) glDeleteTextures(1, &tile.texture);
+        }
+    }
+
+    DecalLayer(const DecalLayer&) = delete;
+    DecalLayer& operator=(const DecalLayer&) = delete;
+
+    // Acompanha a pista: na primeira chamada aloca a imagem do tamanho do mundo; depois,
+    // se a pista mudou (revisão ou tamanho do mundo), apaga as marcas.
+    void sync(const Track& currentTrack)
+    {
+        track = &currentTrack;
+        if (currentTrack.getWorldWidth() != worldWidth || currentTrack.getWorldHeight() != worldHeight) {
+            for (Tile& tile : tiles) {
+                if (tile.texture) glDeleteTextures(1, &tile.texture);
+            }
+            worldWidth = currentTrack.getWorldWidth();
+            worldHeight = currentTrack.getWorldHeight();
+            int innerW = std::max(1, (int)ceil(worldWidth * DECAL_LAYER_RESOLUTION));
+            int innerH = std::max(1, (int)ceil(worldHeight * DECAL_LAYER_RESOLUTION));
+            tilesX = (innerW + DECAL_LAYER_TILE_SIZE - 1) / DECAL_LAYER_TILE_SIZE;
+            tilesY = (innerH + DECAL_LAYER_TILE_SIZE - 1) / DECAL_LAYER_TILE_SIZE;
+            width = tilesX * DECAL_LAYER_TILE_SIZE + 2;
+            height = tilesY * DECAL_LAYER_TILE_SIZE + 2;
+            pixels.assign((size_t)width * height * 4, 0);
+            tiles.assign(tilesX * tilesY, Tile());
+            trackRevision = currentTrack.getRevision();
+            clear();
+        } else if (currentTrack.getRevision() != trackRevision) {
+            trackRevision = currentTrack.getRevision();
+            clear();
+        }
+    }
+
+    // Apaga todas as marcas. As texturas são mantidas e reenviadas inteiras quando o
+    // bloco voltar a ser marcado.
+    void clear()
+    {
+        std::fill(pixels.begin(), pixels.end(), 0);
+        for (int ty = 0; ty < tilesY; ++ty) {
+            for (int tx = 0; tx < tilesX; ++tx) {
+                Tile& tile = tiles[ty * tilesX + tx];
+                tile.used = false;
+                tile.dirtyMinX = tx * DECAL_LAYER_TILE_SIZE;
+                tile.dirtyMinY = ty * DECAL_LAYER_TILE_SIZE;
+                tile.dirtyMaxX = tile.dirtyMinX + textureSize() - 1;
+                tile.dirtyMaxY = tile.dirtyMinY + textureSize() - 1;
+            }
+        }
+    }
+
+    // Carimba um disco de cor (r, g, b) centrado em center: a opacidade cai do centro até
+    // a borda (radius, em pixels do mundo); irregularity (0 a 1) mistura ruído na opacidade.
+    // Compõe sobre as marcas existentes (operador "over"), só nos texels dentro da pista.
+    void stamp(const Vector2& center, float radius, unsigned char r, unsigned char g, unsigned char b,
+               float opacity, float irregularity = 0.0f)
+    {
+        if (pixels.empty() || radius <= 0.0f || opacity <= 0.0f) return;
+        float texelRadius = radius * DECAL_LAYER_RESOLUTION;
+        // o texel (x, y) da imagem tem o centro em ((x - 0.5), (y - 0.5)) / DECAL_LAYER_RESOLUTION no mundo
+        float cx = center.x * DECAL_LAYER_RESOLUTION + 1.0f, cy = center.y * DECAL_LAYER_RESOLUTION + 1.0f;
+        int x0 = std::max(1, (int)floor(cx - texelRadius)), x1 = std::min(width - 2, (int)ceil(cx + texelRadius));
+        int y0 = std::max(1, (int)floor(cy - texelRadius)), y1 = std::min(height - 2, (int)ceil(cy + texelRadius));
+        if (x0 > x1 || y0 > y1) return;
+
+        float inverseRadius2 = 1.0f / (texelRadius * texelRadius);
+        bool touched = false;
+        for (int y = y0; y <= y1; ++y) {
+            float dy = y + 0.5f - cy;
+            unsigned char* row = &pixels[((size_t)y * width) * 4];
+            for (int x = x0; x <= x1; ++x) {
+                float dx = x + 0.5f - cx;
+                float d2 = (dx * dx + dy * dy) * inverseRadius2;
+                if (d2 >= 1.0f) continue;
+                if (track) {
+                    Vector2 world((x - 0.5f) / DECAL_LAYER_RESOLUTION, (y - 0.5f) / DECAL_LAYER_RESOLUTION);
+                    if (track->signedDistance(world) <= 0.0f) continue;
+                }
+                float a = opacity * (1.0f - d2);
+                if (irregularity > 0.0f) a *= 1.0f - irregularity * texelNoise(x, y);
+
+                unsigned char* texel = row + x * 4;
+                float dstA = texel[3] / 255.0f;
+                float outA = a + dstA * (1.0f - a);
+                float keep = dstA * (1.0f - a) / outA;
+                texel[0] = (unsigned char)(r * (a / outA) + texel[0] * keep + 0.5f);
+                texel[1] = (unsigned char)(g * (a / outA) + texel[1] * keep + 0.5f);
+                texel[2] = (unsigned char)(b * (a / outA) + texel[2] * keep + 0.5f);
+                texel[3] = (unsigned char)(outA * 255.0f + 0.5f);
+                touched = true;
+            }
+        }
+        if (touched) markDirty(x0, y0, x1, y1);
+    }
+
+    // Queimadura de uma explosão (ou impacto de projétil) de escala scale.
+    void stampScorch(const Vector2& position, float scale)
+    {
+        stamp(position, DECAL_SCORCH_RADIUS * scale, 28, 22, 16, DECAL_SCORCH_OPACITY, 0.35f);
+    }
+
+    // Marca de uma esteira do tanque; as marcas seguidas se sobrepõem e escurecem aos poucos.
+    void stampTread(const Vector2& position)
+    {
+        stamp(position, DECAL_TREAD_RADIUS, 18, 16, 14, DECAL_TREAD_OPACITY);
+    }
+
+    // Desenha os blocos marcados que cruzam a área visível (minX, minY)-(maxX, maxY),
+    // enviando antes a parte alterada de cada um. Precisa de um contexto OpenGL.
+    void draw(float minX, float minY, float maxX, float maxY)
+    {
+        if (tiles.empty()) return;
+        float tileWorld = DECAL_LAYER_TILE_SIZE / DECAL_LAYER_RESOLUTION;
+        int tx0 = std::max(0, (int)floor(minX / tileWorld)), tx1 = std::min(tilesX - 1, (int)floor(maxX / tileWorld));
+        int ty0 = std::max(0, (int)floor(minY / tileWorld)), ty1 = std::min(tilesY - 1, (int)floor(maxY / tileWorld));
+        // só o interior de cada textura é desenhado; a borda serve à filtragem entre blocos
+        float s0 = 1.0f / textureSize(), s1 = (DECAL_LAYER_TILE_SIZE + 1.0f) / textureSize();
+
+        glEnable(GL_TEXTURE_2D);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+        glColor4f(1, 1, 1, 1);
+        for (int ty = ty0; ty <= ty1; ++ty) {
+            for (int tx = tx0; tx <= tx1; ++tx) {
+                Tile& tile = tiles[ty * tilesX + tx];
+                if (!tile.used) continue;
+                upload(tile, tx, ty);
+                float x0 = tx * tileWorld, x1 = x0 + tileWorld;
+                float y0 = ty * tileWorld, y1 = y0 + tileWorld; // linha 0 da imagem = menor y do mundo
+                glBegin(GL_QUADS);
+                    glTexCoord2f(s0, s0); glVertex2f(x0, y0);
+                    glTexCoord2f(s1, s0); glVertex2f(x1, y0);
+                    glTexCoord2f(s1, s1); glVertex2f(x1, y1);
+                    glTexCoord2f(s0, s1); glVertex2f(x0, y1);
+                glEnd();
+            }
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDisable(GL_BLEND);
+        glDisable(GL_TEXTURE_2D);
+    }
+
+    // Imagem RGBA da camada (modo headless ou testes): getWidth x getHeight texels, com
+    // uma borda de 1 texel; o texel (x, y) cobre o mundo a partir de
+    // ((x - 1) / DECAL_LAYER_RESOLUTION, (y - 1) / DECAL_LAYER_RESOLUTION).
+    const unsigned char* getPixels() const { return pixels.empty() ? nullptr : &pixels[0]; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+};
+
+#endif
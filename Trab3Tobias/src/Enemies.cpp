@@ -1,17 +1,26 @@
-// Este arquivo implementa os métodos da classe Enemy.
+// Este arquivo implementa os métodos da classe Enemy e dos componentes de tipo
+// (StarComponent e PlaneComponent).
 // Contém a lógica detalhada para o comportamento de cada tipo de inimigo,
 // incluindo movimento, colisões, ataques (bombas, estilhaços) e renderização.
 // As principais funcionalidades implementadas aqui são:
-// - updateActivatedStar: Lógica de movimento e colisão para a estrela Nível 2.
+// - StarComponent::computeStep e applyStep: Lógica de perseguição, movimento e colisão para a estrela Nível 2,
+//   separada em uma fase de leitura (paralela) e uma de escrita.
+// - EnemyStore::prepareHitboxes: prepara as hitboxes lidas nas fases paralelas.
 // - updateHealthBarDisplay e drawHealthBar: Gerenciamento e desenho da barra de vida.
-// - draw: Renderização visual dos diferentes tipos de inimigos.
+// - draw: Renderização visual de cada tipo de inimigo (sprite do atlas, ou a forma
+//   procedural drawShape quando o atlas não está disponível).
 // - generateShrapnel: Criação de projéteis de estilhaços para o inimigo Nível 3.
-// - initializeFlightPath, updatePlaneSpecifics, dropBomb, drawPlaneVisuals:
+// - PlaneComponent::initializeFlightPath, update, applyDetonations, dropBomb, draw:
 //   Lógica completa para o inimigo avião Nível 4 (movimento, ataque, renderização).
+//   A trajetória do avião é amostrada por distância ao longo da curva central da pista.
 #include "Enemies.h"
+#include "EnemyStore.h"
 #include "Tank.h"       
 #include "Track.h"      
+#include "FlowField.h"
 #include "CollisionUtils.h" 
+#include "FrameArena.h"
+#include "Sprites.h"
 #include <cmath>        
 #include <cstdlib>      
 
@@ -19,122 +28,6 @@
 #define M_PI 3.14159265358979323846
 #endif
 
-// Atualiza o estado da estrela ativada (Nível 2), incluindo rotação, movimento e colisões.
-void Enemy::updateActivatedStar(float fps, const Track& track, std::vector<Enemy>& allEnemies, Tank* playerTank) {
-    if (level != 2 || starMode != StarActivationState::ACTIVATED) {
-        return;
-    }
-
-    
-    currentRotationAngle += rotationSpeed * (1.0f / fps);
-    while (currentRotationAngle >= 2.0f * M_PI) currentRotationAngle -= 2.0f * M_PI;
-    while (currentRotationAngle < 0.0f) currentRotationAngle += 2.0f * M_PI;
-
-    
-    Vector2 deltaMove = movementDirection * movementSpeed * (1.0f / fps);
-    
-    
-    updateDynamicHitboxVertices();
-
-    
-    if (playerTank && !playerTank->shield.isEffectActive() && CollisionUtils::checkPolygonPolygonCollision(this->vertices, playerTank->vertices)) {
-        playerTank->takeDamage(5.0f);
-        starMode = StarActivationState::DESTROYED_AFTER_ACTIVATION;
-        playerTank->addExplosion(this->position, this->size / 10.0f); 
-        return; 
-    }
-
-    
-    Vector2 proposedPosition = position + deltaMove;
-    std::vector<Vector2> projectedVertices; 
-    float cosA = cos(currentRotationAngle);
-    float sinA = sin(currentRotationAngle);
-    if (!localStarShapeVertices.empty()){ 
-        for(const auto& localP : localStarShapeVertices) {
-            float rX = localP.x * cosA - localP.y * sinA;
-            float rY = localP.x * sinA + localP.y * cosA;
-            projectedVertices.push_back(Vector2(proposedPosition.x + rX, proposedPosition.y + rY));
-        }
-    }
-    
-    bool reflectedX = false;
-    
-
-    
-    Vector2 posAfterXOnly = position + Vector2(deltaMove.x, 0);
-    std::vector<Vector2> verticesAfterXOnly;
-    if (!localStarShapeVertices.empty()){
-        for(const auto& localP : localStarShapeVertices) {
-            float rX = localP.x * cosA - localP.y * sinA;
-            float rY = localP.x * sinA + localP.y * cosA;
-            verticesAfterXOnly.push_back(Vector2(posAfterXOnly.x + rX, position.y + rY));
-        }
-    }
-    for(const auto& v : verticesAfterXOnly) {
-        if(!track.isPointInsideTrack(v)) {
-            movementDirection.x *= -1.0f;
-            reflectedX = true;
-            break;
-        }
-    }
-    
-    
-    
-    float currentDeltaX = reflectedX ? movementDirection.x * movementSpeed * (1.0f/fps) : deltaMove.x;
-    
-    std::vector<Vector2> verticesAfterYOnly;
-    if(!localStarShapeVertices.empty()){
-        for(const auto& localP : localStarShapeVertices) {
-            float rX = localP.x * cosA - localP.y * sinA;
-            float rY = localP.x * sinA + localP.y * cosA;
-            verticesAfterYOnly.push_back(Vector2(position.x + rX + currentDeltaX, 
-                                                position.y + rY + deltaMove.y));
-        }
-    }
-    for(const auto& v : verticesAfterYOnly) {
-        if(!track.isPointInsideTrack(v)) {
-            movementDirection.y *= -1.0f;
-            
-            break;
-        }
-    }
-
-    
-    deltaMove = movementDirection * movementSpeed * (1.0f / fps);
-    
-    
-    proposedPosition = position + deltaMove;
-    projectedVertices.clear();
-    if(!localStarShapeVertices.empty()){
-        for(const auto& localP : localStarShapeVertices) {
-            float rX = localP.x * cosA - localP.y * sinA;
-            float rY = localP.x * sinA + localP.y * cosA;
-            projectedVertices.push_back(Vector2(proposedPosition.x + rX, proposedPosition.y + rY));
-        }
-    }
-
-    for (auto& otherEnemy : allEnemies) {
-        if (&otherEnemy == this || otherEnemy.isDestroyed()) continue;
-        
-        if (!projectedVertices.empty() && !otherEnemy.vertices.empty() && CollisionUtils::checkPolygonPolygonCollision(projectedVertices, otherEnemy.vertices)) {
-            Vector2 normal = (otherEnemy.position - this->position).normalizedSafe();
-            if (normal.lengthSquared() > 0.0001f) { 
-                this->movementDirection = this->movementDirection.reflect(normal);
-
-                if (otherEnemy.level == 2 && otherEnemy.starMode == StarActivationState::ACTIVATED) {
-                    otherEnemy.movementDirection = otherEnemy.movementDirection.reflect(normal * -1.0f);
-                }
-            }
-            deltaMove = movementDirection * movementSpeed * (1.0f / fps); 
-            break; 
-        }
-    }
-    
-    
-    position = position + deltaMove; 
-    updateDynamicHitboxVertices(); 
-}
-
 // Atualiza o temporizador de visibilidade da barra de vida do inimigo.
 void Enemy::updateHealthBarDisplay(float fps) {
     if (healthBarVisibleTimer > 0.0f) {
@@ -145,21 +38,13 @@ void Enemy::updateHealthBarDisplay(float fps) {
     }
 }
 
-// Desenha a barra de vida do inimigo, se visível.
-void Enemy::drawHealthBar() const {
+// Desenha a barra de vida do inimigo, se visível, a yOffset abaixo de anchorY.
+void Enemy::drawHealthBar(float anchorY, float yOffset) const {
     if (healthBarVisibleTimer > 0.0f && initialHealth > 1 && health > 0 && !isDestroyed()) {
         float barWidth = size * 1.2f; 
         float barHeight = 4.0f;      
-        
-        
-        float yOffset = size * 0.8f + 3.0f; 
-        if (level == 4) yOffset = size * 0.5f + 8.0f; 
-
-        Vector2 barPosition(position.x - barWidth / 2.0f, planeCurrentDisplayPosition.y + yOffset);
-        if(level != 4) { 
-             barPosition.set(position.x - barWidth / 2.0f, position.y + yOffset);
-        }
 
+        Vector2 barPosition(position.x - barWidth / 2.0f, anchorY + yOffset);
 
         
         CV::color(0.25f, 0.25f, 0.25f); 
@@ -181,10 +66,9 @@ void Enemy::drawHealthBar() const {
     }
 }
 
-// Desenha o inimigo na tela com base em seu nível e estado.
-void Enemy::draw()
+// Desenha a forma de um inimigo estático (Nível 1 ou 3) do tamanho dado, centrada em position.
+void Enemy::drawShape(int level, const Vector2& position, float size)
 {
-    
     if (level == 1) 
     {
         CV::color(0.9, 0.1, 0.1); 
@@ -200,73 +84,22 @@ void Enemy::draw()
         Vector2 ip3(position.x + size * innerScale * cos(M_PI / 6.0f), position.y + size * innerScale * sin(M_PI / 6.0f));
         CV::triangleFill(ip1, ip2, ip3);
     }
-    else if (level == 2) 
-    {
-        CV::color(0.9, 0.9, 0.1); 
-
-        
-        
-        
-        
-        
-
-        if (!localStarShapeVertices.empty()) {
-            
-            
-            std::vector<Vector2> worldStarPoints;
-            float cosA = cos(currentRotationAngle); 
-            float sinA = sin(currentRotationAngle);
-
-            for (const auto& localP : localStarShapeVertices) {
-                float rotatedX = localP.x * cosA - localP.y * sinA;
-                float rotatedY = localP.x * sinA + localP.y * cosA;
-                worldStarPoints.push_back(Vector2(position.x + rotatedX, position.y + rotatedY));
-            }
-
-            
-            
-            if (!worldStarPoints.empty()) { 
-                for (size_t i = 0; i < worldStarPoints.size(); ++i)
-                {
-                    Vector2 p1_star = worldStarPoints[i];
-                    Vector2 p2_star = worldStarPoints[(i + 1) % worldStarPoints.size()];
-                    CV::triangleFill(this->position, p1_star, p2_star);
-                }
-            }
-        } else {
-            
-            
-            if (!this->vertices.empty()) {
-                 std::vector<float> vxs, vys;
-                 for(const auto& v_world : this->vertices) { 
-                     vxs.push_back(v_world.x);
-                     vys.push_back(v_world.y);
-                 }
-                 CV::polygonFill(vxs.data(), vys.data(), vxs.size());
-            }
-        }
-
-        CV::color(0.6, 0.6, 0.05); 
-        CV::circleFill(position.x, position.y, size * 0.15f, 12); 
-    }
     else if (level == 3) 
     {
         CV::color(0.1, 0.8, 0.1); 
         int numSides = 8; 
         float bodyRadius = size * 0.8f;
-        std::vector<Vector2> bodyPointsVec; 
+        // vértices temporários do quadro, na FrameArena
+        FrameVector<float> bodyVx, bodyVy;
+        bodyVx.reserve(numSides);
+        bodyVy.reserve(numSides);
         for (int i = 0; i < numSides; ++i)
         {
             float angle = (2.0f * M_PI / numSides) * i + (M_PI / numSides); 
-            bodyPointsVec.push_back(Vector2(position.x + bodyRadius * cos(angle),
-                                         position.y + bodyRadius * sin(angle)));
+            bodyVx.push_back(position.x + bodyRadius * cos(angle));
+            bodyVy.push_back(position.y + bodyRadius * sin(angle));
         }
-        std::vector<float> bodyVx, bodyVy;
-        for(const auto& p : bodyPointsVec) {
-            bodyVx.push_back(p.x);
-            bodyVy.push_back(p.y);
-        }
-        CV::polygonFill(bodyVx.data(), bodyVy.data(), bodyPointsVec.size()); 
+        CV::polygonFill(bodyVx.data(), bodyVy.data(), numSides); 
 
         CV::color(0.05, 0.6, 0.05); 
         int numTeeth = 8;
@@ -287,13 +120,9 @@ void Enemy::draw()
             Vector2 p4_tooth(position.x + toothInnerRadius * cos(baseAngle + toothWidthAngle / 2.0f),
                        position.y + toothInnerRadius * sin(baseAngle + toothWidthAngle / 2.0f));
             
-            std::vector<Vector2> toothShapeVec = {p1_tooth, p2_tooth, p3_tooth, p4_tooth}; 
-            std::vector<float> toothVx, toothVy;
-            for(const auto& p : toothShapeVec) {
-                toothVx.push_back(p.x);
-                toothVy.push_back(p.y);
-            }
-            CV::polygonFill(toothVx.data(), toothVy.data(), toothShapeVec.size()); 
+            float toothVx[4] = { p1_tooth.x, p2_tooth.x, p3_tooth.x, p4_tooth.x };
+            float toothVy[4] = { p1_tooth.y, p2_tooth.y, p3_tooth.y, p4_tooth.y };
+            CV::polygonFill(toothVx, toothVy, 4); 
         }
 
         CV::color(0.5, 0.5, 0.5); 
@@ -301,23 +130,195 @@ void Enemy::draw()
         CV::color(0.3, 0.3, 0.3); 
         CV::circle(position.x, position.y, size * 0.3f, 16);
     }
-    else if (level == 4) { 
-        drawPlaneVisuals();
-        for (const auto& bomb : activeBombs) {
-            bomb.draw();
+}
+
+// Desenha os inimigos estáticos (Níveis 1 e 3) com base em seu nível: o sprite do atlas
+// ou, sem o atlas, a forma procedural.
+void Enemy::draw() const
+{
+    const SpriteAtlas& atlas = SpriteAtlas::shared();
+    if (atlas.isReady() && (level == 1 || level == 3)) {
+        atlas.draw(level == 1 ? SPRITE_ENEMY_TRIANGLE : SPRITE_ENEMY_GEAR, position, 0.0f, size / getSizeForLevel(level));
+    } else {
+        drawShape(level, position, size);
+    }
+
+    drawHealthBar(position.y, size * 0.8f + 3.0f);
+}
+
+// Prepara os eixos das hitboxes dos inimigos e do tanque antes das fases paralelas do update.
+void EnemyStore::prepareHitboxes(const Tank* playerTank) {
+    for (const auto& enemy : enemies) {
+        enemy.vertices.prepareAxes();
+    }
+    if (playerTank) playerTank->vertices.prepareAxes();
+}
+
+// Sorteia a direção inicial da estrela (Nível 2) no primeiro quadro após a ativação.
+void StarComponent::launch(Random& rng) {
+    if (launched) return;
+    float angle = rng.nextFloat() * 2.0f * M_PI;
+    movementDirection.set(cos(angle), sin(angle));
+    launched = true;
+}
+
+// Calcula o quadro da estrela ativada (Nível 2): rotação, movimento e colisões.
+// Só lê o estado dos inimigos e do tanque; o resultado é aplicado em applyStep.
+void StarComponent::computeStep(const Enemy& self, float fps, const Track& track, const FlowField& flowField,
+                                const EnemyStore& store, const SpatialHash& enemyHash, const Tank* playerTank, Step& step) const {
+    step = Step();
+    if (self.starMode != Enemy::StarActivationState::ACTIVATED) {
+        return;
+    }
+    step.active = true;
+    step.position = self.position;
+    step.direction = movementDirection;
+
+    step.rotation = currentRotationAngle + rotationSpeed * (1.0f / fps);
+    while (step.rotation >= 2.0f * M_PI) step.rotation -= 2.0f * M_PI;
+    while (step.rotation < 0.0f) step.rotation += 2.0f * M_PI;
+
+    // persegue o tanque: a direção vira aos poucos para a do campo de fluxo (as reflexões
+    // nas bordas e nos inimigos continuam valendo)
+    Vector2 chase = flowField.direction(step.position);
+    if (chase.lengthSquared() > 0.0f) {
+        Vector2 steered = (step.direction + chase * (STAR_CHASE_STEERING / fps)).normalizedSafe();
+        if (steered.lengthSquared() > 0.0f) step.direction = steered;
+    }
+
+    float cosA = cos(step.rotation);
+    float sinA = sin(step.rotation);
+    Vector2 deltaMove = step.direction * self.movementSpeed * (1.0f / fps);
+    
+    
+    step.hitbox.setTransformed(localStarShapeVertices, STAR_SHAPE_VERTICES, step.position, cosA, sinA);
+
+    
+    if (playerTank && !playerTank->shield.isEffectActive() && CollisionUtils::checkPolygonPolygonCollision(step.hitbox, playerTank->vertices)) {
+        step.hitTank = true;
+        return; 
+    }
+
+    
+    Vector2 proposedPosition = step.position + deltaMove;
+    ConvexPolygon projectedVertices; 
+    projectedVertices.setTransformed(localStarShapeVertices, STAR_SHAPE_VERTICES, proposedPosition, cosA, sinA);
+    
+    // Colisão com a borda pelo campo de distância da pista: o vértice mais profundo
+    // define a normal; a direção é refletida se estiver entrando na borda e a
+    // penetração é desfeita ao longo da normal.
+    float deepest = 0.0f;
+    Vector2 wallNormal;
+    for(const auto& v : projectedVertices) {
+        Vector2 n;
+        float d = track.signedDistance(v, n);
+        if (d < deepest) {
+            deepest = d;
+            wallNormal = n;
+        }
+    }
+    if (deepest < 0.0f && wallNormal.lengthSquared() > 0.0001f) {
+        if (step.direction.dot(wallNormal) < 0.0f) {
+            step.direction = step.direction.reflect(wallNormal);
         }
+        step.position = step.position + wallNormal * (-deepest);
     }
 
+    deltaMove = step.direction * self.movementSpeed * (1.0f / fps);
     
-    drawHealthBar();
+    
+    // mesma rotação: basta deslocar a hitbox projetada (os eixos em cache continuam válidos)
+    Vector2 newProposedPosition = step.position + deltaMove;
+    projectedVertices.translate(newProposedPosition.x - proposedPosition.x, newProposedPosition.y - proposedPosition.y);
+    proposedPosition = newProposedPosition;
+
+    // Só os inimigos próximos (SpatialHash) passam pelo teste SAT.
+    enemyHash.query(projectedVertices, 0.0f, [&](int handle) {
+        const Enemy& otherEnemy = store[handle];
+        if (&otherEnemy == &self || otherEnemy.isDestroyed()) return true;
+        
+        if (!otherEnemy.vertices.empty() && CollisionUtils::checkPolygonPolygonCollision(projectedVertices, otherEnemy.vertices)) {
+            Vector2 normal = (otherEnemy.position - step.position).normalizedSafe();
+            if (normal.lengthSquared() > 0.0001f) { 
+                step.direction = step.direction.reflect(normal);
+
+                if (otherEnemy.level == 2 && otherEnemy.starMode == Enemy::StarActivationState::ACTIVATED) {
+                    step.reflectedEnemy = handle;
+                    step.reflectNormal = normal * -1.0f;
+                }
+            }
+            step.bounced = true;
+            deltaMove = step.direction * self.movementSpeed * (1.0f / fps); 
+            return false; 
+        }
+        return true;
+    });
+    
+    
+    step.position = step.position + deltaMove; 
+    step.hitbox.setTransformed(localStarShapeVertices, STAR_SHAPE_VERTICES, step.position, cosA, sinA);
+}
+
+// Aplica o quadro calculado por computeStep. Se a estrela atingiu o tanque, causa o dano
+// e a explosão e a estrela é destruída. A reflexão da estrela atingida é aplicada pelo
+// EnemyStore depois que todas as estrelas aplicaram seus quadros.
+void StarComponent::applyStep(Enemy& self, const Step& step, Tank* playerTank) {
+    if (!step.active) return;
+
+    currentRotationAngle = step.rotation;
+    movementDirection = step.direction;
+    self.position = step.position;
+    self.vertices = step.hitbox;
+
+    if (step.hitTank) {
+        playerTank->takeDamage(5.0f);
+        self.starMode = Enemy::StarActivationState::DESTROYED_AFTER_ACTIVATION;
+        playerTank->addExplosion(self.position, self.size / 10.0f); 
+    }
+}
+
+// Desenha a forma da estrela (pontas em localShape, de tamanho size) em position, girada de angle.
+void StarComponent::drawShape(const Vector2& position, const Vector2* localShape, float size, float angle)
+{
+    CV::color(0.9, 0.9, 0.1); 
+
+    Vector2 worldStarPoints[STAR_SHAPE_VERTICES];
+    float cosA = cos(angle); 
+    float sinA = sin(angle);
+    for (int i = 0; i < STAR_SHAPE_VERTICES; ++i) {
+        const Vector2& localP = localShape[i];
+        float rotatedX = localP.x * cosA - localP.y * sinA;
+        float rotatedY = localP.x * sinA + localP.y * cosA;
+        worldStarPoints[i] = Vector2(position.x + rotatedX, position.y + rotatedY);
+    }
+    for (int i = 0; i < STAR_SHAPE_VERTICES; ++i)
+    {
+        CV::triangleFill(position, worldStarPoints[i], worldStarPoints[(i + 1) % STAR_SHAPE_VERTICES]);
+    }
+
+    CV::color(0.6, 0.6, 0.05); 
+    CV::circleFill(position.x, position.y, size * 0.15f, 12); 
+}
+
+// Desenha a estrela (Nível 2) com a rotação atual e sua barra de vida.
+void StarComponent::draw(const Enemy& self) const
+{
+    const SpriteAtlas& atlas = SpriteAtlas::shared();
+    if (atlas.isReady()) {
+        atlas.draw(SPRITE_ENEMY_STAR, self.position, currentRotationAngle, self.size / Enemy::getSizeForLevel(2));
+    } else {
+        drawShape(self.position, localStarShapeVertices, self.size, currentRotationAngle);
+    }
+
+    self.drawHealthBar(self.position.y, self.size * 0.8f + 3.0f);
 }
 
 // Gera projéteis de estilhaços quando um inimigo do Nível 3 é destruído.
-std::vector<Projectile> Enemy::generateShrapnel(float projectileSpeed, float projectileDamage, float shrapnelWidth, float shrapnelHeight) const
+// Os estilhaços são criados diretamente no pool de projéteis.
+void Enemy::generateShrapnel(ProjectilePool& pool, float projectileSpeed, float projectileDamage, float shrapnelWidth, float shrapnelHeight) const
 {
-    std::vector<Projectile> shrapnels;
     if (this->level != 3) { 
-        return shrapnels;
+        return;
     }
 
     int numTeeth = 8;
@@ -329,103 +330,79 @@ std::vector<Projectile> Enemy::generateShrapnel(float projectileSpeed, float pro
         Vector2 shrapnelDirection(cos(shrapnelAngle), sin(shrapnelAngle));
         Vector2 shrapnelStartPosition = this->position + shrapnelDirection * (toothOuterRadius * 0.8f);
 
-        shrapnels.emplace_back(
+        pool.spawn(
             shrapnelStartPosition,
             shrapnelDirection,
             projectileSpeed,
             shrapnelWidth,  
             shrapnelHeight, 
-            Projectile::Owner::ENEMY_SHRAPNEL,
+            ProjectileOwner::ENEMY_SHRAPNEL,
             projectileDamage
         );
     }
-    return shrapnels;
 }
 
 // Inicializa a trajetória de voo para o inimigo avião (Nível 4).
-void Enemy::initializeFlightPath(const Track& track) {
-    if (level != 4 || planePathInitialized) return;
+// A trajetória acompanha a curva central da pista, afastada dela em direção ao centro
+// da pista; o avião começa em um ponto sorteado dela.
+void PlaneComponent::initializeFlightPath(Enemy& self, const Track& track, Random& rng) {
+    if (planePathInitialized) return;
 
-    flightPathNodes.clear();
     const auto& outerPoints = track.getOuterCurvePoints();
-    const auto& innerPoints = track.getInnerCurvePoints();
-
-    if (outerPoints.empty() || innerPoints.empty()) {
-        position.set(track.getScreenWidth() / 2.0f, track.getScreenHeight() / 2.0f);
-        planeCurrentDisplayPosition = position;
-        flightPathNodes.push_back(position); 
-        currentFlightPathNodeIndex = 0;
-        planePathInitialized = true;
-        return;
-    }
+    float pathLength = track.getCenterLength();
+    planePathInitialized = true;
 
-    size_t numPathPoints = std::min(outerPoints.size(), innerPoints.size());
-    if (numPathPoints == 0) { 
-        position.set(track.getScreenWidth() / 2.0f, track.getScreenHeight() / 2.0f);
-        planeCurrentDisplayPosition = position;
-        flightPathNodes.push_back(position);
-        currentFlightPathNodeIndex = 0;
-        planePathInitialized = true;
+    if (outerPoints.empty() || pathLength <= 0.0f) {
+        self.position.set(track.getWorldWidth() / 2.0f, track.getWorldHeight() / 2.0f);
+        planeCurrentDisplayPosition = self.position;
+        flightPathDistance = 0.0f;
         return;
     }
-    
+
     float base_margin = 35.0f; 
-    float actual_margin = base_margin + planePathOffsetSeed; 
+    flightPathMargin = base_margin + planePathOffsetSeed; 
 
-    for (size_t i = 0; i < numPathPoints; ++i) {
-        Vector2 midPoint = (outerPoints[i % outerPoints.size()] + innerPoints[i % innerPoints.size()]) * 0.5f;
-        
-        Vector2 p_prev = (outerPoints[(i + numPathPoints - 1) % numPathPoints] + innerPoints[(i + numPathPoints - 1) % numPathPoints]) * 0.5f;
-        Vector2 p_next = (outerPoints[(i + 1) % numPathPoints] + innerPoints[(i + 1) % numPathPoints]) * 0.5f;
-        Vector2 tangent = (p_next - p_prev).normalizedSafe();
-        Vector2 normal_to_mid_path = tangent.perpendicular(); 
-
-        Vector2 trackCenterApprox(0,0);
-        if (!outerPoints.empty()) { 
-            for(const auto& op : outerPoints) trackCenterApprox = trackCenterApprox + op;
-            trackCenterApprox = trackCenterApprox * (1.0f / (float)outerPoints.size());
-        }
+    flightPathCenter.set(0, 0);
+    for (const auto& op : outerPoints) flightPathCenter = flightPathCenter + op;
+    flightPathCenter = flightPathCenter * (1.0f / (float)outerPoints.size());
 
-        if ((midPoint + normal_to_mid_path * actual_margin - trackCenterApprox).lengthSquared() >
-            (midPoint - normal_to_mid_path * actual_margin - trackCenterApprox).lengthSquared()) {
-            normal_to_mid_path = normal_to_mid_path * -1.0f; 
-        }
-        
-        flightPathNodes.push_back(midPoint + normal_to_mid_path * actual_margin);
-    }
-    
-    if (!flightPathNodes.empty()) {
-        currentFlightPathNodeIndex = rand() % flightPathNodes.size(); 
-        position = flightPathNodes[currentFlightPathNodeIndex]; 
-        planeCurrentDisplayPosition = position;
-        planePathInitialized = true;
-    } else {
-        position.set(track.getScreenWidth() / 2.0f, track.getScreenHeight() / 2.0f);
-        planeCurrentDisplayPosition = position;
-        flightPathNodes.push_back(position);
-        currentFlightPathNodeIndex = 0;
-        planePathInitialized = true; 
-    }
+    flightPathDistance = rng.nextFloat() * pathLength;
+    self.position = flightPathPoint(track, flightPathDistance);
+    planeCurrentDisplayPosition = self.position;
 }
 
-// Atualiza a lógica específica do inimigo avião (Nível 4), incluindo movimento, ataque e bombas.
-void Enemy::updatePlaneSpecifics(float fps, const Track& track, Tank* playerTank) {
-    if (level != 4) return;
-
-    if (!planePathInitialized) {
-        initializeFlightPath(track);
-        if (!planePathInitialized || flightPathNodes.empty()) return; 
+// Amostra a curva central por comprimento de arco (O(log n)) e afasta o ponto dela pela
+// margem da trajetória, na normal orientada para o centro da pista.
+Vector2 PlaneComponent::flightPathPoint(const Track& track, float distance) const {
+    if (track.getCenterLength() <= 0.0f) {
+        return Vector2(track.getWorldWidth() / 2.0f, track.getWorldHeight() / 2.0f);
     }
+    Vector2 tangent;
+    Vector2 midPoint = track.sampleCenterAtDistance(distance, tangent);
+    Vector2 normal_to_mid_path = tangent.perpendicular(); 
+    if ((midPoint + normal_to_mid_path * flightPathMargin - flightPathCenter).lengthSquared() >
+        (midPoint - normal_to_mid_path * flightPathMargin - flightPathCenter).lengthSquared()) {
+        normal_to_mid_path = normal_to_mid_path * -1.0f; 
+    }
+    return midPoint + normal_to_mid_path * flightPathMargin;
+}
 
-    Vector2 targetNode = flightPathNodes[currentFlightPathNodeIndex];
-    Vector2 directionToNode = (targetNode - position).normalizedSafe();
+// Atualiza a lógica do inimigo avião (Nível 4), incluindo movimento, ataque e bombas.
+// A trajetória já foi inicializada pelo EnemyStore (initializeFlightPath usa o gerador).
+void PlaneComponent::update(Enemy& self, float fps, const Track& track) {
+    Vector2 targetNode = flightPathPoint(track, flightPathDistance);
+    Vector2 directionToNode = (targetNode - self.position).normalizedSafe();
 
     movementDirection = directionToNode; 
-    position = position + movementDirection * movementSpeed * (1.0f / fps);
+    self.position = self.position + movementDirection * self.movementSpeed * (1.0f / fps);
     planeVisualDirection = movementDirection; 
 
-    if ((targetNode - position).lengthSquared() < planeTargetReachedThresholdSq) {
-        currentFlightPathNodeIndex = (currentFlightPathNodeIndex + 1) % flightPathNodes.size();
+    // o alvo avança pela trajetória até ficar fora do raio de alcance (no máximo uma volta)
+    float pathLength = track.getCenterLength();
+    for (float advanced = 0.0f; advanced < pathLength && (targetNode - self.position).lengthSquared() < planeTargetReachedThresholdSq;
+         advanced += PLANE_FLIGHT_PATH_STEP) {
+        flightPathDistance = std::fmod(flightPathDistance + PLANE_FLIGHT_PATH_STEP, pathLength);
+        targetNode = flightPathPoint(track, flightPathDistance);
     }
 
     planeSineCycle += 2.5f * (1.0f / fps); 
@@ -435,11 +412,11 @@ void Enemy::updatePlaneSpecifics(float fps, const Track& track, Tank* playerTank
     float actualSineAmplitude = baseSineAmplitude * planeSineAmplitudeModifier; 
     Vector2 perpendicularDirection = movementDirection.perpendicular();
     Vector2 sineOffset = perpendicularDirection * sin(planeSineCycle) * actualSineAmplitude; 
-    planeCurrentDisplayPosition = position + sineOffset;
+    planeCurrentDisplayPosition = self.position + sineOffset;
 
     planeBombDropTimer -= (1.0f / fps);
     if (planeBombDropTimer <= 0.0f) {
-        dropBomb();
+        dropBomb(self);
         planeBombDropTimer = planeBombDropCooldownMax; 
     }
 
@@ -449,27 +426,38 @@ void Enemy::updatePlaneSpecifics(float fps, const Track& track, Tank* playerTank
 
     for (auto it = activeBombs.begin(); it != activeBombs.end(); ) {
         if (!it->active) { 
-            if (playerTank) { 
-                playerTank->addExplosion(it->position, 2.5f); 
-            }
-            if (playerTank && !playerTank->isDestroyed() && !playerTank->shield.isEffectActive()) {
-                if ((it->position - playerTank->pivot).lengthSquared() < (it->explosionRadius * it->explosionRadius)) {
-                    playerTank->takeDamage(it->damage);
-                }
-            }
+            detonatedBombs.push_back(*it);
             it = activeBombs.erase(it);
         } else {
             ++it;
         }
     }
-    updateDynamicHitboxVertices(); 
+    updateHitbox(self); 
 }
 
-// Faz o inimigo avião (Nível 4) soltar uma bomba.
-void Enemy::dropBomb() {
-    if (level != 4) return;
+// Aplica ao tanque as explosões das bombas detonadas no último update, na ordem em que
+// explodiram. O som da bomba solta no update também é tocado aqui, na fase serial.
+void PlaneComponent::applyDetonations(Tank* playerTank) {
+    if (bombDropped && playerTank) {
+        playerTank->playSound(SOUND_BOMB_DROP, planeCurrentDisplayPosition, 0.6f);
+    }
+    bombDropped = false;
+    for (const auto& bomb : detonatedBombs) {
+        if (playerTank) { 
+            playerTank->addExplosion(bomb.position, 2.5f); 
+        }
+        if (playerTank && !playerTank->isDestroyed() && !playerTank->shield.isEffectActive()) {
+            if ((bomb.position - playerTank->pivot).lengthSquared() < (bomb.explosionRadius * bomb.explosionRadius)) {
+                playerTank->takeDamage(bomb.damage);
+            }
+        }
+    }
+    detonatedBombs.clear();
+}
 
-    Vector2 bombStartPosition = planeCurrentDisplayPosition - planeVisualDirection * (size * 0.2f); 
+// Faz o inimigo avião (Nível 4) soltar uma bomba.
+void PlaneComponent::dropBomb(const Enemy& self) {
+    Vector2 bombStartPosition = planeCurrentDisplayPosition - planeVisualDirection * (self.size * 0.2f); 
     bombStartPosition.y += 5.0f; 
 
     Vector2 bombInitialVelocity = planeVisualDirection * -1.0f * 20.0f; 
@@ -478,17 +466,12 @@ void Enemy::dropBomb() {
     float bombFallAngle = atan2(bombInitialVelocity.y, bombInitialVelocity.x) + M_PI/2.0f;
 
     activeBombs.emplace_back(bombStartPosition, bombInitialVelocity, bombFallAngle);
+    bombDropped = true;
 }
 
-// Desenha os elementos visuais do inimigo avião (Nível 4).
-void Enemy::drawPlaneVisuals() const {
-    if (level != 4) return;
-
-    glPushMatrix();
-    glTranslatef(planeCurrentDisplayPosition.x, planeCurrentDisplayPosition.y, 0);
-    float angleDegrees = atan2(planeVisualDirection.y, planeVisualDirection.x) * 180.0f / M_PI + 90.0f;
-    glRotatef(angleDegrees, 0, 0, 1);
-
+// Desenha a forma do avião do tamanho dado em coordenadas locais (centro na origem,
+// apontando para -y).
+void PlaneComponent::drawShape(float size) {
     float s = size * 0.8f; 
 
     float bodyColor[] = {0.5f, 0.55f, 0.5f}; 
@@ -527,6 +510,31 @@ void Enemy::drawPlaneVisuals() const {
     glRotatef(90, 0,0,1); 
     CV::rectFill(-s*0.05f, -s*0.95f, s*0.05f, -s*0.45f); 
     glPopMatrix();
+}
+
+// Desenha o inimigo avião (Nível 4) e a barra de vida.
+void PlaneComponent::draw(const Enemy& self) const {
+    float angle = atan2(planeVisualDirection.y, planeVisualDirection.x) + M_PI / 2.0f;
+    const SpriteAtlas& atlas = SpriteAtlas::shared();
+    if (atlas.isReady()) {
+        atlas.draw(SPRITE_ENEMY_PLANE, planeCurrentDisplayPosition, angle, self.size / Enemy::getSizeForLevel(4));
+    } else {
+        glPushMatrix();
+        glTranslatef(planeCurrentDisplayPosition.x, planeCurrentDisplayPosition.y, 0);
+        glRotatef(angle * 180.0f / M_PI, 0, 0, 1);
+        drawShape(self.size);
+        glPopMatrix();
+    }
 
-    glPopMatrix(); 
+    self.drawHealthBar(planeCurrentDisplayPosition.y, self.size * 0.5f + 8.0f);
+}
+
+// Desenha as bombas do avião que cruzam a área visível (as bombas se afastam do avião,
+// então são recortadas uma a uma, e não junto com ele).
+void PlaneComponent::drawBombs(float minX, float minY, float maxX, float maxY) const {
+    for (const auto& bomb : activeBombs) {
+        if (bomb.position.x + BOMB_DRAW_RADIUS < minX || bomb.position.x - BOMB_DRAW_RADIUS > maxX ||
+            bomb.position.y + BOMB_DRAW_RADIUS < minY || bomb.position.y - BOMB_DRAW_RADIUS > maxY) continue;
+        bomb.draw();
+    }
 }
\ No newline at end of file
@@ -3,10 +3,12 @@
 // incluindo sua lógica de movimento, comportamento, dano e destruição.
 // Suporta diferentes níveis de inimigos com características distintas:
 // - Nível 1: Inimigo triangular estático.
-// - Nível 2: Inimigo estrela que se torna ativo e móvel após receber dano.
+// - Nível 2: Inimigo estrela que se torna ativo e móvel após receber dano e então persegue o tanque.
 // - Nível 3: Inimigo octogonal estático que libera estilhaços ao ser destruído.
 // - Nível 4: Inimigo avião que segue uma trajetória e solta bombas.
 // A estrutura Bomb define as bombas lançadas pelo inimigo avião.
+// Os dados específicos da estrela e do avião ficam nos componentes StarComponent e
+// PlaneComponent, guardados em arrays separados por tipo dentro de EnemyStore.
 // Funcionalidades incluem:
 // - Inicialização de inimigos com base no nível.
 // - Geração de vértices para hitbox e renderização.
@@ -23,15 +25,21 @@
 #include <cstdlib> 
 #include <vector>  
 #include <cmath>   
+#include <algorithm>
 #include "Track.h"      
-#include "Projectile.h" 
+#include "ProjectilePool.h" 
 #include "CollisionUtils.h" 
+#include "SpatialHash.h"
+#include "ConvexPolygon.h"
+#include "Random.h"
 
 #ifndef M_PI 
 #define M_PI 3.14159265358979323846
 #endif
 
 class Tank; 
+class EnemyStore;
+class FlowField;
 
 // Estrutura que representa uma bomba lançada pelo inimigo avião (Nível 4).
 struct Bomb {
@@ -50,12 +58,15 @@ struct Bomb {
           explosionRadius(40.0f), damage(dmg), currentAngle(initialFallAngle), rotationSpeed(1.5f) {} 
 
     // Atualiza a posição, rotação e temporizador da bomba.
+    // No passo em que o temporizador acaba, a bomba só avança até o instante da explosão,
+    // então o ponto da explosão não depende da taxa de atualização.
     void update(float fps) {
         if (!active) return;
-        position = position + velocity * (1.0f / fps);
+        float dt = std::min(1.0f / fps, std::max(timer, 0.0f));
+        position = position + velocity * dt;
         
-        velocity.y += 10.0f * (1.0f/fps); 
-        currentAngle += rotationSpeed * (1.0f/fps);
+        velocity.y += 10.0f * dt; 
+        currentAngle += rotationSpeed * dt;
 
         timer -= (1.0f / fps);
         if (timer <= 0.0f) {
@@ -91,6 +102,16 @@ struct Bomb {
 };
 
 
+#define STAR_SHAPE_VERTICES 8
+#define STAR_CHASE_STEERING 3.0f // quanto a estrela ativada vira por segundo em direção ao campo de fluxo
+#define PLANE_FLIGHT_PATH_STEP 4.0f // passo com que o alvo do avião avança pela trajetória, em pixels
+#define BOMB_DRAW_RADIUS 12.0f      // maior distância do desenho da bomba até sua posição
+#define PLANE_BOMB_RESERVE 4        // bombas simultâneas de um avião com espaço reservado
+
+// Componente comum a todos os inimigos (posição, vida, hitbox, barra de vida).
+// Os dados específicos da estrela (Nível 2) e do avião (Nível 4) ficam em
+// StarComponent e PlaneComponent, em arrays separados dentro de EnemyStore;
+// component é o índice do inimigo no array do seu tipo (-1 para os estáticos).
 class Enemy
 {
 public:
@@ -101,7 +122,7 @@ public:
     int level;        
     int health;       
     float size;       
-    std::vector<Vector2> vertices; 
+    ConvexPolygon vertices; // hitbox (eixos e AABB em cache)
 
     
     int initialHealth;
@@ -109,26 +130,18 @@ public:
 
     
     StarActivationState starMode;
-    Vector2 movementDirection; 
     float movementSpeed;
-    float currentRotationAngle;
-    float rotationSpeed;
-    std::vector<Vector2> localStarShapeVertices; 
+    int component;
 
-    
-    std::vector<Bomb> activeBombs;
-    std::vector<Vector2> flightPathNodes;
-    int currentFlightPathNodeIndex;
-    float planeTargetReachedThresholdSq;
-    float planeSineCycle; 
-    float planeBombDropCooldownMax;
-    float planeBombDropTimer;
-    Vector2 planeVisualDirection;      
-    Vector2 planeCurrentDisplayPosition; 
-    bool planePathInitialized;
-    float planePathOffsetSeed; 
-    float planeSineAmplitudeModifier; 
 
+    // Retorna o tamanho (raio) do inimigo de um nível.
+    static float getSizeForLevel(int enemyLevel) {
+        if (enemyLevel == 1) return 10.0f;
+        if (enemyLevel == 2) return 15.0f;
+        if (enemyLevel == 3) return 20.0f;
+        if (enemyLevel == 4) return 35.0f;
+        return 0.0f;
+    }
 
     // Retorna a contribuição de vida do inimigo para a barra de progresso do nível.
     static float getHealthContribution(int enemyLevel) {
@@ -148,67 +161,52 @@ public:
         return 0; 
     }
 
-    // Construtor da classe Enemy.
+    // Construtor da classe Enemy (apenas a parte comum; os componentes de tipo são criados pelo EnemyStore).
     Enemy(Vector2 pos, int lvl)
     {
         position = pos;
         level = lvl;
         starMode = StarActivationState::NORMAL;
-        currentRotationAngle = 0.0f;
         healthBarVisibleTimer = 0.0f; 
-        
-        planePathInitialized = false; 
+        component = -1;
+        size = getSizeForLevel(lvl);
 
         if (level == 1) {
             health = 1;
-            size = 10.0f;
             movementSpeed = 0; 
-            rotationSpeed = 0; 
         } else if (level == 2) {
             health = 2; 
-            size = 15.0f;
             movementSpeed = 150.0f; 
-            rotationSpeed = 2.5f;   
-            
-            int numStarVisualPoints = 4; 
-            float outerRadius = size;
-            float innerRadiusFactor = 0.30f;
-            float innerRadius = size * innerRadiusFactor;
-            float staticBaseRotation = M_PI / 4.0f; 
-
-            for (int i = 0; i < numStarVisualPoints; ++i) {
-                float angle_outer = staticBaseRotation + (float)i * (2.0f * M_PI / numStarVisualPoints);
-                localStarShapeVertices.push_back(Vector2(outerRadius * cos(angle_outer), outerRadius * sin(angle_outer)));
-                float angle_inner = staticBaseRotation + ((float)i + 0.5f) * (2.0f * M_PI / numStarVisualPoints);
-                localStarShapeVertices.push_back(Vector2(innerRadius * cos(angle_inner), innerRadius * sin(angle_inner)));
-            }
         } else if (level == 3) {
             health = 4;
-            size = 20.0f;
             movementSpeed = 0; 
-            rotationSpeed = 0; 
         } else if (level == 4) { 
             health = 10; 
-            size = 35.0f;   
             movementSpeed = 100.0f; 
-            planeBombDropCooldownMax = 3.5f; 
-            planeBombDropTimer = 1.0f; 
-            planeTargetReachedThresholdSq = 60.0f * 60.0f; 
-            currentFlightPathNodeIndex = 0;
-            planeSineCycle = (rand() / (float)RAND_MAX) * 2.0f * M_PI; 
-            planeVisualDirection.set(0, -1); 
-            planeCurrentDisplayPosition = pos;
-            planePathInitialized = false; 
-            planePathOffsetSeed = (rand() / (float)RAND_MAX) * 20.0f - 10.0f; 
-            planeSineAmplitudeModifier = 0.75f + (rand() / (float)RAND_MAX) * 0.5f; 
-            
-            
-            rotationSpeed = 0; 
+        } else {
+            health = 0;
+            movementSpeed = 0;
         }
         initialHealth = health; 
         generateInitialVertices(); 
     }
 
+    // Gera a forma local da estrela (pontas externas e internas alternadas) em out[STAR_SHAPE_VERTICES].
+    static void buildStarShape(float starSize, Vector2* out) {
+        int numStarVisualPoints = STAR_SHAPE_VERTICES / 2; 
+        float outerRadius = starSize;
+        float innerRadiusFactor = 0.30f;
+        float innerRadius = starSize * innerRadiusFactor;
+        float staticBaseRotation = M_PI / 4.0f; 
+
+        for (int i = 0; i < numStarVisualPoints; ++i) {
+            float angle_outer = staticBaseRotation + (float)i * (2.0f * M_PI / numStarVisualPoints);
+            out[2 * i] = Vector2(outerRadius * cos(angle_outer), outerRadius * sin(angle_outer));
+            float angle_inner = staticBaseRotation + ((float)i + 0.5f) * (2.0f * M_PI / numStarVisualPoints);
+            out[2 * i + 1] = Vector2(innerRadius * cos(angle_inner), innerRadius * sin(angle_inner));
+        }
+    }
+
     // Gera os vértices iniciais para a hitbox do inimigo.
     void generateInitialVertices() { 
         vertices.clear();
@@ -218,17 +216,10 @@ public:
             vertices.push_back(Vector2(position.x - s * cos(M_PI / 6.0f), position.y + s * sin(M_PI / 6.0f)));
             vertices.push_back(Vector2(position.x + s * cos(M_PI / 6.0f), position.y + s * sin(M_PI / 6.0f)));
         } else if (level == 2) {
-            
-            if (!localStarShapeVertices.empty()) {
-                for(const auto& localP : localStarShapeVertices) {
-                    vertices.push_back(position + localP);
-                }
-            } else { 
-                int numSides = 8; float hitboxRadius = size;
-                for (int i = 0; i < numSides; ++i) {
-                    float angle = (2.0f * M_PI / numSides) * i;
-                    vertices.push_back(Vector2(position.x + hitboxRadius * cos(angle), position.y + hitboxRadius * sin(angle)));
-                }
+            Vector2 localStarShape[STAR_SHAPE_VERTICES];
+            buildStarShape(size, localStarShape);
+            for(const auto& localP : localStarShape) {
+                vertices.push_back(position + localP);
             }
         } else if (level == 3) { 
             int numSides = 8; float hitboxRadius = size;
@@ -237,57 +228,19 @@ public:
                 vertices.push_back(Vector2(position.x + hitboxRadius * cos(angle), position.y + hitboxRadius * sin(angle)));
             }
         } else if (level == 4) {
-            
-            
-            
             float s = size * 0.7f; 
-            
-            
             Vector2 localPoints[] = {
                 Vector2(-s, -s * 0.5f), Vector2(s, -s * 0.5f),
                 Vector2(s, s * 0.5f), Vector2(-s, s * 0.5f)
             };
             for(const auto& lp : localPoints) {
-                 
                 vertices.push_back(position + lp);
             }
         }
-    }
-    
-    // Atualiza os vértices da hitbox para inimigos dinâmicos (Estrela Nível 2, Avião Nível 4).
-    void updateDynamicHitboxVertices() { 
-        if (level == 2 && starMode == StarActivationState::ACTIVATED && !localStarShapeVertices.empty()) {
-            vertices.clear();
-            float cosA = cos(currentRotationAngle);
-            float sinA = sin(currentRotationAngle);
-            for (const auto& localP : localStarShapeVertices) {
-                float rotatedX = localP.x * cosA - localP.y * sinA;
-                float rotatedY = localP.x * sinA + localP.y * cosA;
-                vertices.push_back(Vector2(position.x + rotatedX, position.y + rotatedY));
-            }
-        } else if (level == 4) { 
-            
-            vertices.clear();
-            float s = size * 0.7f; 
-            float angle = atan2(planeVisualDirection.y, planeVisualDirection.x) + (M_PI/2.0f) ; 
-            float cosA = cos(angle);
-            float sinA = sin(angle);
-            Vector2 localPoints[] = {
-                Vector2(-s*0.8f, -s * 0.6f), Vector2(s*0.8f, -s * 0.6f), 
-                Vector2(s*0.8f, s * 0.6f), Vector2(-s*0.8f, s * 0.6f)
-            };
-            for(const auto& lp : localPoints) {
-                float rotatedX = lp.x * cosA - lp.y * sinA;
-                float rotatedY = lp.x * sinA + lp.y * cosA;
-                vertices.push_back(planeCurrentDisplayPosition + Vector2(rotatedX, rotatedY));
-            }
-        }
-        
-        
-        
     }
 
     // Aplica dano ao inimigo e lida com a ativação da estrela (Nível 2).
+    // A direção inicial da estrela ativada é sorteada no seu próximo update.
     void takeDamage(int damageAmount)
     {
         if (isDestroyed()) return; 
@@ -298,10 +251,6 @@ public:
                 if (health <= 0) { 
                     starMode = StarActivationState::ACTIVATED;
                     health = 1; 
-                    
-                    float angle = (static_cast<float>(rand()) / RAND_MAX) * 2.0f * M_PI;
-                    movementDirection.set(cos(angle), sin(angle));
-                    
                 }
             } else if (starMode == StarActivationState::ACTIVATED) {
                 health -= damageAmount; 
@@ -328,30 +277,151 @@ public:
         return health <= 0;
     }
 
-    // Atualiza o estado da estrela ativada (Nível 2).
-    void updateActivatedStar(float fps, const Track& track, std::vector<Enemy>& allEnemies, Tank* playerTank);
-
-    
-    // Inicializa a trajetória de voo para o inimigo avião (Nível 4).
-    void initializeFlightPath(const Track& track);
-    // Atualiza a lógica específica do inimigo avião (Nível 4).
-    void updatePlaneSpecifics(float fps, const Track& track, Tank* playerTank);
-    // Faz o inimigo avião (Nível 4) soltar uma bomba.
-    void dropBomb();
-    // Desenha os elementos visuais do inimigo avião (Nível 4).
-    void drawPlaneVisuals() const;
-
+    // Insere o inimigo na SpatialHash: AABB da hitbox e do círculo de raio size,
+    // ampliada pelo deslocamento máximo em um quadro (o hash só é reconstruído uma vez por quadro).
+    int insertInto(SpatialHash& hash, float fps) const {
+        float margin = movementSpeed / fps;
+        float minX = position.x - size, maxX = position.x + size;
+        float minY = position.y - size, maxY = position.y + size;
+        if (!vertices.empty()) {
+            minX = std::min(minX, vertices.getMinX()); maxX = std::max(maxX, vertices.getMaxX());
+            minY = std::min(minY, vertices.getMinY()); maxY = std::max(maxY, vertices.getMaxY());
+        }
+        return hash.insert(minX - margin, minY - margin, maxX + margin, maxY + margin);
+    }
 
     
     // Atualiza o temporizador de visibilidade da barra de vida.
     void updateHealthBarDisplay(float fps);
-    // Desenha a barra de vida do inimigo.
-    void drawHealthBar() const;
+    // Desenha a barra de vida do inimigo a yOffset abaixo de anchorY.
+    void drawHealthBar(float anchorY, float yOffset) const;
+
+    // Desenha a forma de um inimigo estático (Nível 1 ou 3) do tamanho dado, centrada em position.
+    static void drawShape(int level, const Vector2& position, float size);
+    // Desenha os inimigos estáticos (Níveis 1 e 3) e sua barra de vida.
+    void draw() const; 
+    // Gera estilhaços quando um inimigo do Nível 3 é destruído, diretamente no pool de projéteis.
+    void generateShrapnel(ProjectilePool& pool, float projectileSpeed, float projectileDamage, float shrapnelWidth, float shrapnelHeight) const; 
+};
+
+// Componente da estrela (Nível 2): direção, rotação e forma local.
+struct StarComponent
+{
+    int enemy; // índice do inimigo no array comum
+    Vector2 movementDirection; 
+    float currentRotationAngle;
+    float rotationSpeed;
+    bool launched; // a direção inicial já foi sorteada após a ativação
+    Vector2 localStarShapeVertices[STAR_SHAPE_VERTICES]; 
+
+    // Construtor do componente da estrela.
+    StarComponent(int enemyIndex, float starSize)
+        : enemy(enemyIndex), currentRotationAngle(0.0f), rotationSpeed(2.5f), launched(false)
+    {
+        Enemy::buildStarShape(starSize, localStarShapeVertices);
+    }
+
+    // Atualiza os vértices da hitbox com a posição e a rotação atuais.
+    void updateHitbox(Enemy& self) const {
+        self.vertices.setTransformed(localStarShapeVertices, STAR_SHAPE_VERTICES, self.position,
+                                     cos(currentRotationAngle), sin(currentRotationAngle));
+    }
+
+    // Resultado de um quadro da estrela, calculado sem alterar nenhum inimigo.
+    struct Step {
+        bool active;            // a estrela estava ativada
+        bool hitTank;           // atingiu o tanque (e será destruída)
+        bool bounced;           // colidiu com outro inimigo
+        Vector2 position;
+        Vector2 direction;
+        float rotation;
+        ConvexPolygon hitbox;   // hitbox na nova posição
+        int reflectedEnemy;     // estrela ativada atingida, que também é refletida (-1 = nenhuma)
+        Vector2 reflectNormal;  // normal da colisão, vista pela estrela atingida
+
+        Step() : active(false), hitTank(false), bounced(false), rotation(0.0f), reflectedEnemy(-1) {}
+    };
+
+    // Sorteia a direção inicial no primeiro quadro após a ativação.
+    void launch(Random& rng);
+    // Fase de leitura: calcula o quadro da estrela a partir do estado atual de todos os
+    // inimigos e do tanque, sem alterar nada (pode rodar em paralelo com as outras estrelas).
+    // A estrela persegue o tanque pela pista, virando aos poucos na direção do campo de fluxo.
+    void computeStep(const Enemy& self, float fps, const Track& track, const FlowField& flowField,
+                     const EnemyStore& store, const SpatialHash& enemyHash, const Tank* playerTank, Step& step) const;
+    // Fase de escrita: aplica o quadro calculado (movimento e dano ao tanque).
+    void applyStep(Enemy& self, const Step& step, Tank* playerTank);
+    // Desenha a forma da estrela (pontas em localShape) em position, girada de angle.
+    static void drawShape(const Vector2& position, const Vector2* localShape, float size, float angle);
+    // Desenha a estrela e sua barra de vida.
+    void draw(const Enemy& self) const;
+};
+
+// Componente do avião (Nível 4): trajetória de voo, ondulação e bombas.
+struct PlaneComponent
+{
+    int enemy; // índice do inimigo no array comum
+    std::vector<Bomb> activeBombs;
+    std::vector<Bomb> detonatedBombs; // bombas que explodiram no último update (aplicadas depois)
+    float flightPathDistance;  // posição do alvo do avião, em distância ao longo da curva central
+    float flightPathMargin;    // afastamento da trajetória em relação à curva central
+    Vector2 flightPathCenter;  // centro aproximado da pista: a trajetória fica do lado dele
+    float planeTargetReachedThresholdSq;
+    float planeSineCycle; 
+    float planeBombDropCooldownMax;
+    float planeBombDropTimer;
+    Vector2 movementDirection;
+    Vector2 planeVisualDirection;      
+    Vector2 planeCurrentDisplayPosition; 
+    bool planePathInitialized;
+    float planePathOffsetSeed; 
+    float planeSineAmplitudeModifier; 
+    bool bombDropped; // soltou uma bomba no último update (o som é tocado em applyDetonations)
+
+    // Construtor do componente do avião (os parâmetros de voo são sorteados com rng).
+    PlaneComponent(int enemyIndex, const Vector2& pos, Random& rng)
+        : enemy(enemyIndex), flightPathDistance(0.0f), flightPathMargin(0.0f), planeTargetReachedThresholdSq(60.0f * 60.0f),
+          planeBombDropCooldownMax(3.5f), planeBombDropTimer(1.0f), movementDirection(0, -1),
+          planeVisualDirection(0, -1), planeCurrentDisplayPosition(pos), planePathInitialized(false),
+          bombDropped(false)
+    {
+        planeSineCycle = rng.nextFloat() * 2.0f * M_PI; 
+        planePathOffsetSeed = rng.nextFloat() * 20.0f - 10.0f; 
+        planeSineAmplitudeModifier = 0.75f + rng.nextFloat() * 0.5f; 
+        // espaço para as bombas reservado na criação, para que o update não aloque
+        activeBombs.reserve(PLANE_BOMB_RESERVE);
+        detonatedBombs.reserve(PLANE_BOMB_RESERVE);
+    }
+
+    // Atualiza os vértices da hitbox com a posição exibida e a direção visual.
+    void updateHitbox(Enemy& self) const {
+        float s = self.size * 0.7f; 
+        float angle = atan2(planeVisualDirection.y, planeVisualDirection.x) + (M_PI/2.0f) ; 
+        Vector2 localPoints[] = {
+            Vector2(-s*0.8f, -s * 0.6f), Vector2(s*0.8f, -s * 0.6f), 
+            Vector2(s*0.8f, s * 0.6f), Vector2(-s*0.8f, s * 0.6f)
+        };
+        self.vertices.setTransformed(localPoints, 4, planeCurrentDisplayPosition, cos(angle), sin(angle));
+    }
 
-    // Desenha o inimigo na tela.
-    void draw(); 
-    // Gera estilhaços quando um inimigo do Nível 3 é destruído.
-    std::vector<Projectile> generateShrapnel(float projectileSpeed, float projectileDamage, float shrapnelWidth, float shrapnelHeight) const; 
+    // Inicializa a trajetória de voo.
+    void initializeFlightPath(Enemy& self, const Track& track, Random& rng);
+    // Ponto da trajetória de voo a uma distância dada ao longo da curva central da pista.
+    Vector2 flightPathPoint(const Track& track, float distance) const;
+    // Atualiza movimento, ataque e bombas do avião; as bombas que explodem ficam em
+    // detonatedBombs (não altera o tanque, pode rodar em paralelo com os outros aviões).
+    void update(Enemy& self, float fps, const Track& track);
+    // Aplica ao tanque as explosões das bombas detonadas no último update e toca o som da
+    // bomba solta nele.
+    void applyDetonations(Tank* playerTank);
+    // Faz o avião soltar uma bomba.
+    void dropBomb(const Enemy& self);
+    // Desenha a forma do avião do tamanho dado em coordenadas locais (centro na origem).
+    static void drawShape(float size);
+    // Desenha o avião e a barra de vida.
+    void draw(const Enemy& self) const;
+    // Desenha as bombas do avião que cruzam a área visível dada.
+    void drawBombs(float minX, float minY, float maxX, float maxY) const;
 };
 
 #endif // ENEMIES_H_INCLUDED
\ No newline at end of file
@@ -0,0 +1,331 @@
+// Este arquivo define a classe EnemyStore, o armazenamento de todos os inimigos do nível.
+// Os dados ficam separados por tipo, em arrays contíguos:
+// - enemies: componente comum (Enemy) de todos os inimigos, denso e sem buracos;
+// - stars: componente da estrela (Nível 2), um por estrela;
+// - planes: componente do avião (Nível 4), um por avião.
+// Cada componente guarda o índice do seu inimigo no array comum e vice-versa, de modo
+// que cada tipo é atualizado por um laço próprio, sem testar o nível de cada inimigo.
+// Durante o quadro o índice no array comum é estável (é o handle da SpatialHash);
+// inimigos destruídos só são removidos em removeDestroyed(), no fim do quadro, por troca
+// com o último (swap-remove). Para referências que atravessam quadros existem os
+// EnemyHandle (slot + geração), que deixam de valer quando o inimigo é removido.
+#ifndef ___ENEMY_STORE__H___
+#define ___ENEMY_STORE__H___
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "Enemies.h"
+#include "SpatialHash.h"
+#include "JobSystem.h"
+
+#define ENEMY_UPDATE_MIN_PER_JOB 16 // inimigos por tarefa nas fases paralelas
+#define ENEMY_DRAW_MARGIN 16.0f     // o desenho (barra de vida) passa da caixa do inimigo na SpatialHash
+
+class Tank;
+class FlowField;
+
+// Referência estável a um inimigo: slot na tabela de indireção e geração do slot.
+struct EnemyHandle
+{
+    int slot;
+    unsigned generation;
+
+    EnemyHandle() : slot(-1), generation(0) {}
+    EnemyHandle(int slot, unsigned generation) : slot(slot), generation(generation) {}
+};
+
+class EnemyStore
+{
+    std::vector<Enemy> enemies;
+    std::vector<StarComponent> stars;
+    std::vector<PlaneComponent> planes;
+    std::vector<StarComponent::Step> starSteps; // resultado da fase de leitura das estrelas
+    mutable std::vector<int> visibleEnemies;    // índices desenhados no quadro atual
+
+    // argumentos da atualização em andamento, lidos pelas tarefas do grafo
+    struct UpdateArgs {
+        float fps;
+        const Track* track;
+        const FlowField* flowField;
+        const SpatialHash* enemyHash;
+        Tank* playerTank;
+    };
+    UpdateArgs updateArgs;
+    TaskGraph updateGraph; // remontado a cada atualização, reaproveitando as tarefas
+
+    // tabela de indireção dos handles
+    std::vector<int> denseToSlot;
+    std::vector<int> slotToDense;
+    std::vector<unsigned> slotGeneration;
+    std::vector<int> freeSlots;
+
+    // Remove o componente c do array do tipo, trocando-o pelo último.
+    template <typename Component>
+    void removeComponent(std::vector<Component>& components, int c)
+    {
+        int last = (int)components.size() - 1;
+        if (c != last) {
+            components[c] = std::move(components[last]);
+            enemies[components[c].enemy].component = c;
+        }
+        components.pop_back();
+    }
+
+    // Remove o inimigo i do array comum (e seu componente), trocando-o pelo último.
+    void removeAt(int i)
+    {
+        Enemy& enemy = enemies[i];
+        if (enemy.level == 2) removeComponent(stars, enemy.component);
+        else if (enemy.level == 4) removeComponent(planes, enemy.component);
+
+        int slot = denseToSlot[i];
+        slotToDense[slot] = -1;
+        slotGeneration[slot]++;
+        freeSlots.push_back(slot);
+
+        int last = (int)enemies.size() - 1;
+        if (i != last) {
+            enemies[i] = std::move(enemies[last]);
+            denseToSlot[i] = denseToSlot[last];
+            slotToDense[denseToSlot[i]] = i;
+            Enemy& moved = enemies[i];
+            if (moved.level == 2) stars[moved.component].enemy = i;
+            else if (moved.level == 4) planes[moved.component].enemy = i;
+        }
+        enemies.pop_back();
+        denseToSlot.pop_back();
+    }
+
+    // Prepara os eixos de todas as hitboxes lidas na fase paralela (o cálculo preguiçoso
+    // de ConvexPolygon escreve no polígono).
+    void prepareHitboxes(const Tank* playerTank);
+
+    // Aplica os quadros das estrelas na ordem do array. Uma estrela atingida por outra é
+    // refletida, a menos que ela mesma tenha colidido neste quadro (já mudou de direção).
+    void applyStarSteps(Tank* playerTank)
+    {
+        for (size_t i = 0; i < stars.size(); ++i) {
+            stars[i].applyStep(enemies[stars[i].enemy], starSteps[i], playerTank);
+        }
+        for (size_t i = 0; i < stars.size(); ++i) {
+            const StarComponent::Step& step = starSteps[i];
+            if (step.reflectedEnemy < 0) continue;
+            Enemy& other = enemies[step.reflectedEnemy];
+            if (other.starMode != Enemy::StarActivationState::ACTIVATED || starSteps[other.component].bounced) continue;
+            StarComponent& otherStar = stars[other.component];
+            otherStar.movementDirection = otherStar.movementDirection.reflect(step.reflectNormal);
+        }
+    }
+
+public:
+    // Cria um inimigo do nível dado e retorna seu handle.
+    EnemyHandle spawn(const Vector2& pos, int level, Random& rng)
+    {
+        int index = (int)enemies.size();
+        enemies.push_back(Enemy(pos, level));
+        Enemy& enemy = enemies.back();
+        if (level == 2) {
+            enemy.component = (int)stars.size();
+            stars.push_back(StarComponent(index, enemy.size));
+        } else if (level == 4) {
+            enemy.component = (int)planes.size();
+            planes.push_back(PlaneComponent(index, pos, rng));
+        }
+
+        int slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+            slotToDense[slot] = index;
+        } else {
+            slot = (int)slotToDense.size();
+            slotToDense.push_back(index);
+            slotGeneration.push_back(0);
+        }
+        denseToSlot.push_back(slot);
+        return EnemyHandle(slot, slotGeneration[slot]);
+    }
+
+    // Remove todos os inimigos (todos os handles deixam de valer).
+    void clear()
+    {
+        for (size_t slot = 0; slot < slotToDense.size(); ++slot) {
+            if (slotToDense[slot] >= 0) {
+                slotToDense[slot] = -1;
+                slotGeneration[slot]++;
+                freeSlots.push_back((int)slot);
+            }
+        }
+        enemies.clear();
+        stars.clear();
+        planes.clear();
+        denseToSlot.clear();
+    }
+
+    int size() const { return (int)enemies.size(); }
+    bool empty() const { return enemies.empty(); }
+    Enemy& operator[](int i) { return enemies[i]; }
+    const Enemy& operator[](int i) const { return enemies[i]; }
+    std::vector<Enemy>::const_iterator begin() const { return enemies.begin(); }
+    std::vector<Enemy>::const_iterator end() const { return enemies.end(); }
+
+    StarComponent& starOf(const Enemy& enemy) { return stars[enemy.component]; }
+    PlaneComponent& planeOf(const Enemy& enemy) { return planes[enemy.component]; }
+
+    // Handle estável do inimigo que ocupa o índice i no array comum.
+    EnemyHandle handleOf(int i) const
+    {
+        int slot = denseToSlot[i];
+        return EnemyHandle(slot, slotGeneration[slot]);
+    }
+
+    // Retorna o inimigo do handle, ou nullptr se ele já foi removido.
+    Enemy* get(const EnemyHandle& handle)
+    {
+        if (handle.slot < 0 || handle.slot >= (int)slotToDense.size()) return nullptr;
+        if (slotGeneration[handle.slot] != handle.generation || slotToDense[handle.slot] < 0) return nullptr;
+        return &enemies[slotToDense[handle.slot]];
+    }
+
+    // Reconstrói a SpatialHash: o handle de cada inimigo no hash é seu índice no array comum.
+    void rebuildHash(SpatialHash& hash, float fps) const
+    {
+        hash.clear();
+        for (const auto& enemy : enemies) {
+            enemy.insertInto(hash, fps);
+        }
+        hash.build();
+    }
+
+    // Atualiza o temporizador das barras de vida de todos os inimigos.
+    void updateHealthBars(float fps)
+    {
+        for (auto& enemy : enemies) {
+            enemy.updateHealthBarDisplay(fps);
+        }
+    }
+
+    // Atualiza todos os inimigos: barras de vida e um laço para cada tipo dinâmico.
+    // Nenhum inimigo é removido aqui, então os índices da SpatialHash continuam válidos.
+    // A atualização é um grafo de tarefas no JobSystem:
+    // - barras de vida, em paralelo com o resto;
+    // - leitura das estrelas (paralela): cada estrela calcula seu quadro sobre o estado do
+    //   início da fase, sem escrever em nenhum inimigo;
+    // - escrita das estrelas (serial, na ordem do array): movimento, dano e explosões no
+    //   tanque e a reflexão das estrelas atingidas;
+    // - movimento dos aviões e das bombas (paralelo);
+    // - explosões das bombas no tanque (serial, na ordem do array).
+    // Os sorteios do gerador são feitos antes, em ordem, então o resultado não depende do
+    // número de threads. As estrelas ativadas perseguem o tanque pelo campo de fluxo.
+    // As tarefas capturam só this (os argumentos ficam em updateArgs), então remontar o
+    // grafo não aloca memória.
+    void update(float fps, const Track& track, const FlowField& flowField, const SpatialHash& enemyHash,
+                Tank* playerTank, Random& rng)
+    {
+        for (auto& star : stars) {
+            if (enemies[star.enemy].starMode == Enemy::StarActivationState::ACTIVATED) star.launch(rng);
+        }
+        for (auto& plane : planes) {
+            plane.initializeFlightPath(enemies[plane.enemy], track, rng);
+        }
+        prepareHitboxes(playerTank);
+        starSteps.resize(stars.size());
+
+        updateArgs.fps = fps;
+        updateArgs.track = &track;
+        updateArgs.flowField = &flowField;
+        updateArgs.enemyHash = &enemyHash;
+        updateArgs.playerTank = playerTank;
+
+        TaskGraph& graph = updateGraph;
+        graph.clear();
+        graph.add([this]() {
+            const UpdateArgs& args = updateArgs;
+            JobSystem::shared().parallelFor(size(), ENEMY_UPDATE_MIN_PER_JOB, [&](int begin, int end) {
+                for (int i = begin; i < end; ++i) enemies[i].updateHealthBarDisplay(args.fps);
+            });
+        });
+        int starsRead = graph.add([this]() {
+            const UpdateArgs& args = updateArgs;
+            JobSystem::shared().parallelFor((int)stars.size(), ENEMY_UPDATE_MIN_PER_JOB, [&](int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    stars[i].computeStep(enemies[stars[i].enemy], args.fps, *args.track, *args.flowField, *this,
+                                         *args.enemyHash, args.playerTank, starSteps[i]);
+                }
+            });
+        });
+        int starsWrite = graph.add([this]() { applyStarSteps(updateArgs.playerTank); });
+        int planesMove = graph.add([this]() {
+            const UpdateArgs& args = updateArgs;
+            JobSystem::shared().parallelFor((int)planes.size(), ENEMY_UPDATE_MIN_PER_JOB, [&](int begin, int end) {
+                for (int i = begin; i < end; ++i) planes[i].update(enemies[planes[i].enemy], args.fps, *args.track);
+            });
+        });
+        int planesWrite = graph.add([this]() {
+            for (auto& plane : planes) plane.applyDetonations(updateArgs.playerTank);
+        });
+        graph.precede(starsRead, starsWrite);
+        graph.precede(starsWrite, planesMove);
+        graph.precede(planesMove, planesWrite);
+        JobSystem::shared().run(graph);
+    }
+
+    // Remove os inimigos destruídos, chamando onDestroyed(enemy) para cada um antes da remoção.
+    // Percorre de trás para frente: o inimigo trazido do fim para o lugar do removido já foi visitado.
+    template <typename Callback>
+    void removeDestroyed(Callback onDestroyed)
+    {
+        for (int i = (int)enemies.size() - 1; i >= 0; --i) {
+            if (enemies[i].isDestroyed()) {
+                onDestroyed(enemies[i]);
+                removeAt(i);
+            }
+        }
+    }
+
+    // Desenha os inimigos estáticos, depois as estrelas, os aviões e as bombas.
+    void draw() const
+    {
+        for (const auto& enemy : enemies) {
+            if (enemy.component < 0) enemy.draw();
+        }
+        for (const auto& star : stars) {
+            star.draw(enemies[star.enemy]);
+        }
+        for (const auto& plane : planes) {
+            plane.draw(enemies[plane.enemy]);
+        }
+        for (const auto& plane : planes) {
+            plane.drawBombs(-1e30f, -1e30f, 1e30f, 1e30f);
+        }
+    }
+
+    // Desenha, na mesma ordem, só os inimigos que cruzam a área visível dada: a consulta
+    // usa a SpatialHash do quadro, que deve ter sido reconstruída depois da última remoção.
+    void draw(const SpatialHash& hash, float minX, float minY, float maxX, float maxY) const
+    {
+        visibleEnemies.clear();
+        hash.query(minX - ENEMY_DRAW_MARGIN, minY - ENEMY_DRAW_MARGIN, maxX + ENEMY_DRAW_MARGIN, maxY + ENEMY_DRAW_MARGIN,
+                   [this](int i) {
+                       if (i < size()) visibleEnemies.push_back(i);
+                       return true;
+                   });
+        std::sort(visibleEnemies.begin(), visibleEnemies.end());
+
+        for (int i : visibleEnemies) {
+            if (enemies[i].component < 0) enemies[i].draw();
+        }
+        for (int i : visibleEnemies) {
+            if (enemies[i].level == 2) stars[enemies[i].component].draw(enemies[i]);
+        }
+        for (int i : visibleEnemies) {
+            if (enemies[i].level == 4) planes[enemies[i].component].draw(enemies[i]);
+        }
+        for (const auto& plane : planes) {
+            plane.drawBombs(minX, minY, maxX, maxY);
+        }
+    }
+};
+
+#endif
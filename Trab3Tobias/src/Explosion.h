@@ -1,19 +1,28 @@
-// Este arquivo define a classe Explosion e uma função auxiliar drawExplosionSprite.
-// A classe Explosion gerencia a animação de uma explosão, controlando sua posição,
-// quadro atual, duração de cada quadro e escala.
+// Este arquivo define a classe ExplosionPool e uma função auxiliar drawExplosionSprite.
+// A ExplosionPool guarda as explosões ativas (o clarão animado; as faíscas, a fumaça e
+// os destroços ficam no ParticleSystem) no formato "estrutura de arrays", como o
+// ProjectilePool: posição, escala, quadro atual e tempo no quadro. As explosões que
+// terminam são removidas trocando-as pela última (swap-remove), e todas as visíveis são
+// desenhadas em um único lote de retângulos do SpriteAtlas.
 // A função drawExplosionSprite é responsável por desenhar cada quadro individual
-// da animação da explosão, utilizando diferentes formas e cores para simular o efeito.
+// da animação da explosão, utilizando diferentes formas e cores para simular o efeito;
+// os quadros são montados uma vez no SpriteAtlas e desenhados como sprites.
 #ifndef EXPLOSION_H_INCLUDED
 #define EXPLOSION_H_INCLUDED
 
 #include "gl_canvas2d.h"
 #include "Vector2.h"
+#include "Sprites.h"
+#include <vector>
 #include <cmath> 
 #include <cstdlib> 
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
+#define EXPLOSION_SPRITE_RADIUS 30.0f // maior distância do desenho até o centro, na escala 1
+#define EXPLOSION_FRAMES 7              // quadros da animação
+#define EXPLOSION_FRAME_DURATION 0.07f  // segundos por quadro
 
 // Desenha um quadro específico da animação de explosão.
 inline void drawExplosionSprite(Vector2 center, int frame, float baseScale)
@@ -143,43 +152,88 @@ inline void drawExplosionSprite(Vector2 center, int frame, float baseScale)
 }
 
 
-class Explosion
+class ExplosionPool
 {
+    std::vector<float> posX, posY;
+    std::vector<float> scale;
+    std::vector<float> frameTime; // tempo no quadro atual
+    std::vector<int> frame;       // quadro atual
+
+    // Remove a explosão i trocando-a pela última (a memória fica para as próximas).
+    void remove(int i)
+    {
+        int last = size() - 1;
+        posX[i] = posX[last];
+        posY[i] = posY[last];
+        scale[i] = scale[last];
+        frameTime[i] = frameTime[last];
+        frame[i] = frame[last];
+        posX.pop_back();
+        posY.pop_back();
+        scale.pop_back();
+        frameTime.pop_back();
+        frame.pop_back();
+    }
+
 public:
-    Vector2 position;
-    int currentFrame;
-    float frameDuration;      
-    float timeSinceLastFrame; 
-    float scale;              
-    bool active;
-    static const int totalFrames = 7; 
-
-    // Construtor da explosão.
-    Explosion(Vector2 pos, float s = 1.0f) : 
-        position(pos), currentFrame(0), frameDuration(0.07f), 
-        timeSinceLastFrame(0.0f), scale(s), active(true) {}
-
-    // Atualiza o estado da animação da explosão.
+    // Inicia uma explosão em position com a escala s.
+    void add(const Vector2& position, float s = 1.0f)
+    {
+        posX.push_back(position.x);
+        posY.push_back(position.y);
+        scale.push_back(s);
+        frameTime.push_back(0.0f);
+        frame.push_back(0);
+    }
+
+    // Avança a animação de todas as explosões em um tick e remove as que terminaram.
     void update(float fps)
     {
-        if (!active || fps <= 0) return; 
-        timeSinceLastFrame += 1.0f / fps;
-        if (timeSinceLastFrame >= frameDuration)
-        {
-            currentFrame++;
-            timeSinceLastFrame = 0.0f; 
-            if (currentFrame >= totalFrames)
-            {
-                active = false; 
+        if (fps <= 0) return;
+        int i = 0;
+        while (i < size()) {
+            frameTime[i] += 1.0f / fps;
+            if (frameTime[i] >= EXPLOSION_FRAME_DURATION) {
+                frame[i]++;
+                frameTime[i] = 0.0f;
+                if (frame[i] >= EXPLOSION_FRAMES) {
+                    remove(i); // a última passa a ocupar i e é atualizada em seguida
+                    continue;
+                }
             }
+            ++i;
         }
     }
 
-    // Desenha o quadro atual da explosão.
-    void draw() const 
+    void clear()
     {
-        if (!active) return;
-        drawExplosionSprite(position, currentFrame, scale);
+        posX.clear();
+        posY.clear();
+        scale.clear();
+        frameTime.clear();
+        frame.clear();
+    }
+
+    int size() const { return (int)posX.size(); }
+
+    // Desenha as explosões que cruzam a área visível dada: o quadro atual de cada uma, em
+    // uma variação sorteada, em um único lote do atlas (ou, sem o atlas, proceduralmente).
+    void draw(float minX, float minY, float maxX, float maxY) const
+    {
+        const SpriteAtlas& atlas = SpriteAtlas::shared();
+        bool batched = atlas.isReady();
+        if (batched) atlas.beginBatch();
+        for (int i = 0; i < size(); ++i) {
+            float r = EXPLOSION_SPRITE_RADIUS * scale[i];
+            if (posX[i] + r < minX || posX[i] - r > maxX || posY[i] + r < minY || posY[i] - r > maxY) continue;
+            Vector2 position(posX[i], posY[i]);
+            if (batched) {
+                atlas.addToBatch(explosionSprite(frame[i], rand() % SPRITE_VARIANTS), position, 0.0f, scale[i], scale[i], 1.0f);
+            } else {
+                drawExplosionSprite(position, frame[i], scale[i]);
+            }
+        }
+        if (batched) atlas.endBatch();
     }
 };
 
@@ -0,0 +1,202 @@
+// Este arquivo define a classe FlowField, um campo de fluxo sobre a pista que leva até o tanque.
+// A área dirigível é rasterizada em uma grade de células (centro com distância positiva no
+// SDF da pista) e cada célula guarda o custo do caminho mais curto até a célula do tanque,
+// calculado por Dijkstra com filas por custo (Dial): passos retos custam 2 e diagonais 3
+// (aproximação inteira de 1 e sqrt(2)); diagonais só valem se as duas células retas vizinhas
+// também são dirigíveis, para o caminho não cortar a borda.
+// Um inimigo que persegue o tanque consulta direction(posição): a direção até a vizinha de
+// menor custo, em O(1), então o custo por inimigo não depende de quantos perseguem.
+// Quando o tanque muda de célula, o campo é recalculado em uma segunda grade, em fatias de
+// FLOW_FIELD_CELLS_PER_UPDATE células por quadro; as consultas continuam usando o campo
+// anterior até o novo ficar pronto, e então as grades são trocadas. O campo anterior
+// difere do novo só perto do tanque, onde a direção final aponta direto para ele.
+// A grade é reconstruída quando a revisão da pista muda (editor).
+#ifndef ___FLOW_FIELD__H___
+#define ___FLOW_FIELD__H___
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "Vector2.h"
+#include "Track.h"
+
+#define FLOW_FIELD_CELL_SIZE 8.0f
+#define FLOW_FIELD_CELLS_PER_UPDATE 4096  // células expandidas por quadro ao recalcular
+#define FLOW_FIELD_UNREACHABLE 0xFFFFFFFFu
+#define FLOW_FIELD_STRAIGHT_COST 2
+#define FLOW_FIELD_DIAGONAL_COST 3
+#define FLOW_FIELD_BUCKETS 4              // maior custo de passo + 1 (filas circulares)
+
+class FlowField
+{
+    float cellSize;
+    int cellsX, cellsY;
+    unsigned trackRevision;
+    std::vector<unsigned char> walkable;
+
+    // campo consultado (front) e campo em cálculo (o outro)
+    std::vector<unsigned> costs[2];
+    int front;
+    int frontTarget;     // célula do tanque no campo consultado (-1 = nenhum campo)
+    Vector2 targetPoint; // posição atual do tanque
+
+    // estado do cálculo em andamento
+    std::vector<int> buckets[FLOW_FIELD_BUCKETS];
+    int queued;
+    unsigned currentCost;
+    int backTarget;
+    bool propagating;
+
+    int cellOf(const Vector2& p) const
+    {
+        int cx = (int)std::floor(p.x / cellSize), cy = (int)std::floor(p.y / cellSize);
+        if (cx < 0 || cy < 0 || cx >= cellsX || cy >= cellsY) return -1;
+        return cy * cellsX + cx;
+    }
+
+    // Chama visit(vizinha, custo do passo) para as vizinhas dirigíveis da célula.
+    template <typename Visit>
+    void forEachNeighbor(int cell, Visit visit) const
+    {
+        int cx = cell % cellsX, cy = cell / cellsX;
+        bool left = cx > 0 && walkable[cell - 1];
+        bool right = cx + 1 < cellsX && walkable[cell + 1];
+        bool up = cy > 0 && walkable[cell - cellsX];
+        bool down = cy + 1 < cellsY && walkable[cell + cellsX];
+        if (left) visit(cell - 1, FLOW_FIELD_STRAIGHT_COST);
+        if (right) visit(cell + 1, FLOW_FIELD_STRAIGHT_COST);
+        if (up) visit(cell - cellsX, FLOW_FIELD_STRAIGHT_COST);
+        if (down) visit(cell + cellsX, FLOW_FIELD_STRAIGHT_COST);
+        if (left && up && walkable[cell - cellsX - 1]) visit(cell - cellsX - 1, FLOW_FIELD_DIAGONAL_COST);
+        if (right && up && walkable[cell - cellsX + 1]) visit(cell - cellsX + 1, FLOW_FIELD_DIAGONAL_COST);
+        if (left && down && walkable[cell + cellsX - 1]) visit(cell + cellsX - 1, FLOW_FIELD_DIAGONAL_COST);
+        if (right && down && walkable[cell + cellsX + 1]) visit(cell + cellsX + 1, FLOW_FIELD_DIAGONAL_COST);
+    }
+
+    // Começa a calcular, na grade que não está sendo consultada, o campo até a célula target.
+    void startPropagation(int target)
+    {
+        std::vector<unsigned>& back = costs[1 - front];
+        back.assign(walkable.size(), FLOW_FIELD_UNREACHABLE);
+        for (auto& bucket : buckets) bucket.clear();
+        back[target] = 0;
+        buckets[0].push_back(target);
+        queued = 1;
+        currentCost = 0;
+        backTarget = target;
+        propagating = true;
+    }
+
+    // Expande até budget células do cálculo em andamento; troca as grades ao terminar.
+    void propagate(int budget)
+    {
+        std::vector<unsigned>& back = costs[1 - front];
+        while (queued > 0 && budget > 0) {
+            std::vector<int>& bucket = buckets[currentCost % FLOW_FIELD_BUCKETS];
+            if (bucket.empty()) {
+                currentCost++;
+                continue;
+            }
+            int cell = bucket.back();
+            bucket.pop_back();
+            queued--;
+            if (back[cell] != currentCost) continue; // entrada antiga (custo já diminuiu)
+            budget--;
+            forEachNeighbor(cell, [&](int neighbor, unsigned stepCost) {
+                unsigned cost = currentCost + stepCost;
+                if (cost < back[neighbor]) {
+                    back[neighbor] = cost;
+                    buckets[cost % FLOW_FIELD_BUCKETS].push_back(neighbor);
+                    queued++;
+                }
+            });
+        }
+        if (queued == 0) {
+            propagating = false;
+            front = 1 - front;
+            frontTarget = backTarget;
+        }
+    }
+
+    // Rasteriza a área dirigível da pista e calcula o campo inteiro até target.
+    void build(const Track& track, const Vector2& target)
+    {
+        cellsX = std::max(1, (int)std::ceil(track.getWorldWidth() / cellSize));
+        cellsY = std::max(1, (int)std::ceil(track.getWorldHeight() / cellSize));
+        walkable.resize(cellsX * cellsY);
+        for (int y = 0; y < cellsY; ++y) {
+            for (int x = 0; x < cellsX; ++x) {
+                walkable[y * cellsX + x] = track.signedDistance(Vector2((x + 0.5f) * cellSize, (y + 0.5f) * cellSize)) > 0.0f;
+            }
+        }
+        costs[0].assign(walkable.size(), FLOW_FIELD_UNREACHABLE);
+        costs[1].assign(walkable.size(), FLOW_FIELD_UNREACHABLE);
+        trackRevision = track.getRevision();
+        frontTarget = -1;
+        propagating = false;
+        targetPoint = target;
+
+        int cell = cellOf(target);
+        if (cell >= 0 && walkable[cell]) {
+            startPropagation(cell);
+            propagate((int)walkable.size());
+        }
+    }
+
+public:
+    FlowField() : cellSize(FLOW_FIELD_CELL_SIZE), cellsX(0), cellsY(0), trackRevision(0), front(0),
+                  frontTarget(-1), queued(0), currentCost(0), backTarget(-1), propagating(false) {}
+
+    // Chamado uma vez por quadro com a posição do tanque. Reconstrói a grade se a pista
+    // mudou; se o tanque mudou de célula, recalcula o campo (em fatias, ao longo dos quadros).
+    void update(const Track& track, const Vector2& target)
+    {
+        if (walkable.empty() || track.getRevision() != trackRevision) {
+            build(track, target);
+            return;
+        }
+        targetPoint = target;
+        int cell = cellOf(target);
+        if (!propagating && cell >= 0 && walkable[cell] && cell != frontTarget) {
+            startPropagation(cell);
+        }
+        if (propagating) {
+            propagate(FLOW_FIELD_CELLS_PER_UPDATE);
+        }
+    }
+
+    // Direção (normalizada) a seguir a partir de p para chegar ao tanque pela pista, ou
+    // (0, 0) se p está fora da pista ou em uma região sem caminho até o tanque.
+    Vector2 direction(const Vector2& p) const
+    {
+        int cell = cellOf(p);
+        if (cell < 0 || frontTarget < 0) return Vector2(0, 0);
+        const std::vector<unsigned>& field = costs[front];
+        if (field[cell] == FLOW_FIELD_UNREACHABLE) return Vector2(0, 0);
+        if (cell == frontTarget) return (targetPoint - p).normalizedSafe();
+
+        int best = cell;
+        unsigned bestCost = field[cell];
+        forEachNeighbor(cell, [&](int neighbor, unsigned) {
+            if (field[neighbor] < bestCost) {
+                bestCost = field[neighbor];
+                best = neighbor;
+            }
+        });
+        if (best == frontTarget) return (targetPoint - p).normalizedSafe();
+        return Vector2((float)(best % cellsX - cell % cellsX), (float)(best / cellsX - cell / cellsX)).normalizedSafe();
+    }
+
+    // Custo do caminho até o tanque a partir de p (em unidades de meia célula), ou
+    // FLOW_FIELD_UNREACHABLE.
+    unsigned costAt(const Vector2& p) const
+    {
+        int cell = cellOf(p);
+        if (cell < 0 || frontTarget < 0) return FLOW_FIELD_UNREACHABLE;
+        return costs[front][cell];
+    }
+
+    bool isRecalculating() const { return propagating; }
+};
+
+#endif
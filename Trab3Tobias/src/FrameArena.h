@@ -0,0 +1,159 @@
+// Este arquivo define a FrameArena, um alocador linear (bump allocator) para dados
+// temporários de um quadro (vértices montados no desenho, vetores auxiliares de uma
+// reconstrução), e o FrameAllocator, o adaptador para usá-la nos contêineres da STL.
+// Alocar é só avançar um ponteiro dentro do bloco atual; liberar não faz nada (exceto
+// devolver a última alocação, o que ajuda um vetor que cresce); reset() descarta tudo de
+// uma vez no início de cada quadro.
+// Quando um bloco enche, outro é alocado no heap; no reset, se o quadro usou mais de um
+// bloco, eles são trocados por um único bloco com a capacidade somada. Depois de alguns
+// quadros a arena tem o tamanho do pior quadro e não aloca mais nada.
+// Nada alocado na arena pode durar além do quadro. A arena compartilhada (shared) é
+// usada só pela thread principal: tarefas do JobSystem não devem alocar nela.
+#ifndef ___FRAME_ARENA__H___
+#define ___FRAME_ARENA__H___
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+#define FRAME_ARENA_INITIAL_CAPACITY (64 * 1024)
+
+class FrameArena
+{
+    struct Block {
+        char* data;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks;
+    std::size_t current; // bloco em uso
+    std::size_t offset;  // primeiro byte livre do bloco em uso
+    std::size_t lastOffset; // offset antes da última alocação (incluindo o seu alinhamento)
+    std::size_t used;    // bytes entregues no quadro (incluindo o alinhamento)
+    std::size_t peak;    // maior uso de um quadro
+
+    FrameArena(const FrameArena&);
+    FrameArena& operator=(const FrameArena&);
+
+    void addBlock(std::size_t size)
+    {
+        Block block;
+        block.data = new char[size];
+        block.size = size;
+        blocks.push_back(block);
+    }
+
+    void releaseBlocks()
+    {
+        for (auto& block : blocks) delete[] block.data;
+        blocks.clear();
+    }
+
+public:
+    explicit FrameArena(std::size_t initialCapacity = FRAME_ARENA_INITIAL_CAPACITY)
+        : current(0), offset(0), lastOffset(0), used(0), peak(0)
+    {
+        blocks.reserve(8);
+        addBlock(std::max<std::size_t>(initialCapacity, 1));
+    }
+
+    ~FrameArena() { releaseBlocks(); }
+
+    // Arena compartilhada pelo programa (thread principal), descartada a cada quadro.
+    static FrameArena& shared()
+    {
+        static FrameArena arena;
+        return arena;
+    }
+
+    // Reserva bytes com o alinhamento dado (potência de dois).
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+    {
+        for (;;) {
+            Block& block = blocks[current];
+            std::size_t start = (offset + alignment - 1) & ~(alignment - 1);
+            if (start + bytes <= block.size) {
+                used += start + bytes - offset;
+                lastOffset = offset;
+                offset = start + bytes;
+                return block.data + start;
+            }
+            // bloco cheio: passa para o próximo, criando um maior se necessário
+            if (current + 1 == blocks.size()) {
+                addBlock(std::max(block.size * 2, bytes + alignment));
+            }
+            current++;
+            offset = 0;
+        }
+    }
+
+    // Devolve a memória só se for a última alocação do bloco em uso (junto com o
+    // alinhamento que ela consumiu); senão, não faz nada.
+    void deallocate(void* pointer, std::size_t bytes)
+    {
+        char* p = static_cast<char*>(pointer);
+        if (p + bytes != blocks[current].data + offset) return;
+        // a última alocação volta até antes do seu alinhamento; uma anterior (já no fim
+        // depois de devolver a última) volta só os seus bytes
+        std::size_t rollback = offset - bytes >= lastOffset ? lastOffset : offset - bytes;
+        used -= offset - rollback;
+        offset = rollback;
+        lastOffset = rollback;
+    }
+
+    // Descarta tudo o que foi alocado desde o último reset (início de um quadro).
+    void reset()
+    {
+        peak = std::max(peak, used);
+        if (blocks.size() > 1) {
+            std::size_t total = 0;
+            for (const auto& block : blocks) total += block.size;
+            releaseBlocks();
+            addBlock(total);
+        }
+        current = 0;
+        offset = 0;
+        lastOffset = 0;
+        used = 0;
+    }
+
+    std::size_t getUsed() const { return used; }
+    std::size_t getPeak() const { return std::max(peak, used); }
+
+    std::size_t getCapacity() const
+    {
+        std::size_t total = 0;
+        for (const auto& block : blocks) total += block.size;
+        return total;
+    }
+};
+
+// Adaptador de alocador da STL sobre uma FrameArena (por padrão, a compartilhada).
+template <typename T>
+class FrameAllocator
+{
+    template <typename U> friend class FrameAllocator;
+    FrameArena* arena;
+
+public:
+    typedef T value_type;
+
+    FrameAllocator() : arena(&FrameArena::shared()) {}
+    explicit FrameAllocator(FrameArena& arena) : arena(&arena) {}
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T* p, std::size_t n) { arena->deallocate(p, n * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U>& other) const { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const FrameAllocator<U>& other) const { return arena != other.arena; }
+};
+
+// Vetor temporário de um quadro, alocado na arena compartilhada.
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T> >;
+
+#endif
@@ -4,19 +4,45 @@
 // de nível, fim de jogo). A classe Game é responsável por atualizar o estado
 // dos elementos do jogo, renderizá-los na tela e lidar com as interações
 // e regras do jogo.
+// A simulação (update) é separada do desenho (draw), de modo que o jogo pode
+// ser avançado sem janela, a um passo fixo (ver HeadlessDriver).
+// A simulação é determinística: usa um gerador próprio com semente (Random) e
+// avança em ticks de duração fixa; as entradas de cada tick podem ser gravadas
+// com o hash do estado (InputLog) para reprodução exata da partida.
+// O mundo tem o tamanho da pista, que pode ser várias telas; a câmera acompanha o tanque
+// e o desenho do mundo (cenário, pista, inimigos, projéteis e explosões) é recortado pela
+// área visível, enquanto a interface é desenhada em coordenadas da tela.
 #ifndef GAME_H_INCLUDED
 #define GAME_H_INCLUDED
 
 #include "gl_canvas2d.h"
 #include "Tank.h"
 #include "Enemies.h"
+#include "EnemyStore.h"
 #include "Track.h"
 #include "Scoreboard.h"
 #include "Levels.h"
+#include "SpatialHash.h"
+#include "Profiler.h"
+#include "Random.h"
+#include "InputLog.h"
+#include "SpawnPlacer.h"
+#include "FlowField.h"
+#include "Camera.h"
+#include "Background.h"
+#include "DecalLayer.h"
+#include "AudioMixer.h"
 #include <vector>
 #include <cstdlib>
-#include <sstream>
+#include <cstdio>
+#include <cstring>
 #include <cmath> 
+#include <stdint.h>
+
+#define GAME_TICK_RATE 60.0f
+#define GAME_MAX_TICKS_PER_FRAME 5
+#define ENEMY_SPAWN_SPACING 10.0f       // distância mínima entre as bordas de dois inimigos
+#define ENEMY_SPAWN_TANK_DISTANCE 100.0f // distância mínima entre um inimigo e o tanque
 
 class Game {
 public:
@@ -25,9 +51,20 @@ public:
 
 private:
     Tank *tanque;
-    std::vector<Enemy> enemies;
+    EnemyStore enemies;    // inimigos em arrays separados por tipo
+    SpatialHash enemyHash; // broadphase dos inimigos, reconstruída a cada quadro
+    TickProfile profile;   // tempo gasto por subsistema em update()
     Track track;
+    SpawnPlacer spawnPlacer; // área da pista disponível para os inimigos
+    FlowField flowField;     // caminho pela pista até o tanque, para os inimigos que o perseguem
     Scoreboard scoreboard;
+    Random rng;              // gerador da simulação (efeitos visuais usam rand())
+    uint32_t seed;
+    InputLogWriter recorder; // gravação das entradas, se ativada
+    Camera camera;           // área visível do mundo (acompanha o tanque)
+    Background* background;  // cenário desenhado sob a pista (nullptr sem janela)
+    DecalLayer decals;       // marcas persistentes sobre a pista (queimaduras, rastro das esteiras)
+    AudioMixer* audio;       // efeitos sonoros (pertence a quem cria o jogo; nullptr = sem som)
 
     int currentLevel;
     GameState gameState;
@@ -38,24 +75,46 @@ private:
     float currentTotalEnemyHealthForLevel;
 
     int screenWidth, screenHeight;
-    float currentFps;
+    float currentFps;     // taxa de ticks da simulação (o passo é 1 / currentFps)
+    float frameFps;       // taxa de quadros da janela, medida em main.cpp
+    float tickAccumulator;
     int currentMouseX, currentMouseY, currentIsPressed, currentKey;
 
     // Verifica se o tanque foi destruído e transiciona para o estado GAME_OVER.
     void checkAndTransitionToGameOver() {
         if (tanque && tanque->isDestroyed() && gameState != GameState::GAME_OVER) {
             gameState = GameState::GAME_OVER;
-            
-            
-            
+            recorder.flush();
         }
     }
 
+    // Reconstrói a SpatialHash dos inimigos. O handle de cada inimigo é seu índice em
+    // enemies, por isso inimigos destruídos só são removidos no fim do quadro.
+    void rebuildEnemyHash() {
+        enemies.rebuildHash(enemyHash, currentFps);
+    }
+
+    // Cria o tanque (na parte de baixo da pista padrão), posiciona a câmera, prepara a
+    // camada de marcas e gera os inimigos do primeiro nível.
+    void start() {
+        tanque = new Tank(TANK_DEFAULT_HEIGHT, TANK_DEFAULT_WIDTH, track.getWorldWidth() / 2.0f, screenHeight / 4.0f);
+        decals.sync(track);
+        tanque->decals = &decals;
+        camera = Camera((float)track.getWorldWidth(), (float)track.getWorldHeight(), (float)screenWidth, (float)screenHeight);
+        camera.lookAt(tanque->pivot);
+        buildSpawnPlacer();
+        generateEnemies();
+    }
+
 public:
     // Construtor da classe Game (com pista padrão).
-    Game(int sw, int sh)
+    Game(int sw, int sh, uint32_t seed = 1)
         : track(sw, sh, sw / 2.0f, sh / 2.0f, sh / 5.0f, sh / 2.0f, 10),
           scoreboard(),
+          rng(seed),
+          seed(seed),
+          background(nullptr),
+          audio(nullptr),
           currentLevel(1),
           gameState(GameState::PLAYING),
           levelTransitionTimer(0.0f),
@@ -63,17 +122,22 @@ public:
           currentTotalEnemyHealthForLevel(0.0f), 
           screenWidth(sw),
           screenHeight(sh),
-          currentFps(60.0f),
+          currentFps(GAME_TICK_RATE),
+          frameFps(GAME_TICK_RATE),
+          tickAccumulator(0.0f),
           currentMouseX(0), currentMouseY(0), currentIsPressed(0), currentKey(-1)
     {
-        tanque = new Tank(100, 80, screenWidth / 2.0f, screenHeight / 2.0f - screenHeight / 4.0f);
-        generateEnemies();
+        start();
     }
 
     // Construtor da classe Game (com pista existente).
-    Game(int sw, int sh, const Track& existingTrack)
+    Game(int sw, int sh, const Track& existingTrack, uint32_t seed = 1)
         : track(existingTrack), 
           scoreboard(),
+          rng(seed),
+          seed(seed),
+          background(nullptr),
+          audio(nullptr),
           currentLevel(1),
           gameState(GameState::PLAYING),
           levelTransitionTimer(0.0f),
@@ -81,11 +145,12 @@ public:
           currentTotalEnemyHealthForLevel(0.0f),
           screenWidth(sw),
           screenHeight(sh),
-          currentFps(60.0f),
+          currentFps(GAME_TICK_RATE),
+          frameFps(GAME_TICK_RATE),
+          tickAccumulator(0.0f),
           currentMouseX(0), currentMouseY(0), currentIsPressed(0), currentKey(-1)
     {
-        tanque = new Tank(100, 80, screenWidth / 2.0f, screenHeight / 2.0f - screenHeight / 4.0f);
-        generateEnemies();
+        start();
     }
 
     // Destrutor da classe Game.
@@ -93,74 +158,190 @@ public:
         delete tanque;
     }
 
-    // Atualiza os inputs (mouse, teclado, fps) recebidos da classe Tela.
+    // Atualiza os inputs (mouse, teclado, fps da janela) recebidos da classe Tela.
     void updateInputs(float fps, int mouseX, int mouseY, int isPressed, int key) {
-        this->currentFps = fps;
+        this->frameFps = fps;
         this->currentMouseX = mouseX;
         this->currentMouseY = mouseY;
         this->currentIsPressed = isPressed;
         this->currentKey = key;
     }
 
-    // Renderiza todos os elementos do jogo.
-    void render() {
-        track.renderTrack();
+    // Avança a simulação em um tick (1 / fps segundos), sem desenhar nada.
+    // Pode ser chamado sem janela (modo headless).
+    void update() {
+        ScopedTimer totalTimer(profile.total);
+        ScopedAllocationCount allocationCount(profile.allocations);
+        profile.ticks++;
+        decals.sync(track); // pista editada: as marcas antigas são apagadas
         updateLevelLogic(); 
 
+        if (track.arePointsVisible()) {
+            return;
+        }
+        if (gameState == GameState::PLAYING) {
+            {
+                ScopedTimer timer(profile.enemyHash);
+                rebuildEnemyHash();
+            }
+            if (tanque) {
+                updateTank(); 
+            }
+            checkAndTransitionToGameOver(); 
+            
+            updateEnemies(); 
+            checkAndTransitionToGameOver(); 
+        } else if (gameState == GameState::LEVEL_TRANSITION) {
+            enemies.updateHealthBars(currentFps);
+        } else if (gameState == GameState::GAME_OVER) {
+            rebuildEnemyHash();
+            updateEnemies(); 
+            if (tanque) {
+                ScopedTimer timer(profile.explosions);
+                tanque->updateExplosions(currentFps); 
+            }
+        }
+        // a câmera faz parte da simulação: a mira do próximo tick usa a área que foi desenhada
+        if (tanque) camera.lookAt(tanque->pivot);
+    }
+
+    // Desenha o estado atual do jogo (não altera a simulação): o mundo pela câmera, só o
+    // que cruza a área visível, e depois a interface em coordenadas da tela.
+    void draw() {
+        float minX = camera.getMinX(), minY = camera.getMinY(), maxX = camera.getMaxX(), maxY = camera.getMaxY();
+        Vector2 aim = camera.screenToWorld((float)currentMouseX, (float)currentMouseY);
+        camera.begin();
+        if (background) background->draw(screenWidth, screenHeight, track, camera);
+        track.renderTrack(minX, minY, maxX, maxY);
+        decals.draw(minX, minY, maxX, maxY);
+
         if (!track.arePointsVisible()) { 
             if (gameState == GameState::PLAYING) {
-                if (tanque) {
-                    tanqueManager(); 
-                }
-                checkAndTransitionToGameOver(); 
-                
-                updateAndDrawEnemies(); 
-                checkAndTransitionToGameOver(); 
-            } else if (gameState == GameState::LEVEL_TRANSITION) {
-                
-                updateAndDrawEnemies(); 
-
-                
-                if (tanque) {
+                if (tanque && !tanque->isDestroyed()) {
+                    tanque->renderer.drawParticles(minX, minY, maxX, maxY);
                     tanque->renderer.desenhaDetalhado();
-                    tanque->renderer.desenhaTorre(currentMouseX, currentMouseY);
+                    tanque->renderer.drawNitroEffects();
+                    tanque->renderer.desenhaTorre(aim.x, aim.y);
                     tanque->renderer.drawHealthBar();
-                    tanque->renderer.drawProjectiles(); 
-                    
-                    
-                    tanque->renderer.drawExplosions();
+                    tanque->renderer.drawProjectiles(minX, minY, maxX, maxY);
+                    tanque->renderer.drawExplosions(minX, minY, maxX, maxY);
                 }
-            } else if (gameState == GameState::GAME_OVER) {
-                
-                
-                updateAndDrawEnemies(); 
-
-                
-                
+                enemies.draw(enemyHash, minX, minY, maxX, maxY);
+            } else {
+                enemies.draw(enemyHash, minX, minY, maxX, maxY);
                 if (tanque) {
-                    tanque->updateExplosions(currentFps); 
-
-                    
+                    tanque->renderer.drawParticles(minX, minY, maxX, maxY);
                     tanque->renderer.desenhaDetalhado(); 
-                    tanque->renderer.desenhaTorre(currentMouseX, currentMouseY); 
+                    tanque->renderer.desenhaTorre(aim.x, aim.y); 
                     tanque->renderer.drawHealthBar();    
-                    tanque->renderer.drawProjectiles();  
-                    tanque->renderer.drawExplosions();   
+                    tanque->renderer.drawProjectiles(minX, minY, maxX, maxY);  
+                    tanque->renderer.drawExplosions(minX, minY, maxX, maxY);   
                 }
             }
         } else { 
-            for (auto& enemy : enemies) {
-                enemy.draw();
-            }
+            enemies.draw();
             if(tanque) tanque->renderer.desenhaDetalhado(); 
         }
+        Camera::end();
 
         scoreboard.draw(screenWidth, screenHeight);
         drawGameUI(); 
     }
 
-    // Gerencia a lógica de atualização e desenho do tanque.
-    void tanqueManager() {
+    // Executa um tick da simulação e, se a gravação estiver ativa, registra a entrada
+    // usada e o hash do estado resultante. O relógio do áudio avança um tick: os sons
+    // gerados nele podem ser mixados.
+    void tick() {
+        update();
+        if (recorder.isOpen()) {
+            recorder.write(TickInput(currentKey, currentMouseX, currentMouseY, currentIsPressed), stateHash());
+        }
+        if (audio) audio->advance(1.0f / currentFps);
+    }
+
+    // Atualiza e desenha o jogo (um quadro da janela). A simulação avança em ticks
+    // fixos, quantos couberem no tempo do quadro (até GAME_MAX_TICKS_PER_FRAME).
+    // Os dados temporários do quadro ficam na FrameArena, descartada pela Tela a cada quadro.
+    void render() {
+        float tickDuration = 1.0f / currentFps;
+        tickAccumulator += 1.0f / std::max(frameFps, 1.0f);
+        int ticks = 0;
+        while (tickAccumulator >= tickDuration && ticks < GAME_MAX_TICKS_PER_FRAME) {
+            tickAccumulator -= tickDuration;
+            tick();
+            ticks++;
+        }
+        if (ticks == GAME_MAX_TICKS_PER_FRAME) {
+            tickAccumulator = 0.0f;
+        }
+        draw();
+    }
+
+    // Hash do estado da simulação (nível, placar, gerador, tanque, projéteis e inimigos).
+    uint32_t stateHash() const {
+        StateHash h;
+        h.add(currentLevel);
+        h.add((int)gameState);
+        h.add(scoreboard.getScore());
+        h.add(levelTransitionTimer);
+        h.add((uint64_t)rng.getState());
+        if (tanque) {
+            h.add(tanque->pivot);
+            h.add(tanque->direction);
+            h.add(tanque->health);
+            h.add(tanque->currentSpeed);
+            h.add(tanque->cooldownTimer);
+            h.add(tanque->pushBackTimer);
+            h.add(tanque->explosions.size());
+            h.add(tanque->projectiles.size());
+            for (int i = 0; i < tanque->projectiles.size(); ++i) {
+                h.add(tanque->projectiles.getPosition(i));
+            }
+        }
+        h.add(enemies.size());
+        for (const auto& enemy : enemies) {
+            h.add(enemy.position);
+            h.add(enemy.health);
+            h.add(enemy.level);
+            h.add((int)enemy.starMode);
+        }
+        return h.value();
+    }
+
+    // Começa a gravar as entradas desta partida em path. Retorna false se o arquivo não pôde ser criado.
+    bool startRecording(const char* path) {
+        ReplayHeader header;
+        header.seed = seed;
+        header.tickRate = currentFps;
+        header.screenWidth = screenWidth;
+        header.screenHeight = screenHeight;
+        header.worldWidth = track.getWorldWidth();
+        header.worldHeight = track.getWorldHeight();
+        header.innerControlPoints = track.getInnerControlPoints();
+        header.outerControlPoints = track.getOuterControlPoints();
+        return recorder.open(path, header);
+    }
+
+    // Define o cenário desenhado sob a pista (o cenário pertence à Tela e é compartilhado
+    // com o menu e o editor).
+    void setBackground(Background* sceneBackground) {
+        background = sceneBackground;
+    }
+
+    // Define o mixer que toca os efeitos sonoros da partida (nullptr = sem som). O mixer
+    // pertence a quem cria o jogo e é compartilhado pelas partidas seguintes.
+    void setAudio(AudioMixer* mixer) {
+        audio = mixer;
+        if (tanque) tanque->audio = mixer;
+    }
+
+    // Define a taxa de ticks da simulação (ticks por segundo).
+    void setTickRate(float rate) {
+        currentFps = rate;
+    }
+
+    // Atualiza o tanque: habilidades, movimento, projéteis, explosões, rotação e disparo.
+    void updateTank() {
         
         if (!tanque || tanque->isDestroyed() || gameState != GameState::PLAYING) {
             return; 
@@ -172,96 +353,72 @@ public:
         bool wantsSuperBurst = (this->currentKey == 'e' || this->currentKey == 'E');
         bool wantsShield = (this->currentKey == 's' || this->currentKey == 'S');
 
-        tanque->updateNitro(currentFps, wantsNitro);
-        tanque->updateRapidFire(currentFps, wantsRapidFire);
-        tanque->updateSuperBurst(currentFps, wantsSuperBurst);
-        tanque->updateShield(currentFps, wantsShield);
-
-        tanque->move(currentFps, track, enemies); 
-        tanque->updateProjectiles(currentFps, track, enemies); 
-        tanque->updateExplosions(currentFps);
+        {
+            ScopedTimer timer(profile.tank);
+            tanque->updateNitro(currentFps, wantsNitro);
+            tanque->updateRapidFire(currentFps, wantsRapidFire);
+            tanque->updateSuperBurst(currentFps, wantsSuperBurst);
+            tanque->updateShield(currentFps, wantsShield);
 
-        
-        tanque->renderer.desenhaDetalhado();
-        tanque->renderer.drawNitroEffects();
-        tanque->renderer.desenhaTorre(currentMouseX, currentMouseY);
-        tanque->renderer.drawHealthBar();
+            tanque->move(currentFps, track, enemies, enemyHash); 
+        }
+        {
+            ScopedTimer timer(profile.projectiles);
+            tanque->updateProjectiles(currentFps, track, enemies, enemyHash); 
+        }
+        {
+            ScopedTimer timer(profile.explosions);
+            tanque->updateExplosions(currentFps);
+        }
 
+        ScopedTimer timer(profile.tank);
         if (tanque->pushBackTimer <= 0.0f) {
             if (this->currentKey == 'a' || this->currentKey == 'A') {
-                tanque->rotateDirection(-0.1f, currentFps, track, enemies);
+                tanque->rotateDirection(-0.1f, currentFps, track, enemies, enemyHash);
             } else if (this->currentKey == 'd' || this->currentKey == 'D') {
-                tanque->rotateDirection(0.1f, currentFps, track, enemies);
+                tanque->rotateDirection(0.1f, currentFps, track, enemies, enemyHash);
             }
         }
 
         if (currentIsPressed == 1) { 
-            tanque->shoot(currentFps, currentMouseX, currentMouseY);
+            Vector2 aim = camera.screenToWorld((float)currentMouseX, (float)currentMouseY);
+            tanque->shoot(currentFps, aim.x, aim.y);
         }
-        tanque->renderer.drawProjectiles();
-        tanque->renderer.drawExplosions();
-        
     }
 
-    // Atualiza a lógica dos inimigos, processa destruições e os desenha.
-    void updateAndDrawEnemies() {
-        
-        if (gameState == GameState::LEVEL_TRANSITION) {
-            for (auto& enemy : enemies) {
-                enemy.updateHealthBarDisplay(currentFps); 
-                enemy.draw(); 
-            }
-            return;
-        }
-
-        
-        bool allEnemiesEffectivelyClearedForLevel = (gameState == GameState::PLAYING); 
-
-        for (auto it = enemies.begin(); it != enemies.end(); ) {
-            
-            it->updateHealthBarDisplay(currentFps);
-
-            
-            
-            
-            
-            if (it->level == 2) { 
-                it->updateActivatedStar(currentFps, track, enemies, tanque);
-            } else if (it->level == 4) { 
-                it->updatePlaneSpecifics(currentFps, track, tanque);
-            }
-            
-
-            
-            
-            if (gameState == GameState::PLAYING && it->isDestroyed()) {
-                scoreboard.addScore(it->getScoreValue());
-                currentTotalEnemyHealthForLevel -= Enemy::getHealthContribution(it->level);
+    // Atualiza a lógica dos inimigos e processa as destruições.
+    void updateEnemies() {
+        ScopedTimer timer(profile.enemies);
+
+        // Primeiro atualiza todos os inimigos (um laço por tipo); os índices (handles da
+        // SpatialHash) continuam válidos porque nenhum inimigo é removido durante a atualização.
+        // O campo de fluxo até o tanque é atualizado antes (uma vez por quadro, para todos).
+        if (tanque) flowField.update(track, tanque->pivot);
+        enemies.update(currentFps, track, flowField, enemyHash, tanque, rng);
+
+        // Depois processa as destruições e remove os inimigos destruídos no fim do quadro.
+        if (gameState == GameState::PLAYING) {
+            int enemiesBefore = enemies.size();
+            enemies.removeDestroyed([&](const Enemy& enemy) {
+                scoreboard.addScore(enemy.getScoreValue());
+                currentTotalEnemyHealthForLevel -= Enemy::getHealthContribution(enemy.level);
                 if (currentTotalEnemyHealthForLevel < 0.0f) currentTotalEnemyHealthForLevel = 0.0f;
 
-                if (it->level == 3) { 
+                if (enemy.level == 3) { 
                     float shrapnelSpeed = 180.0f; float shrapnelDamage = 3.0f;
                     float shrapnelW = 5.0f; float shrapnelH = 10.0f;
-                    std::vector<Projectile> newShrapnels = it->generateShrapnel(shrapnelSpeed, shrapnelDamage, shrapnelW, shrapnelH);
                     if (tanque) { 
-                        tanque->projectiles.insert(tanque->projectiles.end(), newShrapnels.begin(), newShrapnels.end());
+                        enemy.generateShrapnel(tanque->projectiles, shrapnelSpeed, shrapnelDamage, shrapnelW, shrapnelH);
                     }
                 }
-                it = enemies.erase(it); 
-            } else {
-                
-                
-                if (gameState == GameState::PLAYING) { 
-                     allEnemiesEffectivelyClearedForLevel = false;
-                }
-                it->draw(); 
-                ++it;
-            }
+            });
+            // o desenho consulta a SpatialHash pelos índices atuais
+            if (enemies.size() != enemiesBefore) rebuildEnemyHash();
         }
 
         
         
-        if (gameState == GameState::PLAYING && allEnemiesEffectivelyClearedForLevel && enemies.empty()) {
+        if (gameState == GameState::PLAYING && enemies.empty()) {
             startNextLevelTransition();
         }
     }
@@ -282,6 +439,7 @@ public:
                 }
             } else {
                 currentLevel++;
+                decals.clear();
                 
                 gameState = GameState::PLAYING;
                 generateEnemies();
@@ -289,6 +447,20 @@ public:
         }
     }
 
+    // Folga mínima de pista ao redor de um inimigo do nível dado, ao ser posicionado.
+    static float getSpawnClearance(int enemyLevel) {
+        return (enemyLevel == 1) ? 10.0f : (enemyLevel == 2) ? 15.0f : 20.0f;
+    }
+
+    // Rasteriza a área da pista disponível para os inimigos (uma vez por partida).
+    void buildSpawnPlacer() {
+        float maxRadius = 0.0f;
+        for (int level = 1; level <= 4; ++level) {
+            maxRadius = std::max(maxRadius, Enemy::getSizeForLevel(level));
+        }
+        spawnPlacer.build(track, track.getWorldWidth(), track.getWorldHeight(), maxRadius + getSpawnClearance(4) + ENEMY_SPAWN_SPACING);
+    }
+
     // Gera os inimigos para o nível atual.
     void generateEnemies() {
         
@@ -297,50 +469,24 @@ public:
         currentTotalEnemyHealthForLevel = 0.0f; 
 
         LevelConfig currentLevelConfig = getLevelConfiguration(currentLevel);
-        int maxAttemptsPerEnemy = 200;
+        Vector2 tankPosition = tanque ? tanque->pivot : Vector2(-1e6f, -1e6f);
+        spawnPlacer.reset();
 
         for (const auto &spawnInfo : currentLevelConfig.enemySpawns) {
+            float clearance = getSpawnClearance(spawnInfo.enemyLevel);
+            float radius = Enemy::getSizeForLevel(spawnInfo.enemyLevel);
             for (int i = 0; i < spawnInfo.count; ++i) {
-                int attempts = 0;
-                bool placed = false;
-                while (!placed && attempts < maxAttemptsPerEnemy) {
-                    float x = static_cast<float>(rand() % screenWidth);
-                    float y = static_cast<float>(rand() % screenHeight);
-                    Vector2 randomPos(x, y);
-                    float enemySizeForCheck = (spawnInfo.enemyLevel == 1) ? 10.0f : (spawnInfo.enemyLevel == 2) ? 15.0f : 20.0f;
-
-                    bool centerInTrack = track.isPointInsideTrack(randomPos);
-                    bool topInTrack = track.isPointInsideTrack(Vector2(randomPos.x, randomPos.y - enemySizeForCheck));
-                    bool bottomInTrack = track.isPointInsideTrack(Vector2(randomPos.x, randomPos.y + enemySizeForCheck));
-                    bool leftInTrack = track.isPointInsideTrack(Vector2(randomPos.x - enemySizeForCheck, randomPos.y));
-                    bool rightInTrack = track.isPointInsideTrack(Vector2(randomPos.x + enemySizeForCheck, randomPos.y));
-
-                    if (centerInTrack && topInTrack && bottomInTrack && leftInTrack && rightInTrack) {
-                        bool tooClose = false;
-                        float minDistanceToTank = 100.0f;
-                        if (tanque && (randomPos - tanque->pivot).length() < (minDistanceToTank + enemySizeForCheck)) {
-                            tooClose = true;
-                        }
-                        if (!tooClose) {
-                            for (const auto &existingEnemy : enemies) {
-                                if ((randomPos - existingEnemy.position).length() < (existingEnemy.size + enemySizeForCheck + 10.0f)) {
-                                    tooClose = true;
-                                    break;
-                                }
-                            }
-                        }
-                        if (!tooClose) {
-                            enemies.push_back(Enemy(randomPos, spawnInfo.enemyLevel));
-                            
-                            initialTotalEnemyHealthForLevel += Enemy::getHealthContribution(spawnInfo.enemyLevel);
-                            placed = true;
-                        }
-                    }
-                    attempts++;
+                Vector2 pos;
+                if (!spawnPlacer.place(clearance, radius, ENEMY_SPAWN_SPACING,
+                                       tankPosition, ENEMY_SPAWN_TANK_DISTANCE, rng, pos)) {
+                    break; // não há mais espaço na pista para este tipo
                 }
+                enemies.spawn(pos, spawnInfo.enemyLevel, rng);
+                initialTotalEnemyHealthForLevel += Enemy::getHealthContribution(spawnInfo.enemyLevel);
             }
         }
         currentTotalEnemyHealthForLevel = initialTotalEnemyHealthForLevel; 
+        rebuildEnemyHash(); // para o desenho antes do próximo tick
     }
 
     // Desenha a interface do usuário do jogo (habilidades, nível, barra de progresso, mensagens).
@@ -361,10 +507,10 @@ public:
         float progressBarY = levelTextY - progressBarHeight - 5; 
         float progressBarWidth = 200.0f;
 
-        std::ostringstream levelTextStr;
-        levelTextStr << "Level " << currentLevel;
+        char levelText[32];
+        snprintf(levelText, sizeof(levelText), "Level %d", currentLevel);
         CV::color(1.0f, 1.0f, 1.0f);
-        CV::textStroke(uiMargin, levelTextY, levelTextStr.str().c_str(), 0.15f, 1.8f);
+        CV::textStroke(uiMargin, levelTextY, levelText, 0.15f, 1.8f);
 
         
         if (initialTotalEnemyHealthForLevel > 0) {
@@ -393,37 +539,38 @@ public:
 
         
         if (gameState == GameState::LEVEL_TRANSITION) {
-            std::ostringstream countdownText;
-            countdownText << "Level " << (currentLevel + 1) << " em " << static_cast<int>(ceil(levelTransitionTimer)) << "...";
+            char countdownText[48];
+            snprintf(countdownText, sizeof(countdownText), "Level %d em %d...", currentLevel + 1, static_cast<int>(ceil(levelTransitionTimer)));
             CV::color(1.0f, 1.0f, 0.0f);
             float countdownX = screenWidth / 2.0f - 150;
             float countdownY = screenHeight / 2.0f;
-            CV::textStroke(countdownX, countdownY, countdownText.str().c_str(), 0.25f, 2.5f);
+            CV::textStroke(countdownX, countdownY, countdownText, 0.25f, 2.5f);
         } else if (gameState == GameState::GAME_OVER) {
             CV::color(1.0f, 0.0f, 0.0f); 
-            std::string gameOverMsg = "GAME OVER";
+            const char* gameOverMsg = "GAME OVER";
             
             
             float gameOverCharWidthFactor = 18.0f; 
-            float msgX = screenWidth / 2.0f - (gameOverMsg.length() * gameOverCharWidthFactor);
+            float msgX = screenWidth / 2.0f - (strlen(gameOverMsg) * gameOverCharWidthFactor);
             float msgY = screenHeight / 2.0f - 50;
-            CV::textStroke(msgX, msgY, gameOverMsg.c_str(), 0.4f, 3.0f);
+            CV::textStroke(msgX, msgY, gameOverMsg, 0.4f, 3.0f);
 
-            std::string scoreMsg = "Final Score: " + std::to_string(scoreboard.getScore());
+            char scoreMsg[48];
+            int scoreMsgLength = snprintf(scoreMsg, sizeof(scoreMsg), "Final Score: %d", scoreboard.getScore());
             
             
             float scoreCharWidthFactor = 7.5f; 
-            float scoreMsgX = screenWidth / 2.0f - (scoreMsg.length() * scoreCharWidthFactor);
+            float scoreMsgX = screenWidth / 2.0f - (scoreMsgLength * scoreCharWidthFactor);
             float scoreMsgY = screenHeight / 2.0f + 10;
-            CV::textStroke(scoreMsgX, scoreMsgY, scoreMsg.c_str(), 0.2f, 2.0f);
+            CV::textStroke(scoreMsgX, scoreMsgY, scoreMsg, 0.2f, 2.0f);
             
-            std::string returnMsg = "Pressione ESC para voltar ao Menu";
+            const char* returnMsg = "Pressione ESC para voltar ao Menu";
             
             
             float returnCharWidthFactor = 5.6f; 
-            float returnMsgX = screenWidth / 2.0f - (returnMsg.length() * returnCharWidthFactor);
+            float returnMsgX = screenWidth / 2.0f - (strlen(returnMsg) * returnCharWidthFactor);
             float returnMsgY = screenHeight / 2.0f + 50;
-            CV::textStroke(returnMsgX, returnMsgY, returnMsg.c_str(), 0.15f, 2.0f);
+            CV::textStroke(returnMsgX, returnMsgY, returnMsg, 0.15f, 2.0f);
         }
     }
 
@@ -447,6 +594,14 @@ public:
     
     // Retorna o estado atual do jogo.
     GameState getCurrentGameState() const { return gameState; }
+
+    // Acesso ao estado da simulação para o modo headless e o benchmark.
+    Tank* getTank() { return tanque; }
+    EnemyStore& getEnemies() { return enemies; }
+    const Track& getTrack() const { return track; }
+    const Camera& getCamera() const { return camera; }
+    TickProfile& getProfile() { return profile; }
+    Random& getRandom() { return rng; }
 };
 
 #endif // GAME_H_INCLUDED
\ No newline at end of file
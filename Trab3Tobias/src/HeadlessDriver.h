@@ -0,0 +1,62 @@
+// Este arquivo define o HeadlessDriver, que avança um Game sem janela nem OpenGL.
+// Cada tick recebe uma entrada (tecla, posição do mouse e botão) e chama apenas
+// Game::tick (simulação, sem desenho), com um passo de tempo fixo. As entradas
+// podem vir de um roteiro (vetor de TickInput), de uma partida gravada ou ser
+// geradas aleatoriamente, imitando um jogador que dirige, gira, usa as habilidades e atira.
+// Cada tick é um quadro: a FrameArena compartilhada é descartada antes dele.
+#ifndef ___HEADLESS_DRIVER__H___
+#define ___HEADLESS_DRIVER__H___
+
+#include <vector>
+#include <cstdlib>
+#include "Game.h"
+#include "InputLog.h"
+#include "FrameArena.h"
+
+class HeadlessDriver
+{
+    Game& game;
+    float fixedDt;
+    long tickCount;
+
+public:
+    HeadlessDriver(Game& game, float fixedDt = 1.0f / GAME_TICK_RATE) : game(game), fixedDt(fixedDt), tickCount(0)
+    {
+        game.setTickRate(1.0f / fixedDt);
+    }
+
+    // Avança a simulação em um tick com a entrada dada.
+    void step(const TickInput& input)
+    {
+        FrameArena::shared().reset();
+        game.updateInputs(1.0f / fixedDt, input.mouseX, input.mouseY, input.button, input.key);
+        game.tick();
+        tickCount++;
+    }
+
+    // Executa um roteiro de entradas, um tick por entrada.
+    void run(const std::vector<TickInput>& script)
+    {
+        for (const auto& input : script) {
+            step(input);
+        }
+    }
+
+    // Gera uma entrada aleatória: teclas de movimento e habilidades, mouse em qualquer
+    // ponto da tela e botão esquerdo pressionado na maior parte do tempo.
+    static TickInput randomInput(int screenWidth, int screenHeight)
+    {
+        static const int keys[] = { -1, -1, 'w', 'a', 'd', 'q', 'e', 's' };
+        TickInput input;
+        input.key = keys[rand() % 8];
+        input.mouseX = rand() % screenWidth;
+        input.mouseY = rand() % screenHeight;
+        input.button = (rand() % 4 != 0) ? 1 : 0;
+        return input;
+    }
+
+    long getTickCount() const { return tickCount; }
+    float getFixedDt() const { return fixedDt; }
+};
+
+#endif
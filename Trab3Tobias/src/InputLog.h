@@ -0,0 +1,188 @@
+// Este arquivo define o registro binário de entradas de uma partida (gravação para replay).
+// O arquivo contém um cabeçalho com tudo o que define a partida além das entradas
+// (semente do gerador, taxa de ticks, dimensões da tela e do mundo e pontos de controle
+// da pista),
+// seguido de um registro de 11 bytes por tick:
+//   tecla (int16), mouse x (int16), mouse y (int16), botão (uint8), hash do estado (uint32).
+// O hash do estado após cada tick permite que o replay detecte o primeiro tick em que
+// a simulação reproduzida diverge da original.
+// Os valores são gravados no formato nativo (little-endian nas plataformas suportadas).
+// A versão 1 não tem as dimensões do mundo (o mundo era a tela) e continua sendo lida.
+#ifndef ___INPUT_LOG__H___
+#define ___INPUT_LOG__H___
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <stdint.h>
+#include "Vector2.h"
+
+#define INPUT_LOG_MAGIC "T3IL"
+#define INPUT_LOG_VERSION 2
+
+// Entrada de um tick, nos mesmos formatos recebidos de main.cpp.
+struct TickInput
+{
+    int key;      // -1 = nenhuma tecla
+    int mouseX, mouseY;
+    int button;   // 0 = nenhum, 1 = esquerdo, 2 = direito
+
+    TickInput() : key(-1), mouseX(0), mouseY(0), button(0) {}
+    TickInput(int key, int mouseX, int mouseY, int button) : key(key), mouseX(mouseX), mouseY(mouseY), button(button) {}
+};
+
+// Dados que, junto com as entradas, determinam a partida.
+struct ReplayHeader
+{
+    uint32_t seed;
+    float tickRate;
+    int32_t screenWidth, screenHeight; // a tela define a área visível (e a conversão do mouse)
+    int32_t worldWidth, worldHeight;
+    std::vector<Vector2> innerControlPoints;
+    std::vector<Vector2> outerControlPoints;
+};
+
+struct ReplayTick
+{
+    TickInput input;
+    uint32_t stateHash;
+};
+
+// Hash FNV-1a incremental usado para resumir o estado da simulação.
+class StateHash
+{
+    uint32_t hash;
+
+public:
+    StateHash() : hash(2166136261u) {}
+
+    void add(const void* data, size_t size)
+    {
+        const unsigned char* bytes = (const unsigned char*)data;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 16777619u;
+        }
+    }
+
+    void add(int value) { add(&value, sizeof(value)); }
+    void add(float value) { add(&value, sizeof(value)); }
+    void add(uint64_t value) { add(&value, sizeof(value)); }
+    void add(const Vector2& v) { add(v.x); add(v.y); }
+
+    uint32_t value() const { return hash; }
+};
+
+// Grava uma partida tick a tick (o arquivo é escrito à medida que o jogo avança).
+class InputLogWriter
+{
+    FILE* file;
+
+    template <typename T>
+    void put(T value) { fwrite(&value, sizeof(T), 1, file); }
+
+    void putPoints(const std::vector<Vector2>& points)
+    {
+        put<uint32_t>((uint32_t)points.size());
+        for (const auto& p : points) {
+            put<float>(p.x);
+            put<float>(p.y);
+        }
+    }
+
+public:
+    InputLogWriter() : file(nullptr) {}
+    ~InputLogWriter() { close(); }
+
+    // Cria o arquivo e grava o cabeçalho. Retorna false se não foi possível criá-lo.
+    bool open(const char* path, const ReplayHeader& header)
+    {
+        close();
+        file = fopen(path, "wb");
+        if (!file) return false;
+        fwrite(INPUT_LOG_MAGIC, 1, 4, file);
+        put<uint16_t>(INPUT_LOG_VERSION);
+        put<uint32_t>(header.seed);
+        put<float>(header.tickRate);
+        put<int32_t>(header.screenWidth);
+        put<int32_t>(header.screenHeight);
+        put<int32_t>(header.worldWidth);
+        put<int32_t>(header.worldHeight);
+        putPoints(header.innerControlPoints);
+        putPoints(header.outerControlPoints);
+        return true;
+    }
+
+    void write(const TickInput& input, uint32_t stateHash)
+    {
+        if (!file) return;
+        put<int16_t>((int16_t)input.key);
+        put<int16_t>((int16_t)input.mouseX);
+        put<int16_t>((int16_t)input.mouseY);
+        put<uint8_t>((uint8_t)input.button);
+        put<uint32_t>(stateHash);
+    }
+
+    void flush() { if (file) fflush(file); }
+
+    void close()
+    {
+        if (file) fclose(file);
+        file = nullptr;
+    }
+
+    bool isOpen() const { return file != nullptr; }
+};
+
+class InputLog
+{
+    template <typename T>
+    static bool get(FILE* file, T& value) { return fread(&value, sizeof(T), 1, file) == 1; }
+
+    static bool getPoints(FILE* file, std::vector<Vector2>& points)
+    {
+        uint32_t count;
+        if (!get(file, count) || count > 100000) return false;
+        points.resize(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            if (!get(file, points[i].x) || !get(file, points[i].y)) return false;
+        }
+        return true;
+    }
+
+public:
+    // Lê uma partida gravada. Retorna false se o arquivo não existir ou estiver corrompido;
+    // um último tick incompleto (gravação interrompida) é descartado.
+    static bool load(const char* path, ReplayHeader& header, std::vector<ReplayTick>& ticks)
+    {
+        FILE* file = fopen(path, "rb");
+        if (!file) return false;
+
+        char magic[4];
+        uint16_t version;
+        bool ok = fread(magic, 1, 4, file) == 4 && memcmp(magic, INPUT_LOG_MAGIC, 4) == 0
+               && get(file, version) && (version == 1 || version == INPUT_LOG_VERSION)
+               && get(file, header.seed) && get(file, header.tickRate)
+               && get(file, header.screenWidth) && get(file, header.screenHeight);
+        header.worldWidth = header.screenWidth;
+        header.worldHeight = header.screenHeight;
+        ok = ok && (version == 1 || (get(file, header.worldWidth) && get(file, header.worldHeight)))
+               && getPoints(file, header.innerControlPoints) && getPoints(file, header.outerControlPoints);
+
+        ticks.clear();
+        while (ok) {
+            int16_t key, mouseX, mouseY;
+            uint8_t button;
+            ReplayTick tick;
+            if (!get(file, key) || !get(file, mouseX) || !get(file, mouseY) || !get(file, button) || !get(file, tick.stateHash)) {
+                break;
+            }
+            tick.input = TickInput(key, mouseX, mouseY, button);
+            ticks.push_back(tick);
+        }
+        fclose(file);
+        return ok;
+    }
+};
+
+#endif
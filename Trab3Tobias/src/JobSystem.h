@@ -0,0 +1,366 @@
+// Este arquivo define o JobSystem, um conjunto fixo de threads de trabalho com roubo de
+// tarefas (work stealing), e o TaskGraph, um grafo de tarefas com dependências.
+// Cada thread (inclusive a que chama) tem sua fila de tarefas: ela retira tarefas do fim
+// da própria fila e, quando a fila acaba, rouba do início da fila de outra thread.
+// Primitivas:
+// - parallelFor: divide [0, count) em faixas e executa function(begin, end) em cada uma;
+// - run(TaskGraph): executa as tarefas do grafo, cada uma depois das que a precedem.
+// A thread que chama sempre ajuda a executar as tarefas até o trabalho pedido terminar,
+// então chamadas aninhadas (uma tarefa que chama parallelFor) não travam.
+// O resultado de quem usa estas primitivas não deve depender da ordem de execução: as
+// faixas escrevem em posições próprias e a junção dos resultados é feita depois, em ordem.
+// As tarefas na fila são estruturas simples (função + dados), em filas circulares que só
+// crescem, e o grafo pode ser esvaziado e remontado reaproveitando as tarefas: depois do
+// aquecimento, nem a distribuição nem um grafo mantido entre quadros (ex: o membro
+// updateGraph do EnemyStore) alocam memória. Um TaskGraph local, criado a cada quadro,
+// aloca as suas tarefas de novo a cada vez.
+// Sem suporte a threads (ex: MinGW sem gthreads), tudo roda na thread atual.
+#ifndef ___JOB_SYSTEM__H___
+#define ___JOB_SYSTEM__H___
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+#if defined(_GLIBCXX_HAS_GTHREADS)
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#endif
+
+#define JOB_SYSTEM_MAX_WORKERS 15 // threads de trabalho além da que chama
+
+// Grafo de tarefas: cada tarefa executa depois de todas as que a precedem.
+// O grafo pode ser executado várias vezes e, com clear(), remontado sem alocar (funções
+// pequenas, como lambdas que capturam só this, ficam dentro do std::function). Para não
+// alocar a cada quadro, o grafo deve durar entre os quadros (membro de quem o usa).
+class TaskGraph
+{
+    friend class JobSystem;
+
+    struct Task {
+        std::function<void()> function;
+        std::vector<int> successors;
+        int dependencies;
+#if defined(_GLIBCXX_HAS_GTHREADS)
+        std::atomic<int> pending;
+#else
+        int pending;
+#endif
+        Task() : dependencies(0), pending(0) {}
+    };
+
+    std::vector<std::unique_ptr<Task> > tasks; // as count primeiras estão em uso
+    int count;
+#if !defined(_GLIBCXX_HAS_GTHREADS)
+    std::vector<int> ready; // tarefas prontas, na execução sem threads
+#endif
+
+public:
+    TaskGraph() : count(0) {}
+
+    // Remove todas as tarefas, mantendo a memória para as próximas.
+    void clear() { count = 0; }
+
+    // Adiciona uma tarefa e retorna seu índice.
+    int add(const std::function<void()>& function)
+    {
+        if (count == (int)tasks.size()) {
+            tasks.push_back(std::unique_ptr<Task>(new Task()));
+        }
+        Task& task = *tasks[count];
+        task.function = function;
+        task.successors.clear();
+        task.dependencies = 0;
+        return count++;
+    }
+
+    // A tarefa after só começa depois que a tarefa before terminar.
+    void precede(int before, int after)
+    {
+        tasks[before]->successors.push_back(after);
+        tasks[after]->dependencies++;
+    }
+
+    int size() const { return count; }
+};
+
+class JobSystem
+{
+#if defined(_GLIBCXX_HAS_GTHREADS)
+    // Contador de tarefas pendentes de um pedido (parallelFor ou run).
+    struct Batch {
+        std::atomic<int> pending;
+        explicit Batch(int count) : pending(count) {}
+    };
+
+    // Tarefa na fila: execute(job) roda a faixa [begin, end) da função de um parallelFor
+    // (context) ou a tarefa begin de um grafo (context).
+    struct Job {
+        void (*execute)(const Job&);
+        JobSystem* system;
+        void* context;
+        Batch* batch;
+        int begin, end;
+    };
+
+    // Fila circular de tarefas: cresce quando enche e nunca encolhe.
+    struct Queue {
+        std::mutex mutex;
+        std::vector<Job> ring;
+        int head, count;
+
+        Queue() : ring(64), head(0), count(0) {}
+
+        bool empty() const { return count == 0; }
+
+        void pushBack(const Job& job)
+        {
+            if (count == (int)ring.size()) {
+                std::vector<Job> larger(ring.size() * 2);
+                for (int i = 0; i < count; ++i) larger[i] = ring[(head + i) % ring.size()];
+                ring.swap(larger);
+                head = 0;
+            }
+            ring[(head + count) % ring.size()] = job;
+            count++;
+        }
+
+        Job popBack()
+        {
+            count--;
+            return ring[(head + count) % ring.size()];
+        }
+
+        Job popFront()
+        {
+            Job job = ring[head];
+            head = (head + 1) % ring.size();
+            count--;
+            return job;
+        }
+    };
+
+    std::vector<std::unique_ptr<Queue> > queues; // queues[0] é a da thread que chama
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::atomic<int> queuedJobs;
+    std::atomic<bool> stopping;
+
+    // Índice da fila da thread atual (0 para threads que não são do JobSystem).
+    static int& currentQueue()
+    {
+        static thread_local int index = 0;
+        return index;
+    }
+
+    void push(const Job& job)
+    {
+        Queue& queue = *queues[currentQueue()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.pushBack(job);
+        }
+        queuedJobs++;
+        if (!workers.empty()) {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            wakeUp.notify_one();
+        }
+    }
+
+    // Retira uma tarefa do fim da própria fila ou rouba do início da fila de outra thread.
+    bool takeJob(Job& job)
+    {
+        int self = currentQueue();
+        int n = (int)queues.size();
+        for (int k = 0; k < n; ++k) {
+            Queue& queue = *queues[(self + k) % n];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.empty()) continue;
+            job = (k == 0) ? queue.popBack() : queue.popFront();
+            queuedJobs--;
+            return true;
+        }
+        return false;
+    }
+
+    // Executa tarefas (de qualquer pedido) até o pedido batch terminar.
+    void helpUntilDone(Batch& batch)
+    {
+        while (batch.pending.load() > 0) {
+            Job job;
+            if (takeJob(job)) {
+                job.execute(job);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void workerLoop(int index)
+    {
+        currentQueue() = index;
+        while (!stopping.load()) {
+            Job job;
+            if (takeJob(job)) {
+                job.execute(job);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wakeUp.wait(lock, [this] { return stopping.load() || queuedJobs.load() > 0; });
+        }
+    }
+
+    void startWorkers(int count)
+    {
+        stopping = false;
+        queues.clear();
+        for (int i = 0; i <= count; ++i) {
+            queues.push_back(std::unique_ptr<Queue>(new Queue()));
+        }
+        for (int i = 1; i <= count; ++i) {
+            workers.push_back(std::thread(&JobSystem::workerLoop, this, i));
+        }
+    }
+
+    void stopWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+            wakeUp.notify_all();
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        workers.clear();
+    }
+
+    // Executa uma faixa de um parallelFor.
+    template <typename Function>
+    static void executeRange(const Job& job)
+    {
+        (*static_cast<Function*>(job.context))(job.begin, job.end);
+        job.batch->pending--;
+    }
+
+    // Executa uma tarefa do grafo e adiciona à fila as sucessoras que ficaram prontas.
+    static void executeTask(const Job& job)
+    {
+        TaskGraph& graph = *static_cast<TaskGraph*>(job.context);
+        TaskGraph::Task& task = *graph.tasks[job.begin];
+        task.function();
+        for (int successor : task.successors) {
+            if (--graph.tasks[successor]->pending == 0) job.system->pushTask(graph, successor, *job.batch);
+        }
+        job.batch->pending--;
+    }
+
+    // Adiciona à fila a tarefa index do grafo.
+    void pushTask(TaskGraph& graph, int index, Batch& batch)
+    {
+        Job job = { &JobSystem::executeTask, this, &graph, &batch, index, index + 1 };
+        push(job);
+    }
+#endif
+
+public:
+#if defined(_GLIBCXX_HAS_GTHREADS)
+    explicit JobSystem(int workerCount) : queuedJobs(0), stopping(false)
+    {
+        startWorkers(std::max(0, std::min(workerCount, JOB_SYSTEM_MAX_WORKERS)));
+    }
+
+    ~JobSystem() { stopWorkers(); }
+
+    // Troca o número de threads de trabalho (não deve ser chamado durante um pedido).
+    void setWorkerCount(int workerCount)
+    {
+        stopWorkers();
+        startWorkers(std::max(0, std::min(workerCount, JOB_SYSTEM_MAX_WORKERS)));
+    }
+
+    int getWorkerCount() const { return (int)workers.size(); }
+
+    // Threads de trabalho padrão: um por núcleo, além da thread que chama.
+    static int defaultWorkerCount()
+    {
+        return std::max(0, (int)std::thread::hardware_concurrency() - 1);
+    }
+#else
+    explicit JobSystem(int) {}
+    void setWorkerCount(int) {}
+    int getWorkerCount() const { return 0; }
+    static int defaultWorkerCount() { return 0; }
+#endif
+
+    // JobSystem compartilhado pelo programa (criado no primeiro uso).
+    static JobSystem& shared()
+    {
+        static JobSystem system(defaultWorkerCount());
+        return system;
+    }
+
+    // Executa function(begin, end) sobre faixas de [0, count) com pelo menos minPerRange
+    // itens cada (faixas menores não compensam o custo de distribuir a tarefa).
+    template <typename Function>
+    void parallelFor(int count, int minPerRange, Function function)
+    {
+        if (count <= 0) return;
+        int ranges = std::max(1, count / std::max(1, minPerRange));
+        // algumas faixas por thread, para que o roubo equilibre a carga
+        ranges = std::min(ranges, (getWorkerCount() + 1) * 4);
+        if (ranges == 1 || getWorkerCount() == 0) {
+            function(0, count);
+            return;
+        }
+#if defined(_GLIBCXX_HAS_GTHREADS)
+        int step = (count + ranges - 1) / ranges;
+        Batch batch((count + step - 1) / step);
+        for (int begin = step; begin < count; begin += step) {
+            Job job = { &JobSystem::executeRange<Function>, this, &function, &batch, begin, std::min(count, begin + step) };
+            push(job);
+        }
+        function(0, step);
+        batch.pending--;
+        helpUntilDone(batch);
+#endif
+    }
+
+    // Executa todas as tarefas do grafo respeitando as dependências.
+    void run(TaskGraph& graph)
+    {
+#if defined(_GLIBCXX_HAS_GTHREADS)
+        if (graph.count == 0) return;
+        Batch batch(graph.count);
+        for (int i = 0; i < graph.count; ++i) {
+            graph.tasks[i]->pending = graph.tasks[i]->dependencies;
+        }
+        for (int i = 0; i < graph.count; ++i) {
+            if (graph.tasks[i]->dependencies == 0) pushTask(graph, i, batch);
+        }
+        helpUntilDone(batch);
+#else
+        // ordem topológica simples: executa as tarefas prontas até acabar
+        std::vector<int>& ready = graph.ready;
+        ready.clear();
+        for (int i = 0; i < graph.count; ++i) {
+            graph.tasks[i]->pending = graph.tasks[i]->dependencies;
+            if (graph.tasks[i]->pending == 0) ready.push_back(i);
+        }
+        while (!ready.empty()) {
+            int index = ready.back();
+            ready.pop_back();
+            graph.tasks[index]->function();
+            for (int successor : graph.tasks[index]->successors) {
+                if (--graph.tasks[successor]->pending == 0) ready.push_back(successor);
+            }
+        }
+#endif
+    }
+};
+
+#endif
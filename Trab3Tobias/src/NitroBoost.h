@@ -8,12 +8,14 @@
 // - Fornecer o multiplicador de velocidade.
 // - Desenhar a interface do usuário (UI) para a habilidade de nitro.
 // - Desenhar o efeito visual da chama do nitro.
-// A função drawNitroFlameSprite é uma auxiliar para renderizar a animação da chama.
+// A função drawNitroFlameSprite é uma auxiliar para renderizar a animação da chama; os
+// quadros são montados uma vez no SpriteAtlas e desenhados como sprites.
 #ifndef NITROBOOST_H_INCLUDED
 #define NITROBOOST_H_INCLUDED
 
 #include "gl_canvas2d.h"
 #include "Vector2.h"
+#include "Sprites.h"
 #include <cmath>   
 #include <vector>  
 #include <cstdlib> 
@@ -164,14 +166,8 @@ public:
         Vector2 midRight(iconCenterX + iconWidth / 3, iconBaseY + (iconTipY - iconBaseY) * 0.5f);
         
         
-        std::vector<Vector2> flameVertices;
-        flameVertices.push_back(baseLeft);
-        flameVertices.push_back(midLeft);
-        flameVertices.push_back(tip);
-        flameVertices.push_back(midRight);
-        flameVertices.push_back(baseRight);
-
-        int numFlameVertices = flameVertices.size();
+        const Vector2 flameVertices[] = { baseLeft, midLeft, tip, midRight, baseRight };
+        const int numFlameVertices = 5;
         float flameVx[numFlameVertices];
         float flameVy[numFlameVertices];
         for(int i=0; i < numFlameVertices; ++i) {
@@ -191,12 +187,8 @@ public:
         Vector2 innerBaseRight(iconCenterX + innerFlameWidth / 2, iconBaseY);
         Vector2 innerTip(iconCenterX, iconBaseY + (iconTipY - iconBaseY) * 0.65f); 
 
-        std::vector<Vector2> innerFlameVertices;
-        innerFlameVertices.push_back(innerBaseLeft);
-        innerFlameVertices.push_back(innerTip);
-        innerFlameVertices.push_back(innerBaseRight);
-        
-        int numInnerFlameVertices = innerFlameVertices.size();
+        const Vector2 innerFlameVertices[] = { innerBaseLeft, innerTip, innerBaseRight };
+        const int numInnerFlameVertices = 3;
         float innerFlameVx[numInnerFlameVertices];
         float innerFlameVy[numInnerFlameVertices];
         for(int i=0; i < numInnerFlameVertices; ++i) {
@@ -209,7 +201,12 @@ public:
     // Desenha o efeito visual da chama do nitro na posição e direção especificadas.
     void drawEffect(Vector2 basePosition, Vector2 flameDirection, float scale) const { 
         if (!isActive) return;
-        
+        const SpriteAtlas& atlas = SpriteAtlas::shared();
+        if (atlas.isReady()) {
+            float angle = atan2(flameDirection.y, flameDirection.x);
+            atlas.draw(nitroSprite(currentEffectFrame, rand() % SPRITE_VARIANTS), basePosition, angle, scale);
+            return;
+        }
         drawNitroFlameSprite(basePosition, flameDirection, currentEffectFrame, scale);
     }
 };
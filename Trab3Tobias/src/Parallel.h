@@ -0,0 +1,17 @@
+// Este arquivo define parallelForRanges, um utilitário que divide o intervalo
+// [0, count) em faixas contíguas e executa as faixas nas threads do JobSystem compartilhado.
+// Sem suporte a threads (ex: MinGW sem gthreads), tudo roda na thread atual.
+#ifndef ___PARALLEL__H___
+#define ___PARALLEL__H___
+
+#include "JobSystem.h"
+
+// Executa function(begin, end) sobre faixas de [0, count).
+// Faixas com menos de minPerRange itens não compensam o custo de distribuir a tarefa.
+template <typename Function>
+void parallelForRanges(int count, Function function, int minPerRange = 64)
+{
+    JobSystem::shared().parallelFor(count, minPerRange, function);
+}
+
+#endif
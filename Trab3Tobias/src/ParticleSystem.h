@@ -0,0 +1,257 @@
+// Este arquivo define a classe ParticleSystem, as partículas dos efeitos visuais (faíscas,
+// fogo, fumaça e destroços das explosões e a poeira das esteiras do tanque).
+// Como no ProjectilePool, as partículas ficam em um pool de capacidade fixa no formato
+// "estrutura de arrays" (posição, velocidade, tempo de vida, tamanho, arrasto, material):
+// - emissão em rajadas descritas por um ParticleEmitter (cone de direções, faixas de
+//   velocidade, vida e tamanho), sorteadas com um gerador próprio: as partículas são só
+//   visuais e não alteram a simulação nem o hash do estado;
+// - integração de 4 partículas por instrução com SSE2 (com versão escalar equivalente);
+// - compactação pelo tempo de vida: as partículas que morreram no passo são removidas
+//   trocando-as pela última (swap-remove), então o pool fica sempre contíguo;
+// - desenho em lote: os vértices de cada material são montados em um buffer reaproveitado
+//   entre quadros e enviados à Canvas2D em uma única chamada por material.
+// Com o pool cheio, as novas partículas são descartadas.
+#ifndef ___PARTICLE_SYSTEM__H___
+#define ___PARTICLE_SYSTEM__H___
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "Vector2.h"
+#include "Random.h"
+#include "gl_canvas2d.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define PARTICLE_SYSTEM_CAPACITY 131072
+#define PARTICLE_SYSTEM_SEED 2654435769u
+#define PARTICLE_SPARK_STREAK 0.03f // comprimento do rastro da faísca, em segundos de velocidade
+
+// Material da partícula: define as cores e a forma do desenho (na ordem de desenho).
+enum class ParticleMaterial : unsigned char { DUST, SMOKE, DEBRIS, FIRE, SPARK, COUNT };
+
+// Parâmetros de uma rajada de partículas.
+struct ParticleEmitter {
+    ParticleMaterial material;
+    int count;
+    float spread;                   // abertura do cone de direções (radianos; 2 pi = todas)
+    float speedMin, speedMax;       // pixels por segundo
+    float lifetimeMin, lifetimeMax; // segundos
+    float sizeMin, sizeMax;         // pixels
+    float growth;                   // variação do tamanho por segundo
+    float drag;                     // fração da velocidade perdida por segundo
+    float radius;                   // dispersão da posição inicial
+};
+
+class ParticleSystem
+{
+    int capacity;
+    int count;
+    Random rng;
+
+    // arrays com capacidade arredondada para múltiplo de 4 (passo do SSE)
+    std::vector<float> posX, posY;
+    std::vector<float> velX, velY;
+    std::vector<float> life, inverseLifetime;
+    std::vector<float> diameter, growth;
+    std::vector<float> drag;
+    std::vector<ParticleMaterial> material;
+
+    // buffers de desenho por material, reaproveitados entre quadros
+    mutable std::vector<float> vertices[(int)ParticleMaterial::COUNT];
+    mutable std::vector<float> colors[(int)ParticleMaterial::COUNT];
+
+    static void pushVertex(std::vector<float>& vertexBuffer, std::vector<float>& colorBuffer, float x, float y, const float* rgb)
+    {
+        vertexBuffer.push_back(x);
+        vertexBuffer.push_back(y);
+        colorBuffer.push_back(rgb[0]);
+        colorBuffer.push_back(rgb[1]);
+        colorBuffer.push_back(rgb[2]);
+    }
+
+    // Cria uma partícula. Retorna false (e não cria) se o pool estiver cheio.
+    bool spawn(ParticleMaterial particleMaterial, float x, float y, float vx, float vy, float lifetime,
+               float particleSize, float particleGrowth, float particleDrag)
+    {
+        if (count >= capacity) return false;
+        int i = count++;
+        posX[i] = x;
+        posY[i] = y;
+        velX[i] = vx;
+        velY[i] = vy;
+        life[i] = lifetime;
+        inverseLifetime[i] = 1.0f / lifetime;
+        diameter[i] = particleSize;
+        growth[i] = particleGrowth;
+        drag[i] = particleDrag;
+        material[i] = particleMaterial;
+        return true;
+    }
+
+    // Remove a partícula i trocando-a pela última.
+    void remove(int i)
+    {
+        int last = --count;
+        if (i == last) return;
+        posX[i] = posX[last]; posY[i] = posY[last];
+        velX[i] = velX[last]; velY[i] = velY[last];
+        life[i] = life[last];
+        inverseLifetime[i] = inverseLifetime[last];
+        diameter[i] = diameter[last];
+        growth[i] = growth[last];
+        drag[i] = drag[last];
+        material[i] = material[last];
+    }
+
+    // Integra as partículas [begin, end): posição, arrasto, tempo de vida e tamanho.
+    void integrate(float dt, int begin, int end)
+    {
+        int i = begin;
+#if defined(__SSE2__)
+        __m128 vdt = _mm_set1_ps(dt), one = _mm_set1_ps(1.0f), zero = _mm_setzero_ps();
+        for (; i + 4 <= end; i += 4) {
+            __m128 vx = _mm_loadu_ps(&velX[i]), vy = _mm_loadu_ps(&velY[i]);
+            _mm_storeu_ps(&posX[i], _mm_add_ps(_mm_loadu_ps(&posX[i]), _mm_mul_ps(vx, vdt)));
+            _mm_storeu_ps(&posY[i], _mm_add_ps(_mm_loadu_ps(&posY[i]), _mm_mul_ps(vy, vdt)));
+            __m128 keep = _mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(_mm_loadu_ps(&drag[i]), vdt)));
+            _mm_storeu_ps(&velX[i], _mm_mul_ps(vx, keep));
+            _mm_storeu_ps(&velY[i], _mm_mul_ps(vy, keep));
+            _mm_storeu_ps(&life[i], _mm_sub_ps(_mm_loadu_ps(&life[i]), vdt));
+            __m128 grown = _mm_add_ps(_mm_loadu_ps(&diameter[i]), _mm_mul_ps(_mm_loadu_ps(&growth[i]), vdt));
+            _mm_storeu_ps(&diameter[i], _mm_max_ps(zero, grown));
+        }
+#endif
+        for (; i < end; ++i) {
+            posX[i] += velX[i] * dt;
+            posY[i] += velY[i] * dt;
+            float keep = std::max(0.0f, 1.0f - drag[i] * dt);
+            velX[i] *= keep;
+            velY[i] *= keep;
+            life[i] -= dt;
+            diameter[i] = std::max(0.0f, diameter[i] + growth[i] * dt);
+        }
+    }
+
+public:
+    ParticleSystem(int capacity = PARTICLE_SYSTEM_CAPACITY) : capacity(capacity), count(0), rng(PARTICLE_SYSTEM_SEED)
+    {
+        int padded = (capacity + 3) & ~3;
+        posX.assign(padded, 0.0f); posY.assign(padded, 0.0f);
+        velX.assign(padded, 0.0f); velY.assign(padded, 0.0f);
+        life.assign(padded, 0.0f); inverseLifetime.assign(padded, 0.0f);
+        diameter.assign(padded, 0.0f); growth.assign(padded, 0.0f);
+        drag.assign(padded, 0.0f);
+        material.assign(padded, ParticleMaterial::DUST);
+    }
+
+    // Emite uma rajada em position, com o cone de direções centrado em direction; velocidades,
+    // tamanhos e dispersão são multiplicados por scale. Retorna quantas partículas foram criadas.
+    int emit(const ParticleEmitter& emitter, const Vector2& position, const Vector2& direction, float scale = 1.0f)
+    {
+        float baseAngle = atan2(direction.y, direction.x);
+        int created = 0;
+        for (int k = 0; k < emitter.count; ++k) {
+            float angle = baseAngle + (rng.nextFloat() - 0.5f) * emitter.spread;
+            float speed = rng.nextRange(emitter.speedMin, emitter.speedMax) * scale;
+            float offsetAngle = rng.nextFloat() * 2.0f * (float)M_PI;
+            float offset = rng.nextFloat() * emitter.radius * scale;
+            float c = cos(angle), s = sin(angle);
+            if (!spawn(emitter.material, position.x + cos(offsetAngle) * offset, position.y + sin(offsetAngle) * offset,
+                       c * speed, s * speed, rng.nextRange(emitter.lifetimeMin, emitter.lifetimeMax),
+                       rng.nextRange(emitter.sizeMin, emitter.sizeMax) * scale, emitter.growth * scale, emitter.drag)) {
+                break;
+            }
+            created++;
+        }
+        return created;
+    }
+
+    // Emite as partículas de uma explosão de escala scale: fogo, faíscas, destroços e fumaça.
+    int emitExplosion(const Vector2& position, float scale = 1.0f)
+    {
+        //                                         material                  n  spread            velocidade     vida          tamanho     cresc. arrasto raio
+        static const ParticleEmitter fire   = { ParticleMaterial::FIRE,   14, 2.0f * (float)M_PI,  20.0f,  70.0f, 0.15f, 0.35f, 3.0f, 6.0f, -8.0f, 4.0f, 4.0f };
+        static const ParticleEmitter sparks = { ParticleMaterial::SPARK,  16, 2.0f * (float)M_PI, 120.0f, 260.0f, 0.20f, 0.45f, 1.0f, 1.0f,  0.0f, 3.0f, 2.0f };
+        static const ParticleEmitter debris = { ParticleMaterial::DEBRIS, 10, 2.0f * (float)M_PI,  60.0f, 140.0f, 0.40f, 0.90f, 1.5f, 3.0f,  0.0f, 4.0f, 3.0f };
+        static const ParticleEmitter smoke  = { ParticleMaterial::SMOKE,  12, 2.0f * (float)M_PI,  10.0f,  35.0f, 0.60f, 1.30f, 4.0f, 7.0f,  9.0f, 1.5f, 8.0f };
+        Vector2 any(1, 0);
+        return emit(smoke, position, any, scale) + emit(debris, position, any, scale)
+             + emit(fire, position, any, scale) + emit(sparks, position, any, scale);
+    }
+
+    // Emite a poeira de uma esteira em position, lançada para trás (backward).
+    int emitTreadDust(const Vector2& position, const Vector2& backward)
+    {
+        static const ParticleEmitter dust = { ParticleMaterial::DUST, 1, 1.2f, 8.0f, 25.0f, 0.5f, 1.0f, 2.0f, 3.5f, 4.0f, 2.0f, 3.0f };
+        return emit(dust, position, backward);
+    }
+
+    // Avança as partículas dt segundos e remove as que chegaram ao fim da vida.
+    void update(float dt)
+    {
+        integrate(dt, 0, count);
+        int i = 0;
+        while (i < count) {
+            if (life[i] <= 0.0f) remove(i); // a última partícula passa a ocupar i e é testada em seguida
+            else ++i;
+        }
+    }
+
+    void clear() { count = 0; }
+
+    int size() const { return count; }
+    int getCapacity() const { return capacity; }
+
+    // Desenha as partículas que cruzam a área visível dada: quadrados (ou, para as faíscas,
+    // rastros na direção da velocidade) com a cor do material interpolada pela idade, em uma
+    // chamada da Canvas2D por material.
+    void draw(float minX, float minY, float maxX, float maxY) const
+    {
+        // cores inicial e final de cada material (na ordem de ParticleMaterial)
+        static const float startColors[(int)ParticleMaterial::COUNT][3] = { {0.55f, 0.50f, 0.40f}, {0.35f, 0.33f, 0.30f}, {0.30f, 0.22f, 0.15f}, {1.0f, 0.9f, 0.3f}, {1.0f, 1.0f, 0.7f} };
+        static const float endColors[(int)ParticleMaterial::COUNT][3]   = { {0.40f, 0.38f, 0.33f}, {0.18f, 0.18f, 0.18f}, {0.12f, 0.10f, 0.08f}, {0.8f, 0.2f, 0.05f}, {1.0f, 0.5f, 0.1f} };
+
+        for (int m = 0; m < (int)ParticleMaterial::COUNT; ++m) {
+            vertices[m].clear();
+            colors[m].clear();
+        }
+
+        for (int i = 0; i < count; ++i) {
+            float half = diameter[i] * 0.5f;
+            if (posX[i] + half < minX || posX[i] - half > maxX || posY[i] + half < minY || posY[i] - half > maxY) continue;
+            int m = (int)material[i];
+            float t = std::min(1.0f, std::max(0.0f, 1.0f - life[i] * inverseLifetime[i]));
+            float rgb[3];
+            for (int c = 0; c < 3; ++c) rgb[c] = startColors[m][c] + (endColors[m][c] - startColors[m][c]) * t;
+
+            float x = posX[i], y = posY[i];
+            if (material[i] == ParticleMaterial::SPARK) {
+                pushVertex(vertices[m], colors[m], x, y, rgb);
+                pushVertex(vertices[m], colors[m], x - velX[i] * PARTICLE_SPARK_STREAK, y - velY[i] * PARTICLE_SPARK_STREAK, rgb);
+                continue;
+            }
+            pushVertex(vertices[m], colors[m], x - half, y - half, rgb);
+            pushVertex(vertices[m], colors[m], x + half, y - half, rgb);
+            pushVertex(vertices[m], colors[m], x + half, y + half, rgb);
+            pushVertex(vertices[m], colors[m], x - half, y - half, rgb);
+            pushVertex(vertices[m], colors[m], x + half, y + half, rgb);
+            pushVertex(vertices[m], colors[m], x - half, y + half, rgb);
+        }
+
+        for (int m = 0; m < (int)ParticleMaterial::COUNT; ++m) {
+            if (vertices[m].empty()) continue;
+            int n = (int)(vertices[m].size() / 2);
+            if (m == (int)ParticleMaterial::SPARK) CV::lines(vertices[m].data(), colors[m].data(), n);
+            else CV::trianglesFill(vertices[m].data(), colors[m].data(), n);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,70 @@
+// Este arquivo define as estruturas de medição de tempo da simulação.
+// TickProfile acumula, em microssegundos, o tempo gasto por cada subsistema
+// em Game::update (reconstrução da SpatialHash, tanque, projéteis, inimigos e
+// explosões) e o total, junto com o número de ticks medidos e de alocações no heap.
+// ScopedTimer soma ao acumulador indicado o tempo entre sua criação e destruição;
+// ScopedAllocationCount soma as alocações feitas nesse intervalo.
+#ifndef ___PROFILER__H___
+#define ___PROFILER__H___
+
+#include <chrono>
+#include "AllocationCounter.h"
+
+struct TickProfile
+{
+    double enemyHash;
+    double tank;
+    double projectiles;
+    double enemies;
+    double explosions;
+    double total;
+    long ticks;
+    unsigned long allocations;
+
+    TickProfile() { reset(); }
+
+    void reset()
+    {
+        enemyHash = tank = projectiles = enemies = explosions = total = 0.0;
+        ticks = 0;
+        allocations = 0;
+    }
+
+    // Média por tick do acumulador dado (em microssegundos).
+    double perTick(double accumulated) const
+    {
+        return ticks > 0 ? accumulated / ticks : 0.0;
+    }
+};
+
+class ScopedTimer
+{
+    double& accumulator;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedTimer(double& accumulatorMicroseconds)
+        : accumulator(accumulatorMicroseconds), start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer()
+    {
+        accumulator += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+class ScopedAllocationCount
+{
+    unsigned long& accumulator;
+    unsigned long start;
+
+public:
+    explicit ScopedAllocationCount(unsigned long& accumulatorAllocations)
+        : accumulator(accumulatorAllocations), start(AllocationCounter::count()) {}
+
+    ~ScopedAllocationCount()
+    {
+        accumulator += AllocationCounter::count() - start;
+    }
+};
+
+#endif
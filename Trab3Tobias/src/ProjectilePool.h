@@ -0,0 +1,202 @@
+// Este arquivo define a classe ProjectilePool, o conjunto de todos os projéteis do jogo
+// (tiros do jogador e estilhaços dos inimigos).
+// Os projéteis ficam em um pool de capacidade fixa no formato "estrutura de arrays":
+// cada atributo (posição, velocidade, direção, dimensões, dano, dono, tempo de vida)
+// é um array contíguo, o que permite:
+// - remoção O(1) trocando o projétil removido pelo último (swap-remove);
+// - movimento de 4 projéteis por instrução com SSE2 (com versão escalar equivalente);
+// - geração em lote dos vértices de desenho, enviados à Canvas2D em duas chamadas (só dos
+//   projéteis que cruzam a área visível).
+// A ordem dos projéteis no pool não é preservada após uma remoção.
+#ifndef ___PROJECTILE_POOL__H___
+#define ___PROJECTILE_POOL__H___
+
+#include <vector>
+#include <algorithm>
+#include "Vector2.h"
+#include "gl_canvas2d.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define PROJECTILE_POOL_CAPACITY 32768
+#define PROJECTILE_DEFAULT_LIFETIME 6.0f
+
+// Dono do projétil: define contra quem ele colide e sua aparência.
+enum class ProjectileOwner : unsigned char { PLAYER, ENEMY_SHRAPNEL };
+
+class ProjectilePool
+{
+    int capacity;
+    int count;
+
+    // arrays com capacidade arredondada para múltiplo de 4 (passo do SSE)
+    std::vector<float> posX, posY;
+    std::vector<float> velX, velY;
+    std::vector<float> dirX, dirY;
+    std::vector<float> halfWidth, halfHeight;
+    std::vector<float> damage;
+    std::vector<float> lifetime;
+    std::vector<ProjectileOwner> owner;
+
+    // buffers de desenho reaproveitados entre quadros
+    mutable std::vector<float> triangleVertices, triangleColors;
+    mutable std::vector<float> lineVertices, lineColors;
+
+    static void pushVertex(std::vector<float>& vertices, std::vector<float>& colors, const Vector2& p, const float* rgb)
+    {
+        vertices.push_back(p.x);
+        vertices.push_back(p.y);
+        colors.push_back(rgb[0]);
+        colors.push_back(rgb[1]);
+        colors.push_back(rgb[2]);
+    }
+
+public:
+    ProjectilePool(int capacity = PROJECTILE_POOL_CAPACITY) : capacity(capacity), count(0)
+    {
+        int padded = (capacity + 3) & ~3;
+        posX.assign(padded, 0.0f); posY.assign(padded, 0.0f);
+        velX.assign(padded, 0.0f); velY.assign(padded, 0.0f);
+        dirX.assign(padded, 0.0f); dirY.assign(padded, 0.0f);
+        halfWidth.assign(padded, 0.0f); halfHeight.assign(padded, 0.0f);
+        damage.assign(padded, 0.0f);
+        lifetime.assign(padded, 0.0f);
+        owner.assign(padded, ProjectileOwner::PLAYER);
+    }
+
+    // Cria um projétil. Retorna false (e não cria) se o pool estiver cheio.
+    bool spawn(const Vector2& startPos, const Vector2& direction, float speed, float width, float height,
+               ProjectileOwner projectileOwner, float projectileDamage, float life = PROJECTILE_DEFAULT_LIFETIME)
+    {
+        if (count >= capacity) return false;
+        Vector2 dir = direction.normalized();
+        int i = count++;
+        posX[i] = startPos.x;
+        posY[i] = startPos.y;
+        dirX[i] = dir.x;
+        dirY[i] = dir.y;
+        velX[i] = dir.x * speed;
+        velY[i] = dir.y * speed;
+        halfWidth[i] = width * 0.5f;
+        halfHeight[i] = height * 0.5f;
+        damage[i] = projectileDamage;
+        lifetime[i] = life;
+        owner[i] = projectileOwner;
+        return true;
+    }
+
+    // Remove o projétil i trocando-o pelo último. O projétil que estava no fim passa a ocupar i.
+    void remove(int i)
+    {
+        int last = --count;
+        if (i == last) return;
+        posX[i] = posX[last]; posY[i] = posY[last];
+        velX[i] = velX[last]; velY[i] = velY[last];
+        dirX[i] = dirX[last]; dirY[i] = dirY[last];
+        halfWidth[i] = halfWidth[last]; halfHeight[i] = halfHeight[last];
+        damage[i] = damage[last];
+        lifetime[i] = lifetime[last];
+        owner[i] = owner[last];
+    }
+
+    void clear() { count = 0; }
+
+    // Move todos os projéteis: posição += velocidade * dt e tempo de vida -= dt.
+    void move(float dt)
+    {
+        move(dt, 0, count);
+    }
+
+    // Move os projéteis [begin, end) (faixas disjuntas podem ser movidas em threads diferentes).
+    void move(float dt, int begin, int end)
+    {
+        int i = begin;
+#if defined(__SSE2__)
+        __m128 vdt = _mm_set1_ps(dt);
+        for (; i + 4 <= end; i += 4) {
+            _mm_storeu_ps(&posX[i], _mm_add_ps(_mm_loadu_ps(&posX[i]), _mm_mul_ps(_mm_loadu_ps(&velX[i]), vdt)));
+            _mm_storeu_ps(&posY[i], _mm_add_ps(_mm_loadu_ps(&posY[i]), _mm_mul_ps(_mm_loadu_ps(&velY[i]), vdt)));
+            _mm_storeu_ps(&lifetime[i], _mm_sub_ps(_mm_loadu_ps(&lifetime[i]), vdt));
+        }
+#endif
+        for (; i < end; ++i) {
+            posX[i] += velX[i] * dt;
+            posY[i] += velY[i] * dt;
+            lifetime[i] -= dt;
+        }
+    }
+
+    int size() const { return count; }
+    int getCapacity() const { return capacity; }
+    Vector2 getPosition(int i) const { return Vector2(posX[i], posY[i]); }
+    Vector2 getDirection(int i) const { return Vector2(dirX[i], dirY[i]); }
+    Vector2 getVelocity(int i) const { return Vector2(velX[i], velY[i]); }
+    float getWidth(int i) const { return halfWidth[i] * 2.0f; }
+    float getHeight(int i) const { return halfHeight[i] * 2.0f; }
+    float getDamage(int i) const { return damage[i]; }
+    float getLifetime(int i) const { return lifetime[i]; }
+    ProjectileOwner getOwner(int i) const { return owner[i]; }
+
+    // Desenha os projéteis que cruzam a área visível dada: corpo e ponta como triângulos e
+    // contorno como linhas, montados em lote e enviados em uma chamada para cada primitiva.
+    void draw(float minX, float minY, float maxX, float maxY) const
+    {
+        static const float playerBody[3] = { 0.6f, 0.6f, 0.6f };
+        static const float playerTip[3] = { 0.8f, 0.1f, 0.1f };
+        static const float shrapnelBody[3] = { 0.7f, 0.3f, 0.0f };
+        static const float shrapnelTip[3] = { 0.9f, 0.6f, 0.0f };
+        static const float playerOutline[3] = { 0.3f, 0.3f, 0.3f };
+        static const float shrapnelOutline[3] = { 0.35f, 0.15f, 0.0f };
+        const float tipHeightRatio = 0.3f;
+
+        triangleVertices.clear(); triangleColors.clear();
+        lineVertices.clear(); lineColors.clear();
+
+        for (int i = 0; i < count; ++i) {
+            float extent = std::max(halfHeight[i], halfWidth[i]);
+            if (posX[i] + extent < minX || posX[i] - extent > maxX || posY[i] + extent < minY || posY[i] - extent > maxY) continue;
+            bool isPlayer = owner[i] == ProjectileOwner::PLAYER;
+            const float* body = isPlayer ? playerBody : shrapnelBody;
+            const float* tip = isPlayer ? playerTip : shrapnelTip;
+            const float* outline = isPlayer ? playerOutline : shrapnelOutline;
+
+            // eixo local x ao longo da direção (comprimento = height), y na largura
+            float hh = halfHeight[i], hw = halfWidth[i];
+            float tipH = 2.0f * hh * tipHeightRatio;
+            Vector2 position(posX[i], posY[i]);
+            Vector2 along(dirX[i], dirY[i]);
+            Vector2 across(-dirY[i], dirX[i]);
+
+            Vector2 rearLeft = position - along * hh - across * hw;
+            Vector2 rearRight = position - along * hh + across * hw;
+            Vector2 frontLeft = position + along * (hh - tipH) - across * hw;
+            Vector2 frontRight = position + along * (hh - tipH) + across * hw;
+            Vector2 tipPoint = position + along * hh;
+
+            pushVertex(triangleVertices, triangleColors, rearLeft, body);
+            pushVertex(triangleVertices, triangleColors, rearRight, body);
+            pushVertex(triangleVertices, triangleColors, frontRight, body);
+            pushVertex(triangleVertices, triangleColors, rearLeft, body);
+            pushVertex(triangleVertices, triangleColors, frontRight, body);
+            pushVertex(triangleVertices, triangleColors, frontLeft, body);
+            pushVertex(triangleVertices, triangleColors, frontLeft, tip);
+            pushVertex(triangleVertices, triangleColors, frontRight, tip);
+            pushVertex(triangleVertices, triangleColors, tipPoint, tip);
+
+            const Vector2 outlinePoints[12] = {
+                rearLeft, frontLeft, frontLeft, frontRight, frontRight, rearRight,
+                rearRight, rearLeft, frontLeft, tipPoint, frontRight, tipPoint
+            };
+            for (int k = 0; k < 12; ++k) {
+                pushVertex(lineVertices, lineColors, outlinePoints[k], outline);
+            }
+        }
+
+        CV::trianglesFill(triangleVertices.data(), triangleColors.data(), (int)(triangleVertices.size() / 2));
+        CV::lines(lineVertices.data(), lineColors.data(), (int)(lineVertices.size() / 2));
+    }
+};
+
+#endif
@@ -0,0 +1,60 @@
+// Este arquivo define a classe Random, o gerador de números aleatórios da simulação.
+// Cada Game tem o seu próprio gerador (PCG32), criado a partir de uma semente:
+// com a mesma semente, a mesma pista e as mesmas entradas, a partida se repete
+// exatamente, o que permite gravar e reproduzir partidas (ver InputLog).
+// O rand() global continua sendo usado apenas por efeitos visuais.
+#ifndef ___RANDOM__H___
+#define ___RANDOM__H___
+
+#include <stdint.h>
+
+class Random
+{
+    uint64_t state;
+    uint64_t increment;
+
+public:
+    explicit Random(uint32_t seedValue = 1) { seed(seedValue); }
+
+    // Reinicia a sequência a partir da semente.
+    void seed(uint32_t seedValue)
+    {
+        state = 0;
+        increment = ((uint64_t)seedValue << 1) | 1u;
+        nextUInt();
+        state += 0x853c49e6748fea9bULL + seedValue;
+        nextUInt();
+    }
+
+    // Próximo inteiro de 32 bits.
+    uint32_t nextUInt()
+    {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + increment;
+        uint32_t xorShifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = (uint32_t)(old >> 59u);
+        return (xorShifted >> rot) | (xorShifted << ((32u - rot) & 31u));
+    }
+
+    // Inteiro em [0, n).
+    int nextInt(int n)
+    {
+        return n > 0 ? (int)(nextUInt() % (uint32_t)n) : 0;
+    }
+
+    // Real em [0, 1].
+    float nextFloat()
+    {
+        return (nextUInt() >> 8) * (1.0f / 16777215.0f);
+    }
+
+    // Real em [minValue, maxValue].
+    float nextRange(float minValue, float maxValue)
+    {
+        return minValue + nextFloat() * (maxValue - minValue);
+    }
+
+    uint64_t getState() const { return state; }
+};
+
+#endif
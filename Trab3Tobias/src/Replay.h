@@ -0,0 +1,86 @@
+// Este arquivo define o ReplayRunner, que reproduz uma partida gravada (InputLog)
+// sem janela e o mais rápido possível.
+// A pista e o gerador são reconstruídos a partir do cabeçalho do arquivo; cada tick
+// gravado é reaplicado pelo HeadlessDriver e o hash do estado resultante é comparado
+// com o gravado. A primeira divergência é informada com o número do tick.
+// Executado por "trab3 --replay <arquivo>". Também serve como carga de trabalho
+// reproduzível para medições de desempenho.
+// Com um arquivo de áudio, os efeitos sonoros da partida são mixados (AudioMixer) e
+// gravados em WAV, no tempo do jogo; o custo da mixagem é informado no fim.
+#ifndef ___REPLAY__H___
+#define ___REPLAY__H___
+
+#include <cstdio>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include "Game.h"
+#include "HeadlessDriver.h"
+#include "InputLog.h"
+#include "Sounds.h"
+#include "AudioSink.h"
+
+class ReplayRunner
+{
+public:
+    // Reproduz o arquivo (gravando o áudio em audioPath, se dado). Retorna 0 se todos os
+    // ticks conferem, 1 se um arquivo não pôde ser lido ou criado e 2 se a simulação
+    // divergiu da gravação.
+    static int run(const char* path, const char* audioPath = NULL)
+    {
+        ReplayHeader header;
+        std::vector<ReplayTick> ticks;
+        if (!InputLog::load(path, header, ticks)) {
+            printf("replay: nao foi possivel ler %s\n", path);
+            return 1;
+        }
+
+        int w = header.worldWidth, h = header.worldHeight;
+        Track track(w, h, w / 2.0f, h / 2.0f, h / 5.0f, h / 2.0f, 10);
+        track.setControlPoints(header.innerControlPoints, header.outerControlPoints);
+        Game game(header.screenWidth, header.screenHeight, track, header.seed);
+        HeadlessDriver driver(game, 1.0f / header.tickRate);
+
+        std::unique_ptr<WavFileSink> audioOutput; // declarada antes: o mixer para (e fecha a saída) antes dela
+        AudioMixer audio;
+        if (audioPath) {
+            audioOutput.reset(new WavFileSink(audioPath, AUDIO_SAMPLE_RATE));
+            registerGameSounds(audio);
+            if (!audioOutput->isOpen() || !audio.start(audioOutput.get())) {
+                printf("replay: nao foi possivel gravar o audio em %s\n", audioPath);
+                return 1;
+            }
+            game.setAudio(&audio);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ticks.size(); ++i) {
+            driver.step(ticks[i].input);
+            uint32_t hash = game.stateHash();
+            if (hash != ticks[i].stateHash) {
+                printf("replay: divergencia no tick %u (hash %08x, gravado %08x)\n",
+                       (unsigned)i, (unsigned)hash, (unsigned)ticks[i].stateHash);
+                return 2;
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        double gameSeconds = ticks.size() / header.tickRate;
+        printf("replay: %u ticks conferidos (%.1f s de jogo) em %.3f s -> %.0f ticks/s, %.1fx o tempo real\n",
+               (unsigned)ticks.size(), gameSeconds, seconds,
+               seconds > 0 ? ticks.size() / seconds : 0.0, seconds > 0 ? gameSeconds / seconds : 0.0);
+        const TickProfile& p = game.getProfile();
+        printf("media por tick (us): total %.1f | hash %.1f, tanque %.1f, projeteis %.1f, inimigos %.1f, explosoes %.1f\n",
+               p.perTick(p.total), p.perTick(p.enemyHash), p.perTick(p.tank),
+               p.perTick(p.projectiles), p.perTick(p.enemies), p.perTick(p.explosions));
+        if (audioPath) {
+            audio.stop();
+            printf("audio: %.1f s em %s | %lu sons (%lu vozes roubadas, %lu eventos perdidos) | %.1f us por bloco de %d quadros\n",
+                   audio.getMixedFrames() / (double)AUDIO_SAMPLE_RATE, audioPath, audio.getStartedVoices(),
+                   audio.getStolenVoices(), audio.getDroppedEvents(), audio.getMicrosPerBlock(), AUDIO_BLOCK_FRAMES);
+        }
+        return 0;
+    }
+};
+
+#endif
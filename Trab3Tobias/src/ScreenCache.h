@@ -0,0 +1,167 @@
+// Este arquivo define a classe ScreenCache, uma camada de desenho guardada em textura.
+// Uma camada estática (ex: o cenário de fundo) é desenhada normalmente no back buffer
+// e copiada para uma textura (glCopyTexSubImage2D, disponível desde o OpenGL 1.1, sem
+// depender de extensões de framebuffer). Nos quadros seguintes a camada é redesenhada
+// com um único retângulo texturizado, até que a versão do conteúdo mude.
+// A camada guardada é uma região do mundo (com a câmera, CV::camera), que pode ser maior
+// que a tela: ela é desenhada em ladrilhos do tamanho da tela, cada um copiado para o seu
+// lugar na textura. Assim a camada continua valendo enquanto a área visível estiver dentro
+// da região guardada e é desenhada deslocada pela câmera, no mesmo lugar do mundo.
+// A textura tem dimensões potência de dois (compatível com drivers antigos); só o canto
+// com o tamanho da região é usado.
+// Se a cópia falhar (erro do OpenGL), o cache se desativa e o dono da camada volta a
+// desenhá-la diretamente a cada quadro.
+#ifndef ___SCREEN_CACHE__H___
+#define ___SCREEN_CACHE__H___
+
+#include <algorithm>
+#include "gl_canvas2d.h"
+
+class ScreenCache
+{
+    GLuint texture;
+    int textureWidth, textureHeight; // dimensões alocadas da textura (potências de dois)
+    int screenWidth, screenHeight;   // tamanho da tela (dos ladrilhos) na captura
+    int originX, originY;            // canto inferior esquerdo da região guardada, no mundo
+    int width, height;               // tamanho da região guardada
+    unsigned version;                // versão do conteúdo guardado
+    bool valid;
+    bool supported;
+
+    static int nextPowerOfTwo(int v)
+    {
+        int p = 1;
+        while (p < v) p <<= 1;
+        return p;
+    }
+
+public:
+    ScreenCache() : texture(0), textureWidth(0), textureHeight(0), screenWidth(0), screenHeight(0),
+                    originX(0), originY(0), width(0), height(0), version(0), valid(false), supported(true) {}
+
+    ~ScreenCache()
+    {
+        if (texture) glDeleteTextures(1, &texture);
+    }
+
+    // Maior lado de textura aceito pelo driver (limita o tamanho da região guardada).
+    static int getMaxTextureSize()
+    {
+        GLint size = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &size);
+        return size;
+    }
+
+    // Indica se o conteúdo guardado corresponde à versão e ao tamanho de tela dados e
+    // cobre a área (minX, minY)-(maxX, maxY) do mundo.
+    bool covers(unsigned contentVersion, int currentScreenWidth, int currentScreenHeight,
+                float minX, float minY, float maxX, float maxY) const
+    {
+        return supported && valid && version == contentVersion &&
+               screenWidth == currentScreenWidth && screenHeight == currentScreenHeight &&
+               minX >= originX && minY >= originY && maxX <= originX + width && maxY <= originY + height;
+    }
+
+    // O cache pode ser usado (a última cópia não falhou).
+    bool isSupported() const { return supported; }
+
+    // Força o próximo quadro a redesenhar e recapturar a camada.
+    void invalidate() { valid = false; }
+
+    // Desenha a região (x, y)-(x + w, y + h) do mundo, que deve ser ao menos do tamanho da
+    // tela, e a guarda na textura. Para cada ladrilho, coloca a câmera no seu canto e chama
+    // drawTile(tileX, tileY), que deve cobrir o ladrilho inteiro. No fim, o back buffer tem
+    // só o último ladrilho e a câmera fica nele: o chamador volta à sua câmera e desenha a
+    // camada com draw(). Retorna false se a cópia falhou (o cache se desativa).
+    template <typename DrawTile>
+    bool capture(unsigned contentVersion, int currentScreenWidth, int currentScreenHeight,
+                 int x, int y, int w, int h, DrawTile drawTile)
+    {
+        valid = false;
+        if (!supported || currentScreenWidth <= 0 || currentScreenHeight <= 0) return false;
+        if (w < currentScreenWidth || h < currentScreenHeight) return false;
+        while (glGetError() != GL_NO_ERROR) {}
+
+        if (!texture) glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        int tw = nextPowerOfTwo(w), th = nextPowerOfTwo(h);
+        if (tw != textureWidth || th != textureHeight) {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, tw, th, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+            textureWidth = tw;
+            textureHeight = th;
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        if (glGetError() != GL_NO_ERROR) {
+            supported = false;
+            return false;
+        }
+
+        glReadBuffer(GL_BACK);
+        // o último ladrilho de cada linha e coluna é encostado no fim da região (sobrepõe o anterior)
+        for (int row = 0; ; row += currentScreenHeight) {
+            int tileY = std::min(row, h - currentScreenHeight);
+            for (int column = 0; ; column += currentScreenWidth) {
+                int tileX = std::min(column, w - currentScreenWidth);
+                CV::camera((float)(x + tileX), (float)(y + tileY));
+                drawTile((float)(x + tileX), (float)(y + tileY));
+                // a linha 0 da textura, como a do framebuffer, é a de baixo da tela
+#if Y_CANVAS_CRESCE_PARA_CIMA == TRUE
+                int textureRow = tileY;
+#else
+                int textureRow = h - currentScreenHeight - tileY;
+#endif
+                glBindTexture(GL_TEXTURE_2D, texture);
+                glCopyTexSubImage2D(GL_TEXTURE_2D, 0, tileX, textureRow, 0, 0, currentScreenWidth, currentScreenHeight);
+                glBindTexture(GL_TEXTURE_2D, 0);
+                if (column + currentScreenWidth >= w) break;
+            }
+            if (row + currentScreenHeight >= h) break;
+        }
+
+        if (glGetError() != GL_NO_ERROR) {
+            supported = false;
+            return false;
+        }
+        screenWidth = currentScreenWidth;
+        screenHeight = currentScreenHeight;
+        originX = x;
+        originY = y;
+        width = w;
+        height = h;
+        version = contentVersion;
+        valid = true;
+        return true;
+    }
+
+    // Desenha a região guardada no seu lugar do mundo (com a câmera atual): um retângulo texturizado.
+    void draw() const
+    {
+        if (!valid) return;
+        float s = width / (float)textureWidth, t = height / (float)textureHeight;
+
+        glEnable(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+        glColor3f(1, 1, 1);
+#if Y_CANVAS_CRESCE_PARA_CIMA == TRUE
+        float y0 = (float)originY, y1 = (float)(originY + height);
+#else
+        float y0 = (float)(originY + height), y1 = (float)originY;
+#endif
+        float x0 = (float)originX, x1 = (float)(originX + width);
+        glBegin(GL_QUADS);
+            glTexCoord2f(0, 0); glVertex2f(x0, y0);
+            glTexCoord2f(s, 0); glVertex2f(x1, y0);
+            glTexCoord2f(s, t); glVertex2f(x1, y1);
+            glTexCoord2f(0, t); glVertex2f(x0, y1);
+        glEnd();
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDisable(GL_TEXTURE_2D);
+    }
+};
+
+#endif
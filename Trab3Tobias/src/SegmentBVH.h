@@ -0,0 +1,177 @@
+// Este arquivo define a classe SegmentBVH, uma hierarquia de caixas envolventes (BVH)
+// sobre as arestas de uma curva fechada (poligonal). Cada folha guarda poucas arestas e
+// cada nó interno a caixa que envolve as dos filhos; a árvore é construída dividindo as
+// arestas pela mediana do centro, no eixo mais longo da caixa.
+// Consultas (O(log n) em média):
+// - closestDistanceSquared: distância de um ponto até a aresta mais próxima da curva,
+//   limitada a uma distância máxima (ramos mais distantes que o limite são descartados);
+// - forEachEdgeInBox: visita as arestas cuja caixa cruza uma caixa dada (usada para
+//   procurar cruzamentos entre arestas).
+// Os nós ficam em pré-ordem em um vetor: o filho esquerdo é o nó seguinte e o direito
+// é indicado pelo índice guardado no nó.
+#ifndef ___SEGMENT_BVH__H___
+#define ___SEGMENT_BVH__H___
+
+#include <vector>
+#include <algorithm>
+#include "Vector2.h"
+
+#define SEGMENT_BVH_LEAF_SIZE 4
+#define SEGMENT_BVH_MAX_DEPTH 64
+
+class SegmentBVH
+{
+public:
+    struct Edge {
+        Vector2 a, b;
+        int index; // a aresta vai do ponto index ao ponto index + 1 da curva
+    };
+
+private:
+    struct Node {
+        float minX, minY, maxX, maxY;
+        int right; // índice do filho direito (nós internos)
+        int first; // primeira aresta da folha (em edges)
+        int count; // número de arestas da folha (0 em nós internos)
+    };
+
+    std::vector<Edge> edges; // arestas, na ordem das folhas
+    std::vector<Node> nodes;
+
+    static float boxDistanceSquared(const Node& node, const Vector2& p)
+    {
+        float dx = std::max(0.0f, std::max(node.minX - p.x, p.x - node.maxX));
+        float dy = std::max(0.0f, std::max(node.minY - p.y, p.y - node.maxY));
+        return dx * dx + dy * dy;
+    }
+
+    static float pointSegmentDistanceSquared(const Vector2& p, const Vector2& a, const Vector2& b, Vector2& closest)
+    {
+        Vector2 ab = b - a;
+        float lengthSquared = ab.lengthSquared();
+        float t = (lengthSquared > 0.0f) ? ((p.x - a.x) * ab.x + (p.y - a.y) * ab.y) / lengthSquared : 0.0f;
+        t = std::max(0.0f, std::min(1.0f, t));
+        closest = a + ab * t;
+        return (p - closest).lengthSquared();
+    }
+
+    // Constrói o nó das arestas [first, first + count) e seus filhos; retorna o índice do nó.
+    int buildNode(int first, int count, int depth)
+    {
+        int index = (int)nodes.size();
+        nodes.push_back(Node());
+        Node node;
+        node.minX = node.minY = 1e30f;
+        node.maxX = node.maxY = -1e30f;
+        for (int i = first; i < first + count; ++i) {
+            const Edge& e = edges[i];
+            node.minX = std::min(node.minX, std::min(e.a.x, e.b.x));
+            node.minY = std::min(node.minY, std::min(e.a.y, e.b.y));
+            node.maxX = std::max(node.maxX, std::max(e.a.x, e.b.x));
+            node.maxY = std::max(node.maxY, std::max(e.a.y, e.b.y));
+        }
+        node.right = -1;
+        node.first = first;
+        node.count = count;
+
+        if (count > SEGMENT_BVH_LEAF_SIZE && depth < SEGMENT_BVH_MAX_DEPTH - 1) {
+            bool splitX = (node.maxX - node.minX) >= (node.maxY - node.minY);
+            int half = count / 2;
+            std::nth_element(edges.begin() + first, edges.begin() + first + half, edges.begin() + first + count,
+                             [splitX](const Edge& l, const Edge& r) {
+                                 return splitX ? (l.a.x + l.b.x) < (r.a.x + r.b.x) : (l.a.y + l.b.y) < (r.a.y + r.b.y);
+                             });
+            node.count = 0;
+            buildNode(first, half, depth + 1);
+            node.right = buildNode(first + half, count - half, depth + 1);
+        }
+        nodes[index] = node;
+        return index;
+    }
+
+public:
+    // Reconstrói a hierarquia sobre as arestas da curva fechada.
+    void build(const std::vector<Vector2>& curve)
+    {
+        edges.clear();
+        nodes.clear();
+        size_t n = curve.size();
+        if (n < 2) return;
+        edges.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            edges[i].a = curve[i];
+            edges[i].b = curve[(i + 1) % n];
+            edges[i].index = (int)i;
+        }
+        nodes.reserve(2 * (n / SEGMENT_BVH_LEAF_SIZE + 1));
+        buildNode(0, (int)n, 0);
+    }
+
+    bool empty() const { return nodes.empty(); }
+
+    // Distância ao quadrado do ponto p até a aresta mais próxima, se for menor que
+    // maxDistanceSquared; preenche o ponto mais próximo e o índice da aresta. Se nenhuma
+    // aresta está mais perto que o limite, retorna maxDistanceSquared e edgeIndex = -1.
+    float closestDistanceSquared(const Vector2& p, float maxDistanceSquared, Vector2& closest, int& edgeIndex) const
+    {
+        float best = maxDistanceSquared;
+        edgeIndex = -1;
+        if (nodes.empty()) return best;
+
+        int stack[SEGMENT_BVH_MAX_DEPTH];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            int index = stack[--top];
+            const Node& node = nodes[index];
+            if (boxDistanceSquared(node, p) >= best) continue;
+            if (node.count > 0) {
+                for (int i = node.first; i < node.first + node.count; ++i) {
+                    Vector2 c;
+                    float d = pointSegmentDistanceSquared(p, edges[i].a, edges[i].b, c);
+                    if (d < best) {
+                        best = d;
+                        closest = c;
+                        edgeIndex = edges[i].index;
+                    }
+                }
+                continue;
+            }
+            // visita primeiro o filho mais próximo (empilhado por último)
+            int left = index + 1;
+            int right = node.right;
+            if (boxDistanceSquared(nodes[left], p) < boxDistanceSquared(nodes[right], p)) std::swap(left, right);
+            stack[top++] = left;
+            stack[top++] = right;
+        }
+        return best;
+    }
+
+    // Chama callback(edge) para cada aresta cuja caixa cruza a caixa dada.
+    template <typename Callback>
+    void forEachEdgeInBox(float minX, float minY, float maxX, float maxY, Callback callback) const
+    {
+        if (nodes.empty()) return;
+        int stack[SEGMENT_BVH_MAX_DEPTH];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            int index = stack[--top];
+            const Node& node = nodes[index];
+            if (node.minX > maxX || node.maxX < minX || node.minY > maxY || node.maxY < minY) continue;
+            if (node.count > 0) {
+                for (int i = node.first; i < node.first + node.count; ++i) {
+                    const Edge& e = edges[i];
+                    if (std::min(e.a.x, e.b.x) > maxX || std::max(e.a.x, e.b.x) < minX ||
+                        std::min(e.a.y, e.b.y) > maxY || std::max(e.a.y, e.b.y) < minY) continue;
+                    callback(e);
+                }
+                continue;
+            }
+            stack[top++] = node.right;
+            stack[top++] = index + 1;
+        }
+    }
+};
+
+#endif
@@ -130,16 +130,16 @@ public:
         float shieldW = width * 0.7f; 
         float shieldH = height * 0.75f; 
 
-        std::vector<Vector2> outlineVertices;
-        outlineVertices.push_back(Vector2(iconCenterX, iconCenterY + shieldH * 0.5f)); 
-        outlineVertices.push_back(Vector2(iconCenterX - shieldW * 0.45f, iconCenterY + shieldH * 0.3f)); 
-        outlineVertices.push_back(Vector2(iconCenterX - shieldW * 0.5f, iconCenterY - shieldH * 0.2f));  
-        outlineVertices.push_back(Vector2(iconCenterX - shieldW * 0.15f, iconCenterY - shieldH * 0.5f)); 
-        outlineVertices.push_back(Vector2(iconCenterX + shieldW * 0.15f, iconCenterY - shieldH * 0.5f)); 
-        outlineVertices.push_back(Vector2(iconCenterX + shieldW * 0.5f, iconCenterY - shieldH * 0.2f));  
-        outlineVertices.push_back(Vector2(iconCenterX + shieldW * 0.45f, iconCenterY + shieldH * 0.3f)); 
-        
-        int numOutlineVertices = outlineVertices.size();
+        const Vector2 outlineVertices[] = {
+            Vector2(iconCenterX, iconCenterY + shieldH * 0.5f),
+            Vector2(iconCenterX - shieldW * 0.45f, iconCenterY + shieldH * 0.3f),
+            Vector2(iconCenterX - shieldW * 0.5f, iconCenterY - shieldH * 0.2f),
+            Vector2(iconCenterX - shieldW * 0.15f, iconCenterY - shieldH * 0.5f),
+            Vector2(iconCenterX + shieldW * 0.15f, iconCenterY - shieldH * 0.5f),
+            Vector2(iconCenterX + shieldW * 0.5f, iconCenterY - shieldH * 0.2f),
+            Vector2(iconCenterX + shieldW * 0.45f, iconCenterY + shieldH * 0.3f)
+        };
+        const int numOutlineVertices = 7;
         float outlineVx[numOutlineVertices];
         float outlineVy[numOutlineVertices];
         for(int i=0; i < numOutlineVertices; ++i) {
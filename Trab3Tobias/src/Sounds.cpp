@@ -0,0 +1,103 @@
+// Este arquivo implementa registerGameSounds: a síntese de cada efeito sonoro do jogo
+// em PCM mono de 16 bits, na taxa do AudioMixer. O ruído usa um Random com semente fixa,
+// então os sons são sempre os mesmos.
+#include "Sounds.h"
+#include "Random.h"
+#include <cmath>
+
+#define SOUND_TWO_PI 6.28318531f
+#define SOUND_NOISE_SEED 7u
+
+static_assert(SOUND_COUNT <= AUDIO_MAX_SOUNDS, "sons demais para o mixer");
+
+// Converte amostras em [-1, 1] para PCM de 16 bits.
+static std::vector<int16_t> toPcm(const std::vector<float>& samples)
+{
+    std::vector<int16_t> pcm(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        float s = std::max(-1.0f, std::min(1.0f, samples[i]));
+        pcm[i] = (int16_t)(s * 32767.0f);
+    }
+    return pcm;
+}
+
+// Disparo: estalo de ruído e um tom quadrado descendo de 900 a 250 Hz, com decaimento rápido.
+static std::vector<int16_t> synthesizeShot(Random& noise)
+{
+    int length = AUDIO_SAMPLE_RATE * 12 / 100;
+    std::vector<float> samples(length);
+    float phase = 0.0f;
+    for (int i = 0; i < length; ++i) {
+        float t = i / (float)length;
+        float frequency = 900.0f * powf(250.0f / 900.0f, t);
+        phase += frequency / AUDIO_SAMPLE_RATE;
+        phase -= floorf(phase);
+        float tone = phase < 0.5f ? 1.0f : -1.0f;
+        float crack = (noise.nextFloat() * 2.0f - 1.0f) * expf(-t * 40.0f);
+        samples[i] = (0.35f * tone + 0.6f * crack) * expf(-t * 6.0f);
+    }
+    return toPcm(samples);
+}
+
+// Explosão: ruído passado por um filtro passa-baixas que fecha com o tempo, com um
+// estrondo grave (60 Hz) no início.
+static std::vector<int16_t> synthesizeExplosion(Random& noise)
+{
+    int length = AUDIO_SAMPLE_RATE * 8 / 10;
+    std::vector<float> samples(length);
+    float filtered = 0.0f;
+    for (int i = 0; i < length; ++i) {
+        float t = i / (float)length;
+        float cutoff = 0.35f * expf(-t * 4.0f) + 0.02f; // coeficiente do filtro de um polo
+        filtered += cutoff * ((noise.nextFloat() * 2.0f - 1.0f) - filtered);
+        float rumble = sinf(SOUND_TWO_PI * 60.0f * i / AUDIO_SAMPLE_RATE) * expf(-t * 8.0f);
+        float attack = std::min(1.0f, i / (AUDIO_SAMPLE_RATE * 0.005f));
+        samples[i] = attack * (1.6f * filtered + 0.5f * rumble) * expf(-t * 3.5f);
+    }
+    return toPcm(samples);
+}
+
+// Bomba: assobio senoidal descendo de 1400 a 500 Hz, entrando e saindo suavemente.
+static std::vector<int16_t> synthesizeBombDrop()
+{
+    int length = AUDIO_SAMPLE_RATE * 6 / 10;
+    std::vector<float> samples(length);
+    float phase = 0.0f;
+    for (int i = 0; i < length; ++i) {
+        float t = i / (float)length;
+        phase += (1400.0f - 900.0f * t) / AUDIO_SAMPLE_RATE;
+        phase -= floorf(phase);
+        float envelope = sinf(t * SOUND_TWO_PI * 0.5f);
+        samples[i] = 0.4f * envelope * sinf(SOUND_TWO_PI * phase);
+    }
+    return toPcm(samples);
+}
+
+// Habilidade: arpejo ascendente de três notas (dó, mi, sol) em onda triangular.
+static std::vector<int16_t> synthesizePowerUp()
+{
+    const float notes[] = { 523.25f, 659.25f, 783.99f };
+    int noteLength = AUDIO_SAMPLE_RATE * 11 / 100;
+    std::vector<float> samples(noteLength * 3);
+    float phase = 0.0f;
+    for (int i = 0; i < (int)samples.size(); ++i) {
+        int note = i / noteLength;
+        float t = (i % noteLength) / (float)noteLength;
+        phase += notes[note] / AUDIO_SAMPLE_RATE;
+        phase -= floorf(phase);
+        float triangle = 4.0f * fabsf(phase - 0.5f) - 1.0f;
+        float envelope = std::min(1.0f, t * 20.0f) * (1.0f - 0.6f * t);
+        samples[i] = 0.5f * envelope * triangle;
+    }
+    return toPcm(samples);
+}
+
+// Sintetiza e carrega no mixer todos os sons do jogo.
+void registerGameSounds(AudioMixer& mixer)
+{
+    Random noise(SOUND_NOISE_SEED);
+    mixer.load(SOUND_SHOT, synthesizeShot(noise));
+    mixer.load(SOUND_EXPLOSION, synthesizeExplosion(noise));
+    mixer.load(SOUND_BOMB_DROP, synthesizeBombDrop());
+    mixer.load(SOUND_POWER_UP, synthesizePowerUp());
+}
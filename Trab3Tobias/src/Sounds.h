@@ -0,0 +1,22 @@
+// Este arquivo define os identificadores dos efeitos sonoros do jogo carregados no
+// AudioMixer e a função que os sintetiza e carrega.
+// Os sons são gerados por código na inicialização (tons, varreduras e ruído filtrado),
+// como os sprites do SpriteAtlas, então o jogo não depende de arquivos de áudio.
+#ifndef ___SOUNDS__H___
+#define ___SOUNDS__H___
+
+#include "AudioMixer.h"
+
+enum SoundId
+{
+    SOUND_SHOT,       // disparo do tanque
+    SOUND_EXPLOSION,  // explosão (impactos, inimigos destruídos, bombas)
+    SOUND_BOMB_DROP,  // assobio da bomba solta pelo avião
+    SOUND_POWER_UP,   // ativação de uma habilidade (nitro, tiro rápido, super rajada, escudo)
+    SOUND_COUNT
+};
+
+// Sintetiza e carrega no mixer todos os sons do jogo (antes de start).
+void registerGameSounds(AudioMixer& mixer);
+
+#endif
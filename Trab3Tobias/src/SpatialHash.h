@@ -0,0 +1,174 @@
+// Este arquivo define a classe SpatialHash, a fase ampla (broadphase) das colisões.
+// Cada entidade é inserida com sua caixa envolvente (AABB) e recebe um handle
+// sequencial (0, 1, 2, ...), estável até a próxima reconstrução. Inserindo as
+// entidades na ordem de um vetor, o handle coincide com o índice no vetor.
+// As células da grade são espalhadas em uma tabela de tamanho fixo (potência de 2)
+// e os baldes são montados por ordenação por contagem, sem alocar por célula (o vetor
+// auxiliar da montagem fica na FrameArena).
+// Uma consulta por AABB visita somente as entidades das células tocadas, sem
+// repetições, para que os testes exatos (SAT) rodem apenas entre pares próximos.
+// Cada entidade aparece no máximo uma vez em cada balde e só é reportada na primeira
+// célula (em ordem de linha) comum a ela e à consulta; assim a consulta não guarda
+// estado e pode ser feita por várias threads ao mesmo tempo.
+#ifndef ___SPATIAL_HASH__H___
+#define ___SPATIAL_HASH__H___
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "Vector2.h"
+#include "ConvexPolygon.h"
+#include "FrameArena.h"
+
+class SpatialHash
+{
+    struct Box {
+        float minX, minY, maxX, maxY;
+        int cellX, cellY; // primeira célula coberta pela caixa
+    };
+
+    float cellSize;
+    float invCellSize;
+    unsigned tableMask;
+
+    std::vector<Box> boxes;          // AABB de cada handle
+    std::vector<unsigned> entryKeys; // (balde, handle) de cada célula tocada, antes da ordenação
+    std::vector<int> entryHandles;
+    std::vector<int> bucketStart;    // tamanho da tabela + 1
+    std::vector<int> bucketHandles;
+
+    unsigned bucketOf(int cx, int cy) const
+    {
+        return ((unsigned)cx * 73856093u ^ (unsigned)cy * 19349663u) & tableMask;
+    }
+
+    int cellCoord(float v) const
+    {
+        return (int)std::floor(v * invCellSize);
+    }
+
+public:
+    // cellSize deve ser da ordem do tamanho das entidades; a tabela tem 2^tableBits baldes.
+    SpatialHash(float cellSize = 64.0f, int tableBits = 10)
+        : cellSize(cellSize), invCellSize(1.0f / cellSize), tableMask((1u << tableBits) - 1)
+    {
+        bucketStart.assign(tableMask + 2, 0);
+    }
+
+    // Remove todas as entidades (os handles anteriores deixam de valer).
+    void clear()
+    {
+        boxes.clear();
+        entryKeys.clear();
+        entryHandles.clear();
+    }
+
+    // Insere uma entidade e retorna seu handle. Só fica visível às consultas após build().
+    int insert(float minX, float minY, float maxX, float maxY)
+    {
+        int handle = (int)boxes.size();
+        int cx0 = cellCoord(minX), cx1 = cellCoord(maxX);
+        int cy0 = cellCoord(minY), cy1 = cellCoord(maxY);
+        Box b = { minX, minY, maxX, maxY, cx0, cy0 };
+        boxes.push_back(b);
+
+        size_t first = entryKeys.size();
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                unsigned bucket = bucketOf(cx, cy);
+                // células da mesma entidade que caem no mesmo balde geram uma só entrada
+                if (std::find(entryKeys.begin() + first, entryKeys.end(), bucket) != entryKeys.end()) continue;
+                entryKeys.push_back(bucket);
+                entryHandles.push_back(handle);
+            }
+        }
+        return handle;
+    }
+
+    // Insere a AABB de um conjunto de vértices, ampliada por margin.
+    int insert(const std::vector<Vector2>& vertices, float margin = 0.0f)
+    {
+        if (vertices.empty()) return insert(0, 0, -1, -1);
+        float minX = vertices[0].x, maxX = minX, minY = vertices[0].y, maxY = minY;
+        for (size_t i = 1; i < vertices.size(); ++i) {
+            minX = std::min(minX, vertices[i].x); maxX = std::max(maxX, vertices[i].x);
+            minY = std::min(minY, vertices[i].y); maxY = std::max(maxY, vertices[i].y);
+        }
+        return insert(minX - margin, minY - margin, maxX + margin, maxY + margin);
+    }
+
+    // Monta os baldes (ordenação por contagem das entradas pelo índice do balde).
+    void build()
+    {
+        int tableSize = (int)tableMask + 1;
+        bucketStart.assign(tableSize + 1, 0);
+        for (size_t i = 0; i < entryKeys.size(); ++i) {
+            bucketStart[entryKeys[i] + 1]++;
+        }
+        for (int b = 0; b < tableSize; ++b) {
+            bucketStart[b + 1] += bucketStart[b];
+        }
+        bucketHandles.resize(entryKeys.size());
+        FrameVector<int> fill(bucketStart.begin(), bucketStart.end() - 1);
+        for (size_t i = 0; i < entryKeys.size(); ++i) {
+            bucketHandles[fill[entryKeys[i]]++] = entryHandles[i];
+        }
+    }
+
+    // Chama callback(handle) uma vez para cada entidade cuja AABB intercepta a AABB dada.
+    // O callback pode retornar false para interromper a consulta.
+    template <typename Callback>
+    void query(float minX, float minY, float maxX, float maxY, Callback callback) const
+    {
+        if (boxes.empty()) return;
+        int cx0 = cellCoord(minX), cx1 = cellCoord(maxX);
+        int cy0 = cellCoord(minY), cy1 = cellCoord(maxY);
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                unsigned bucket = bucketOf(cx, cy);
+                for (int k = bucketStart[bucket]; k < bucketStart[bucket + 1]; ++k) {
+                    int handle = bucketHandles[k];
+                    const Box& b = boxes[handle];
+                    if (b.maxX < minX || b.minX > maxX || b.maxY < minY || b.minY > maxY) continue;
+                    // reporta só na primeira célula comum (as outras são repetições ou colisões do hash)
+                    if (cx != std::max(cx0, b.cellX) || cy != std::max(cy0, b.cellY)) continue;
+                    if (!callback(handle)) return;
+                }
+            }
+        }
+    }
+
+    // Consulta pela AABB de um conjunto de vértices, ampliada por margin.
+    template <typename Callback>
+    void query(const std::vector<Vector2>& vertices, float margin, Callback callback) const
+    {
+        if (vertices.empty()) return;
+        float minX = vertices[0].x, maxX = minX, minY = vertices[0].y, maxY = minY;
+        for (size_t i = 1; i < vertices.size(); ++i) {
+            minX = std::min(minX, vertices[i].x); maxX = std::max(maxX, vertices[i].x);
+            minY = std::min(minY, vertices[i].y); maxY = std::max(maxY, vertices[i].y);
+        }
+        query(minX - margin, minY - margin, maxX + margin, maxY + margin, callback);
+    }
+
+    // Consulta pela AABB em cache de um ConvexPolygon, ampliada por margin.
+    template <typename Callback>
+    void query(const ConvexPolygon& polygon, float margin, Callback callback) const
+    {
+        if (polygon.empty()) return;
+        query(polygon.getMinX() - margin, polygon.getMinY() - margin,
+              polygon.getMaxX() + margin, polygon.getMaxY() + margin, callback);
+    }
+
+    // Consulta por um círculo (usa a AABB do círculo).
+    template <typename Callback>
+    void query(const Vector2& center, float radius, Callback callback) const
+    {
+        query(center.x - radius, center.y - radius, center.x + radius, center.y + radius, callback);
+    }
+
+    int size() const { return (int)boxes.size(); }
+    float getCellSize() const { return cellSize; }
+};
+
+#endif
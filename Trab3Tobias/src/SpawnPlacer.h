@@ -0,0 +1,166 @@
+// Este arquivo define a classe SpawnPlacer, que escolhe as posições iniciais dos inimigos.
+// A área dirigível é rasterizada uma única vez, em uma máscara de células pequenas que
+// guarda a folga (distância até a borda, lida do SDF da pista) do centro de cada célula.
+// A distribuição é um Poisson-disk por lançamento sequencial: as células da máscara são
+// percorridas em ordem aleatória (embaralhadas sob demanda); cada inimigo ocupa um ponto
+// sorteado na primeira célula que o comporta por inteiro: todo ponto da célula tem folga
+// para o seu tamanho e fica longe do tanque e dos outros inimigos (o teste é feito no
+// centro, com meia diagonal de margem). Os inimigos já posicionados ficam em uma grade
+// de fundo, então cada teste de vizinhança olha só as células vizinhas.
+// Como o teste não depende do ponto sorteado e os inimigos só acrescentam restrições,
+// uma célula recusada para um tamanho nunca volta a servir para esse tamanho: cada
+// tamanho tem seu cursor na lista, que só avança.
+// Posicionar N inimigos custa O(N) mais uma passada pela máscara, e o posicionamento
+// só falha quando nenhuma célula da pista comporta o inimigo por inteiro.
+#ifndef ___SPAWN_PLACER__H___
+#define ___SPAWN_PLACER__H___
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "Vector2.h"
+#include "Track.h"
+#include "Random.h"
+
+#define SPAWN_MASK_CELL_SIZE 4.0f
+
+class SpawnPlacer
+{
+    struct Cursor {
+        float clearance;
+        size_t next;
+    };
+
+    // máscara da área dirigível
+    float maskCellSize;
+    int maskCellsX, maskCellsY;
+    std::vector<float> maskClearance; // folga do centro de cada célula (negativa fora da pista)
+    std::vector<int> candidates;      // células com folga positiva
+    size_t shuffled;                  // candidates[0, shuffled) já estão embaralhadas
+    std::vector<Cursor> cursors;      // posição na lista de candidatos para cada folga pedida
+
+    // grade de fundo dos inimigos já posicionados
+    float gridCellSize;
+    int gridCellsX, gridCellsY;
+    std::vector<int> gridHead; // primeiro ponto de cada célula (-1 = vazia)
+    std::vector<int> gridNext; // próximo ponto na mesma célula
+    std::vector<Vector2> points;
+    std::vector<float> pointRadii;
+
+    size_t& cursorFor(float clearance)
+    {
+        for (auto& c : cursors) {
+            if (c.clearance == clearance) return c.next;
+        }
+        Cursor c = { clearance, 0 };
+        cursors.push_back(c);
+        return cursors.back().next;
+    }
+
+    float maskHalfDiagonal() const { return maskCellSize * 0.7072f; }
+
+    int gridCoord(float v, int cells) const
+    {
+        return std::max(0, std::min(cells - 1, (int)(v / gridCellSize)));
+    }
+
+    // Verifica se um inimigo com folga clearance cabe em p sem ficar perto dos já posicionados.
+    bool isFarFromPoints(const Vector2& p, float clearance, float spacing) const
+    {
+        int cx = gridCoord(p.x, gridCellsX), cy = gridCoord(p.y, gridCellsY);
+        for (int y = std::max(0, cy - 1); y <= std::min(gridCellsY - 1, cy + 1); ++y) {
+            for (int x = std::max(0, cx - 1); x <= std::min(gridCellsX - 1, cx + 1); ++x) {
+                for (int i = gridHead[y * gridCellsX + x]; i >= 0; i = gridNext[i]) {
+                    float minDistance = pointRadii[i] + clearance + spacing;
+                    if ((p - points[i]).lengthSquared() < minDistance * minDistance) return false;
+                }
+            }
+        }
+        return true;
+    }
+
+public:
+    SpawnPlacer() : maskCellSize(SPAWN_MASK_CELL_SIZE), maskCellsX(0), maskCellsY(0), shuffled(0),
+                    gridCellSize(1.0f), gridCellsX(0), gridCellsY(0) {}
+
+    // Rasteriza a área dirigível da pista (dentro do mundo). maxSpacing é a maior distância
+    // exigida entre dois inimigos e define o tamanho das células da grade de fundo.
+    void build(const Track& track, int worldWidth, int worldHeight, float maxSpacing)
+    {
+        maskCellsX = std::max(1, (int)std::ceil(worldWidth / maskCellSize));
+        maskCellsY = std::max(1, (int)std::ceil(worldHeight / maskCellSize));
+        maskClearance.resize(maskCellsX * maskCellsY);
+        candidates.clear();
+        for (int y = 0; y < maskCellsY; ++y) {
+            for (int x = 0; x < maskCellsX; ++x) {
+                int cell = y * maskCellsX + x;
+                maskClearance[cell] = track.signedDistance(Vector2((x + 0.5f) * maskCellSize, (y + 0.5f) * maskCellSize));
+                if (maskClearance[cell] > 0.0f) candidates.push_back(cell);
+            }
+        }
+
+        // o teste de vizinhança usa o centro da célula da máscara, com meia diagonal a mais
+        gridCellSize = std::max(maxSpacing + maskHalfDiagonal(), 1.0f);
+        gridCellsX = std::max(1, (int)std::ceil(worldWidth / gridCellSize));
+        gridCellsY = std::max(1, (int)std::ceil(worldHeight / gridCellSize));
+        gridHead.assign(gridCellsX * gridCellsY, -1);
+        points.clear();
+        pointRadii.clear();
+        gridNext.clear();
+        cursors.clear();
+        shuffled = 0;
+    }
+
+    // Remove os inimigos posicionados e recomeça a ordem aleatória das células.
+    void reset()
+    {
+        shuffled = 0;
+        std::fill(gridHead.begin(), gridHead.end(), -1);
+        points.clear();
+        pointRadii.clear();
+        gridNext.clear();
+        cursors.clear();
+    }
+
+    // Posiciona um inimigo que precisa de clearance pixels de pista ao seu redor, a pelo
+    // menos (raio do outro + clearance + spacing) de cada inimigo já posicionado e a pelo
+    // menos (avoidDistance + clearance) de avoidPoint. radius é o raio que o inimigo
+    // ocupa para os próximos. A folga vem da máscara rasterizada em build. Retorna false
+    // se não há mais lugar para ele.
+    bool place(float clearance, float radius, float spacing, const Vector2& avoidPoint,
+               float avoidDistance, Random& rng, Vector2& out)
+    {
+        // todo ponto da célula está a no máximo meia diagonal do centro e o SDF varia no
+        // máximo 1 pixel por pixel: as restrições testadas no centro com essa margem valem
+        // para qualquer ponto da célula
+        float halfDiagonal = maskHalfDiagonal();
+        float avoid = avoidDistance + clearance + halfDiagonal;
+        size_t& next = cursorFor(clearance);
+        for (; next < candidates.size(); ++next) {
+            // Fisher-Yates incremental: só a parte da lista já visitada é embaralhada
+            for (; shuffled <= next; ++shuffled) {
+                std::swap(candidates[shuffled], candidates[shuffled + rng.nextInt((int)(candidates.size() - shuffled))]);
+            }
+            int cell = candidates[next];
+            if (maskClearance[cell] - halfDiagonal <= clearance) continue;
+
+            int cx = cell % maskCellsX, cy = cell / maskCellsX;
+            Vector2 center((cx + 0.5f) * maskCellSize, (cy + 0.5f) * maskCellSize);
+            if ((center - avoidPoint).lengthSquared() < avoid * avoid) continue;
+            if (!isFarFromPoints(center, clearance + halfDiagonal, spacing)) continue;
+
+            Vector2 p((cx + rng.nextFloat()) * maskCellSize, (cy + rng.nextFloat()) * maskCellSize);
+            int g = gridCoord(p.y, gridCellsY) * gridCellsX + gridCoord(p.x, gridCellsX);
+            gridNext.push_back(gridHead[g]);
+            gridHead[g] = (int)points.size();
+            points.push_back(p);
+            pointRadii.push_back(radius);
+            out = p;
+            ++next;
+            return true;
+        }
+        return false;
+    }
+};
+
+#endif
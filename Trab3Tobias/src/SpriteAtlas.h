@@ -0,0 +1,252 @@
+// Este arquivo define a classe SpriteAtlas, um atlas de sprites montado na inicialização.
+// Formas procedurais fixas (que no jogo só são transladadas, giradas e escaladas) são
+// desenhadas uma única vez, cada uma em uma célula de uma textura; depois cada sprite é
+// desenhado como um único retângulo texturizado e transformado, em vez das dezenas ou
+// centenas de primitivas da forma original.
+// O cozimento (bake) usa só OpenGL 1.1: cada sprite é desenhado no canto do back buffer
+// duas vezes, sobre fundo preto e sobre fundo branco, e lido com glReadPixels; a diferença
+// entre as duas leituras dá a opacidade (alpha) de cada pixel. A imagem RGBA do atlas é
+// montada na CPU e enviada à textura de uma vez. O cozimento é feito no primeiro quadro
+// desenhado, antes de limpar a tela (é preciso uma janela); no modo headless nada é
+// desenhado e o atlas não é montado.
+// Se o cozimento falhar (erro do OpenGL, sprite maior que a tela ou atlas cheio), o atlas
+// fica indisponível e os donos dos sprites continuam a desenhá-los proceduralmente.
+#ifndef ___SPRITE_ATLAS__H___
+#define ___SPRITE_ATLAS__H___
+
+#include <vector>
+#include <functional>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <algorithm>
+#include "gl_canvas2d.h"
+#include "Vector2.h"
+
+#define SPRITE_ATLAS_SIZE 1024   // largura e altura da textura do atlas
+#define SPRITE_ATLAS_PADDING 2   // pixels vazios entre as células (filtro linear)
+#define SPRITE_ATLAS_SEED 7919   // semente de rand() ao desenhar cada sprite (formas com variação)
+
+class SpriteAtlas
+{
+public:
+    // Desenha a forma em coordenadas locais (a origem do sprite em (0, 0)).
+    typedef std::function<void()> DrawFunction;
+
+private:
+    struct Sprite {
+        float minX, minY, maxX, maxY; // caixa local do desenho
+        float bakeScale;              // pixels do atlas por unidade local
+        DrawFunction drawFunction;
+        int x, y, width, height;      // célula no atlas, em pixels
+        bool defined;
+
+        Sprite() : minX(0), minY(0), maxX(0), maxY(0), bakeScale(1), x(0), y(0), width(0), height(0), defined(false) {}
+    };
+
+    std::vector<Sprite> sprites;
+    GLuint texture;
+    bool baked; // o cozimento já foi tentado
+    bool ready; // o atlas pode ser usado
+
+    // Distribui as células em prateleiras (linhas) da esquerda para a direita.
+    bool pack()
+    {
+        int x = 0, y = 0, rowHeight = 0;
+        for (auto& sprite : sprites) {
+            if (!sprite.defined) continue;
+            if (sprite.width > SPRITE_ATLAS_SIZE) return false;
+            if (x + sprite.width > SPRITE_ATLAS_SIZE) {
+                x = 0;
+                y += rowHeight + SPRITE_ATLAS_PADDING;
+                rowHeight = 0;
+            }
+            if (y + sprite.height > SPRITE_ATLAS_SIZE) return false;
+            sprite.x = x;
+            sprite.y = y;
+            x += sprite.width + SPRITE_ATLAS_PADDING;
+            rowHeight = std::max(rowHeight, sprite.height);
+        }
+        return true;
+    }
+
+    // Desenha o sprite id no canto inferior esquerdo da janela, sobre o fundo dado, e lê os pixels.
+    void renderCell(int id, float background, std::vector<unsigned char>& out)
+    {
+        const Sprite& sprite = sprites[id];
+        glScissor(0, 0, sprite.width, sprite.height);
+        glClearColor(background, background, background, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        glLoadIdentity();
+        glScalef(sprite.bakeScale, sprite.bakeScale, 1.0f);
+        glTranslatef(-sprite.minX, -sprite.minY, 0.0f);
+        srand(SPRITE_ATLAS_SEED + id); // as duas passadas precisam desenhar a mesma forma
+        sprite.drawFunction();
+
+        out.resize(sprite.width * sprite.height * 3);
+        glReadPixels(0, 0, sprite.width, sprite.height, GL_RGB, GL_UNSIGNED_BYTE, out.data());
+    }
+
+public:
+    SpriteAtlas() : texture(0), baked(false), ready(false) {}
+
+    ~SpriteAtlas()
+    {
+        if (texture) glDeleteTextures(1, &texture);
+    }
+
+    // Atlas compartilhado pelo programa.
+    static SpriteAtlas& shared()
+    {
+        static SpriteAtlas atlas;
+        return atlas;
+    }
+
+    // Define o sprite id: a forma desenhada por drawFunction ocupa a caixa local dada e é
+    // guardada com bakeScale pixels por unidade (maior que 1 para sprites ampliados no jogo).
+    void define(int id, float minX, float minY, float maxX, float maxY, float bakeScale, const DrawFunction& drawFunction)
+    {
+        if (id >= (int)sprites.size()) sprites.resize(id + 1);
+        Sprite& sprite = sprites[id];
+        sprite.width = std::max(1, (int)std::ceil((maxX - minX) * bakeScale));
+        sprite.height = std::max(1, (int)std::ceil((maxY - minY) * bakeScale));
+        // a caixa é arredondada para pixels inteiros, para que cada texel caia em um pixel
+        sprite.minX = minX;
+        sprite.minY = minY;
+        sprite.maxX = minX + sprite.width / bakeScale;
+        sprite.maxY = minY + sprite.height / bakeScale;
+        sprite.bakeScale = bakeScale;
+        sprite.drawFunction = drawFunction;
+        sprite.defined = true;
+    }
+
+    // Desenha todos os sprites definidos e monta a textura. Deve ser chamado com a janela
+    // criada, antes de limpar a tela para o quadro (usa o canto do back buffer).
+    void bake(int screenWidth, int screenHeight)
+    {
+        baked = true;
+        ready = false;
+        if (sprites.empty() || !pack()) return;
+        for (const auto& sprite : sprites) {
+            if (sprite.defined && (sprite.width > screenWidth || sprite.height > screenHeight)) return;
+        }
+        while (glGetError() != GL_NO_ERROR) {}
+
+        glPushAttrib(GL_COLOR_BUFFER_BIT | GL_SCISSOR_BIT | GL_ENABLE_BIT | GL_CURRENT_BIT);
+        glDisable(GL_BLEND);
+        glEnable(GL_SCISSOR_TEST);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glMatrixMode(GL_PROJECTION);
+        glPushMatrix();
+        glLoadIdentity();
+        gluOrtho2D(0.0, screenWidth, 0.0, screenHeight);
+        glMatrixMode(GL_MODELVIEW);
+        glPushMatrix();
+
+        std::vector<unsigned char> image(SPRITE_ATLAS_SIZE * SPRITE_ATLAS_SIZE * 4, 0);
+        std::vector<unsigned char> onBlack, onWhite;
+        for (int id = 0; id < (int)sprites.size(); ++id) {
+            const Sprite& sprite = sprites[id];
+            if (!sprite.defined) continue;
+            renderCell(id, 0.0f, onBlack);
+            renderCell(id, 1.0f, onWhite);
+            // alpha = 1 - (branco - preto); cor = preto / alpha
+            for (int row = 0; row < sprite.height; ++row) {
+                for (int col = 0; col < sprite.width; ++col) {
+                    const unsigned char* b = &onBlack[(row * sprite.width + col) * 3];
+                    const unsigned char* w = &onWhite[(row * sprite.width + col) * 3];
+                    int difference = 0;
+                    for (int c = 0; c < 3; ++c) difference = std::max(difference, (int)w[c] - (int)b[c]);
+                    int alpha = 255 - std::min(255, difference);
+                    unsigned char* texel = &image[((sprite.y + row) * SPRITE_ATLAS_SIZE + sprite.x + col) * 4];
+                    for (int c = 0; c < 3; ++c) texel[c] = alpha > 0 ? (unsigned char)std::min(255, b[c] * 255 / alpha) : 0;
+                    texel[3] = (unsigned char)alpha;
+                }
+            }
+        }
+
+        glMatrixMode(GL_PROJECTION);
+        glPopMatrix();
+        glMatrixMode(GL_MODELVIEW);
+        glPopMatrix();
+        glPopAttrib();
+        srand((unsigned)time(0)); // devolve a aleatoriedade dos efeitos visuais
+
+        if (!texture) glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, SPRITE_ATLAS_SIZE, SPRITE_ATLAS_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.data());
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        ready = glGetError() == GL_NO_ERROR;
+    }
+
+    // O cozimento já foi tentado (com ou sem sucesso).
+    bool isBaked() const { return baked; }
+
+    // O atlas está pronto: os sprites podem ser desenhados com draw().
+    bool isReady() const { return ready; }
+
+    // Desenho em lote: beginBatch prepara a textura e a mistura uma vez, cada addToBatch
+    // acrescenta um retângulo e endBatch envia tudo em um único glBegin/glEnd. Entre
+    // beginBatch e endBatch não se pode desenhar outra coisa.
+    void beginBatch() const
+    {
+        glEnable(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glBegin(GL_QUADS);
+    }
+
+    // Acrescenta ao lote o sprite id com a origem em position, girado de angle (radianos),
+    // escalado por (scaleX, scaleY) e com a opacidade dada.
+    void addToBatch(int id, const Vector2& position, float angle, float scaleX, float scaleY, float alpha) const
+    {
+        const Sprite& sprite = sprites[id];
+        float c = cos(angle), s = sin(angle);
+        float localX[4] = { sprite.minX, sprite.maxX, sprite.maxX, sprite.minX };
+        float localY[4] = { sprite.minY, sprite.minY, sprite.maxY, sprite.maxY };
+        float u0 = sprite.x / (float)SPRITE_ATLAS_SIZE, u1 = (sprite.x + sprite.width) / (float)SPRITE_ATLAS_SIZE;
+        float v0 = sprite.y / (float)SPRITE_ATLAS_SIZE, v1 = (sprite.y + sprite.height) / (float)SPRITE_ATLAS_SIZE;
+        float u[4] = { u0, u1, u1, u0 };
+        float v[4] = { v0, v0, v1, v1 };
+
+        glColor4f(1, 1, 1, alpha);
+        for (int i = 0; i < 4; ++i) {
+            float x = localX[i] * scaleX, y = localY[i] * scaleY;
+            glTexCoord2f(u[i], v[i]);
+            glVertex2f(position.x + x * c - y * s, position.y + x * s + y * c);
+        }
+    }
+
+    void endBatch() const
+    {
+        glEnd();
+        glDisable(GL_BLEND);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDisable(GL_TEXTURE_2D);
+    }
+
+    // Desenha o sprite id com a origem em position, girado de angle (radianos), escalado por
+    // (scaleX, scaleY) e com a opacidade dada (um lote de um sprite).
+    void draw(int id, const Vector2& position, float angle, float scaleX, float scaleY, float alpha) const
+    {
+        beginBatch();
+        addToBatch(id, position, angle, scaleX, scaleY, alpha);
+        endBatch();
+    }
+
+    void draw(int id, const Vector2& position, float angle = 0.0f, float scale = 1.0f, float alpha = 1.0f) const
+    {
+        draw(id, position, angle, scale, scale, alpha);
+    }
+};
+
+#endif
@@ -0,0 +1,77 @@
+// Este arquivo implementa registerGameSprites: para cada sprite do jogo, a caixa local,
+// a escala de cozimento e o desenho procedural usado para montá-lo no atlas.
+// Os desenhos são os mesmos usados quando o atlas não está disponível, chamados com a
+// origem do sprite em (0, 0), ângulo zero e escala 1; os sprites pequenos e os ampliados
+// no jogo (inimigos, explosões, chama) são guardados com 2 pixels por unidade.
+#include "Sprites.h"
+#include "Tank.h"
+#include "TankRenderer.h"
+#include "Enemies.h"
+#include "Explosion.h"
+#include "NitroBoost.h"
+
+#define SPRITE_MARGIN 2.0f         // folga em torno da forma (linhas e arredondamento)
+#define SPRITE_DETAIL_SCALE 2.0f   // pixels por unidade dos sprites pequenos ou ampliados
+#define NITRO_SPRITE_LENGTH 60.0f  // maior comprimento da chama do nitro, na escala 1
+#define NITRO_SPRITE_HALF_WIDTH 14.0f
+
+static_assert(SPRITE_EXPLOSION_FRAMES == EXPLOSION_FRAMES, "quadros da explosão no atlas");
+static_assert(SPRITE_NITRO_FRAMES == NitroBoost::totalEffectFrames, "quadros da chama do nitro no atlas");
+
+// Registra no atlas a torre (cores normais e do escudo), os inimigos e os quadros da
+// explosão e da chama do nitro.
+void registerGameSprites(SpriteAtlas& atlas)
+{
+    float bodyW = TANK_DEFAULT_WIDTH, bodyH = TANK_DEFAULT_HEIGHT;
+    float turretMinX = -bodyW * 0.25f - SPRITE_MARGIN, turretMaxX = bodyW * 1.25f + SPRITE_MARGIN;
+    float turretHalfH = bodyH * 0.3f + SPRITE_MARGIN;
+    atlas.define(SPRITE_TURRET, turretMinX, -turretHalfH, turretMaxX, turretHalfH, 1.0f, [bodyW, bodyH]() {
+        TankRenderer::drawTurretShape(Vector2(0, 0), 0.0f, bodyW, bodyH, 0.0f);
+    });
+    atlas.define(SPRITE_TURRET_SHIELD, turretMinX, -turretHalfH, turretMaxX, turretHalfH, 1.0f, [bodyW, bodyH]() {
+        TankRenderer::drawTurretShape(Vector2(0, 0), 0.0f, bodyW, bodyH, 1.0f);
+    });
+
+    const int staticLevels[] = { 1, 3 };
+    const int staticSprites[] = { SPRITE_ENEMY_TRIANGLE, SPRITE_ENEMY_GEAR };
+    for (int i = 0; i < 2; ++i) {
+        int level = staticLevels[i];
+        float extent = Enemy::getSizeForLevel(level) + SPRITE_MARGIN;
+        atlas.define(staticSprites[i], -extent, -extent, extent, extent, SPRITE_DETAIL_SCALE, [level]() {
+            Enemy::drawShape(level, Vector2(0, 0), Enemy::getSizeForLevel(level));
+        });
+    }
+
+    float starSize = Enemy::getSizeForLevel(2), starExtent = starSize + SPRITE_MARGIN;
+    atlas.define(SPRITE_ENEMY_STAR, -starExtent, -starExtent, starExtent, starExtent, SPRITE_DETAIL_SCALE, [starSize]() {
+        Vector2 shape[STAR_SHAPE_VERTICES];
+        Enemy::buildStarShape(starSize, shape);
+        StarComponent::drawShape(Vector2(0, 0), shape, starSize, 0.0f);
+    });
+
+    // o avião ocupa ±0.8 * size nos dois eixos (asas e hélice)
+    float planeSize = Enemy::getSizeForLevel(4), planeExtent = planeSize * 0.8f + SPRITE_MARGIN;
+    atlas.define(SPRITE_ENEMY_PLANE, -planeExtent, -planeExtent, planeExtent, planeExtent, SPRITE_DETAIL_SCALE, [planeSize]() {
+        PlaneComponent::drawShape(planeSize);
+    });
+
+    float explosionExtent = EXPLOSION_SPRITE_RADIUS + SPRITE_MARGIN;
+    for (int frame = 0; frame < SPRITE_EXPLOSION_FRAMES; ++frame) {
+        for (int variant = 0; variant < SPRITE_VARIANTS; ++variant) {
+            atlas.define(explosionSprite(frame, variant), -explosionExtent, -explosionExtent, explosionExtent, explosionExtent,
+                         SPRITE_DETAIL_SCALE, [frame]() {
+                drawExplosionSprite(Vector2(0, 0), frame, 1.0f);
+            });
+        }
+    }
+
+    // a chama sai da origem na direção +x
+    for (int frame = 0; frame < SPRITE_NITRO_FRAMES; ++frame) {
+        for (int variant = 0; variant < SPRITE_VARIANTS; ++variant) {
+            atlas.define(nitroSprite(frame, variant), -SPRITE_MARGIN * 2.0f, -NITRO_SPRITE_HALF_WIDTH, NITRO_SPRITE_LENGTH, NITRO_SPRITE_HALF_WIDTH,
+                         SPRITE_DETAIL_SCALE, [frame]() {
+                drawNitroFlameSprite(Vector2(0, 0), Vector2(1, 0), frame, 1.0f);
+            });
+        }
+    }
+}
@@ -0,0 +1,44 @@
+// Este arquivo define os identificadores dos sprites do jogo guardados no SpriteAtlas
+// (torre do tanque, inimigos, quadros da explosão e da chama do nitro) e a função que
+// registra no atlas como desenhar cada um.
+// Os quadros que usam rand() no desenho (tremor da explosão, partículas do nitro) são
+// guardados em SPRITE_VARIANTS variações; a cada quadro desenhado uma delas é sorteada,
+// o que mantém a aparência de chama viva sem redesenhar a forma.
+#ifndef ___SPRITES__H___
+#define ___SPRITES__H___
+
+#include "SpriteAtlas.h"
+
+#define SPRITE_EXPLOSION_FRAMES 7 // quadros da explosão (EXPLOSION_FRAMES)
+#define SPRITE_NITRO_FRAMES 5     // quadros da chama do nitro (NitroBoost::totalEffectFrames)
+#define SPRITE_VARIANTS 4         // variações sorteadas de cada quadro animado
+
+enum SpriteId
+{
+    SPRITE_TURRET,          // torre e canhão nas cores normais
+    SPRITE_TURRET_SHIELD,   // torre e canhão nas cores do escudo
+    SPRITE_ENEMY_TRIANGLE,  // inimigo Nível 1
+    SPRITE_ENEMY_STAR,      // inimigo Nível 2
+    SPRITE_ENEMY_GEAR,      // inimigo Nível 3
+    SPRITE_ENEMY_PLANE,     // inimigo Nível 4
+    SPRITE_EXPLOSION_FIRST, // quadros da explosão, SPRITE_VARIANTS por quadro
+    SPRITE_NITRO_FIRST = SPRITE_EXPLOSION_FIRST + SPRITE_EXPLOSION_FRAMES * SPRITE_VARIANTS,
+    SPRITE_COUNT = SPRITE_NITRO_FIRST + SPRITE_NITRO_FRAMES * SPRITE_VARIANTS
+};
+
+// Sprite de um quadro da explosão (frame) na variação dada.
+inline int explosionSprite(int frame, int variant)
+{
+    return SPRITE_EXPLOSION_FIRST + frame * SPRITE_VARIANTS + variant;
+}
+
+// Sprite de um quadro da chama do nitro (frame) na variação dada.
+inline int nitroSprite(int frame, int variant)
+{
+    return SPRITE_NITRO_FIRST + frame * SPRITE_VARIANTS + variant;
+}
+
+// Registra no atlas todos os sprites do jogo (falta chamar bake).
+void registerGameSprites(SpriteAtlas& atlas);
+
+#endif
@@ -0,0 +1,76 @@
+// Este arquivo define a SpscQueue, uma fila circular de tamanho fixo sem travas para um
+// único produtor e um único consumidor (single producer, single consumer).
+// O produtor só escreve tail e o consumidor só escreve head; cada um lê o índice do
+// outro com acquire e publica o seu com release, então um item escrito antes de push é
+// visto inteiro pelo consumidor depois de pop. Nenhuma operação bloqueia: push falha com
+// a fila cheia e pop falha com a fila vazia.
+// "Único produtor" vale por vez: chamadas de threads diferentes são permitidas se uma
+// terminar antes da outra começar com sincronização entre elas (ex: tarefas seriais de um
+// TaskGraph, ordenadas por dependências).
+#ifndef ___SPSC_QUEUE__H___
+#define ___SPSC_QUEUE__H___
+
+#include <atomic>
+
+// Fila de até Capacity - 1 itens (uma posição fica livre para distinguir cheia de vazia).
+// Capacity deve ser potência de dois.
+template <typename T, unsigned Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity deve ser potencia de dois");
+
+    T items[Capacity];
+    std::atomic<unsigned> head; // próximo item a ler (escrito pelo consumidor)
+    // separa os índices em linhas de cache diferentes (64 bytes), para produtor e
+    // consumidor não disputarem a mesma linha
+    char padding[64 - sizeof(std::atomic<unsigned>)];
+    std::atomic<unsigned> tail; // próxima posição livre (escrita pelo produtor)
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Produtor: adiciona item ao fim. Retorna false (sem esperar) se a fila estiver cheia.
+    bool push(const T& item)
+    {
+        unsigned t = tail.load(std::memory_order_relaxed);
+        unsigned next = (t + 1) & (Capacity - 1);
+        if (next == head.load(std::memory_order_acquire)) return false;
+        items[t] = item;
+        tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor: o primeiro item da fila, sem retirá-lo (nullptr se vazia).
+    const T* front() const
+    {
+        unsigned h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return nullptr;
+        return &items[h];
+    }
+
+    // Consumidor: retira o primeiro item (a fila não pode estar vazia; ver front).
+    void popFront()
+    {
+        head.store((head.load(std::memory_order_relaxed) + 1) & (Capacity - 1), std::memory_order_release);
+    }
+
+    // Consumidor: retira o primeiro item em item. Retorna false se a fila estiver vazia.
+    bool pop(T& item)
+    {
+        const T* first = front();
+        if (!first) return false;
+        item = *first;
+        popFront();
+        return true;
+    }
+
+    // Aproximado se chamado com o produtor ou o consumidor em atividade.
+    bool empty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+
+    static unsigned capacity() { return Capacity - 1; }
+};
+
+#endif
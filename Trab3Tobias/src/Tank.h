@@ -7,11 +7,19 @@
 #include "gl_canvas2d.h" 
 #include "Vector2.h"
 #include <vector>
-#include "Projectile.h"
+#include "ProjectilePool.h"
+#include "ParticleSystem.h"
+#include "DecalLayer.h"
+#include "AudioMixer.h"
+#include "Sounds.h"
 #include <algorithm>
 #include "Enemies.h" 
+#include "EnemyStore.h"
 #include "Track.h"
 #include "CollisionUtils.h" 
+#include "SpatialHash.h"
+#include "ConvexPolygon.h"
+#include "JobSystem.h"
 #include "Explosion.h"
 #include "NitroBoost.h"
 #include "RapidFire.h" 
@@ -21,10 +29,16 @@
 
 #include "TankRenderer.h" 
 
+#define TANK_DEFAULT_HEIGHT 100 // dimensões do tanque do jogo (o sprite da torre é montado com elas)
+#define TANK_DEFAULT_WIDTH 80
+#define TANK_TREAD_DUST_SPACING 4.0f // pixels percorridos entre duas nuvens de poeira das esteiras
+#define TANK_SOUND_PAN_DISTANCE 400.0f // distância horizontal em que um som fica todo de um lado
+#define PROJECTILES_MIN_PER_JOB 256 // projéteis por tarefa na fase paralela de updateProjectiles
+
 class Tank
 {
 public:
-    std::vector<Vector2> vertices;
+    ConvexPolygon vertices; // hitbox (eixos e AABB em cache)
     Vector2 pivot;
     Vector2 direction;
     float baseSpeed; 
@@ -33,13 +47,24 @@ public:
     float bodyH;
     float health;
 
-    std::vector<Projectile> projectiles;
+    ProjectilePool projectiles; // tiros do jogador e estilhaços dos inimigos
+    ParticleSystem particles;   // efeitos visuais (explosões, poeira); não fazem parte da simulação
+    float treadDustDistance;    // distância percorrida desde a última poeira das esteiras
+    DecalLayer* decals;         // marcas no chão (queimaduras, rastro); nullptr = sem marcas
+    AudioMixer* audio;          // efeitos sonoros; nullptr = sem som
     float cooldown;
     float cooldownTimer;
     float pushBackTimer;
     float rotationCollisionCooldownTimer;
-
-    std::vector<Explosion> activeExplosions;
+    float trackDamageCooldownTimer;
+    float enemyDamagePushbackCooldownTimer;
+
+    ExplosionPool explosions;
+    // fase de leitura de updateProjectiles, pelo índice do projétil no início do quadro
+    std::vector<int> projectileHits;               // inimigo atingido (tiros) ou 1 se atingiu o tanque (estilhaços); -1 = nenhum
+    std::vector<float> projectileHitTimes;         // tempo de impacto do acerto (fração do passo)
+    std::vector<float> projectileExitTimes;        // fração do passo em que saiu da pista (2 = não saiu)
+    std::vector<int> projectileOrigin;             // índice no início do quadro do projétil em cada posição do pool
     NitroBoost nitro; 
     RapidFire rapidFire; 
     SuperBurst superBurst; 
@@ -74,6 +99,11 @@ public:
         health = 100.0f; 
         pushBackTimer = 0.0f; 
         rotationCollisionCooldownTimer = 0.0f;
+        trackDamageCooldownTimer = 0.0f;
+        enemyDamagePushbackCooldownTimer = 0.0f;
+        treadDustDistance = 0.0f;
+        decals = nullptr;
+        audio = nullptr;
     }
 
     // Aplica dano ao tanque, reduzindo sua vida.
@@ -99,8 +129,8 @@ public:
     // Permite ativar o nitro se o jogador desejar.
     void updateNitro(float fps, bool wantsToActivate) {
         nitro.update(fps);
-        if (wantsToActivate) {
-            nitro.activate();
+        if (wantsToActivate && nitro.activate()) {
+            playSound(SOUND_POWER_UP, pivot);
         }
     }
 
@@ -108,8 +138,8 @@ public:
     // Permite ativar o tiro rápido se o jogador desejar.
     void updateRapidFire(float fps, bool wantsToActivate) { 
         rapidFire.update(fps);
-        if (wantsToActivate) {
-            rapidFire.activate();
+        if (wantsToActivate && rapidFire.activate()) {
+            playSound(SOUND_POWER_UP, pivot);
         }
     }
 
@@ -117,8 +147,8 @@ public:
     // Permite ativar a super rajada se o jogador desejar.
     void updateSuperBurst(float fps, bool wantsToActivate) { 
         superBurst.update(fps);
-        if (wantsToActivate) {
-            superBurst.activate();
+        if (wantsToActivate && superBurst.activate()) {
+            playSound(SOUND_POWER_UP, pivot);
         }
     }
 
@@ -126,17 +156,78 @@ public:
     // Permite ativar o escudo se o jogador desejar.
     void updateShield(float fps, bool wantsToActivate) { 
         shield.update(fps);
-        if (wantsToActivate) {
-            shield.activate();
+        if (wantsToActivate && shield.activate()) {
+            playSound(SOUND_POWER_UP, pivot);
         }
     }
 
+    // Verifica se os vértices dados colidem com algum inimigo terrestre (aviões são ignorados).
+    // Apenas os inimigos próximos, obtidos pela SpatialHash, passam pelo teste SAT.
+    bool collidesWithEnemies(const ConvexPolygon& testVertices, const EnemyStore& enemies, const SpatialHash& enemyHash) const
+    {
+        bool collides = false;
+        enemyHash.query(testVertices, 0.0f, [&](int handle) {
+            const Enemy& enemy = enemies[handle];
+            if (enemy.level == 4) return true;
+            if (CollisionUtils::checkPolygonPolygonCollision(testVertices, enemy.vertices)) {
+                collides = true;
+                return false;
+            }
+            return true;
+        });
+        return collides;
+    }
+
+    // Retorna a menor distância com sinal (campo de distância da pista) entre os vértices
+    // do tanque deslocados por delta, e a normal da borda no vértice mais profundo.
+    float deepestVertexDistance(const Track& track, const Vector2& delta, Vector2& normal) const
+    {
+        float deepest = TRACK_SDF_MAX_DISTANCE;
+        for (const auto& v : vertices) {
+            Vector2 n;
+            float d = track.signedDistance(v + delta, n);
+            if (d < deepest) {
+                deepest = d;
+                normal = n;
+            }
+        }
+        return deepest;
+    }
+
+    // Ajusta o deslocamento delta contra a borda da pista: a componente que entra na
+    // borda é removida (o tanque desliza ao longo dela) e a penetração que sobrar é
+    // desfeita ao longo da normal, limitada a maxPush por quadro.
+    // Retorna true se houve contato com a borda.
+    bool slideAgainstTrack(const Track& track, Vector2& delta, float maxPush) const
+    {
+        Vector2 normal;
+        float deepest = deepestVertexDistance(track, delta, normal);
+        if (deepest >= 0.0f) return false;
+
+        float into = delta.dot(normal);
+        if (into < 0.0f) {
+            delta = delta - normal * into;
+        }
+        deepest = deepestVertexDistance(track, delta, normal);
+        if (deepest < 0.0f) {
+            delta = delta + normal * std::min(-deepest, maxPush);
+        }
+        return true;
+    }
+
     // Move o tanque com base na direção atual e velocidade.
-    // Lida com colisões com a pista e inimigos, aplicando recuo e dano se necessário.
-    void move(float fps, const Track& track, const std::vector<Enemy> &enemies)
+    // Contra a borda da pista o tanque desliza (campo de distância) e sofre dano com intervalo mínimo;
+    // contra inimigos aplica recuo e dano.
+    void move(float fps, const Track& track, const EnemyStore& enemies, const SpatialHash& enemyHash)
     {
         currentSpeed = (baseSpeed * nitro.getSpeedMultiplier()) * (1.0f / fps) ; 
 
+        if (trackDamageCooldownTimer > 0.0f)
+        {
+            trackDamageCooldownTimer -= 1.0f / fps;
+            if (trackDamageCooldownTimer < 0.0f) trackDamageCooldownTimer = 0.0f;
+        }
+
         float proposedDeltaX = 0.0f;
         float proposedDeltaY = 0.0f;
         float actualDeltaX = 0.0f;
@@ -156,14 +247,10 @@ public:
 
             if (pushBackDeltaX != 0.0f || pushBackDeltaY != 0.0f)
             {
-                std::vector<Vector2> proposedRecuoVertices;
-                for (const auto& currentVertex : vertices)
-                {
-                    proposedRecuoVertices.push_back(Vector2(currentVertex.x + pushBackDeltaX, currentVertex.y + pushBackDeltaY));
-                }
+                ConvexPolygon proposedRecuoVertices = vertices.translated(pushBackDeltaX, pushBackDeltaY);
                 for (const auto& proposedVertex : proposedRecuoVertices)
                 {
-                    if (!track.isPointInsideTrack(proposedVertex))
+                    if (track.signedDistance(proposedVertex) < 0.0f)
                     {
                         recuoCollidesWithTrack = true;
                         break;
@@ -171,15 +258,7 @@ public:
                 }
                 if (!recuoCollidesWithTrack)
                 {
-                    for (const auto& enemy : enemies)
-                    {
-                        if (enemy.level == 4) continue; 
-                        if (CollisionUtils::checkPolygonPolygonCollision(proposedRecuoVertices, enemy.vertices))
-                        {
-                            recuoCollidesWithEnemy = true;
-                            break;
-                        }
-                    }
+                    recuoCollidesWithEnemy = collidesWithEnemies(proposedRecuoVertices, enemies, enemyHash);
                 }
             }
             if (!recuoCollidesWithTrack && !recuoCollidesWithEnemy)
@@ -198,55 +277,36 @@ public:
             bool collisionWithTrack = false;
             if (actualDeltaX != 0.0f || actualDeltaY != 0.0f)
             {
-                std::vector<Vector2> nextTankVertices;
-                for (const auto& v : vertices) {
-                    nextTankVertices.push_back(Vector2(v.x + actualDeltaX, v.y + actualDeltaY));
-                }
-                for (const auto& nextVertex : nextTankVertices) {
-                    if (!track.isPointInsideTrack(nextVertex)) {
-                        collisionWithTrack = true;
-                        break;
-                    }
-                }
+                Vector2 delta(actualDeltaX, actualDeltaY);
+                collisionWithTrack = slideAgainstTrack(track, delta, currentSpeed);
+                actualDeltaX = delta.x;
+                actualDeltaY = delta.y;
             }
 
-            if (collisionWithTrack)
+            if (collisionWithTrack && trackDamageCooldownTimer <= 0.0f)
             {
-                actualDeltaX = 0; 
-                actualDeltaY = 0;
                 takeDamage(10.0f); 
-                pushBackTimer = 2.0f; 
+                trackDamageCooldownTimer = 1.0f; 
             }
-            else 
+
+            if (enemyDamagePushbackCooldownTimer > 0.0f)
             {
-                static float enemyDamagePushbackCooldownTimer = 0.0f; 
-                if (enemyDamagePushbackCooldownTimer > 0.0f)
-                {
-                    enemyDamagePushbackCooldownTimer -= 1.0f / fps;
-                    if(enemyDamagePushbackCooldownTimer < 0.0f) enemyDamagePushbackCooldownTimer = 0.0f;
-                }
+                enemyDamagePushbackCooldownTimer -= 1.0f / fps;
+                if(enemyDamagePushbackCooldownTimer < 0.0f) enemyDamagePushbackCooldownTimer = 0.0f;
+            }
 
-                if (actualDeltaX != 0.0f || actualDeltaY != 0.0f) 
+            if (actualDeltaX != 0.0f || actualDeltaY != 0.0f) 
+            {
+                ConvexPolygon nextTankVertices = vertices.translated(actualDeltaX, actualDeltaY);
+                if (collidesWithEnemies(nextTankVertices, enemies, enemyHash))
                 {
-                    std::vector<Vector2> nextTankVertices; 
-                    for(const auto& v : vertices) {
-                        nextTankVertices.push_back(Vector2(v.x + actualDeltaX, v.y + actualDeltaY));
-                    }
-                    for (const auto &enemy : enemies)
+                    actualDeltaX = 0; 
+                    actualDeltaY = 0;
+                    if (enemyDamagePushbackCooldownTimer <= 0.0f) 
                     {
-                        if (enemy.level == 4) continue; 
-                        if (CollisionUtils::checkPolygonPolygonCollision(nextTankVertices, enemy.vertices))
-                        {
-                            actualDeltaX = 0; 
-                            actualDeltaY = 0;
-                            if (enemyDamagePushbackCooldownTimer <= 0.0f) 
-                            {
-                                takeDamage(5.0f); 
-                                enemyDamagePushbackCooldownTimer = 1.0f; 
-                                pushBackTimer = 2.0f; 
-                            }
-                            break; 
-                        }
+                        takeDamage(5.0f); 
+                        enemyDamagePushbackCooldownTimer = 1.0f; 
+                        pushBackTimer = 2.0f; 
                     }
                 }
             }
@@ -256,17 +316,31 @@ public:
         {
             pivot.x += actualDeltaX;
             pivot.y += actualDeltaY;
-            for (auto &vertex : vertices)
-            {
-                vertex.x += actualDeltaX;
-                vertex.y += actualDeltaY;
+            vertices.translate(actualDeltaX, actualDeltaY);
+            emitTreadDust(sqrt(actualDeltaX * actualDeltaX + actualDeltaY * actualDeltaY));
+        }
+    }
+
+    // Solta poeira e deixa o rastro nas duas esteiras (cantos traseiros) a cada
+    // TANK_TREAD_DUST_SPACING pixels percorridos.
+    void emitTreadDust(float distance)
+    {
+        treadDustDistance += distance;
+        Vector2 backward(-direction.x, -direction.y);
+        while (treadDustDistance >= TANK_TREAD_DUST_SPACING) {
+            treadDustDistance -= TANK_TREAD_DUST_SPACING;
+            particles.emitTreadDust(vertices[2], backward);
+            particles.emitTreadDust(vertices[3], backward);
+            if (decals) {
+                decals->stampTread(vertices[2]);
+                decals->stampTread(vertices[3]);
             }
         }
     }
 
     // Rotaciona o tanque com base em um ângulo delta.
     // Lida com colisões com a pista e inimigos durante a rotação.
-    void rotateDirection(float angleDelta, float fps, const Track& track, const std::vector<Enemy>& enemies)
+    void rotateDirection(float angleDelta, float fps, const Track& track, const EnemyStore& enemies, const SpatialHash& enemyHash)
     {
         if (rotationCollisionCooldownTimer > 0.0f)
         {
@@ -280,7 +354,7 @@ public:
 
         float rotationAmount = angleDelta / fps * 12.0f;
 
-        std::vector<Vector2> proposedVertices;
+        ConvexPolygon proposedVertices;
         float cosA = cos(rotationAmount);
         float sinA = sin(rotationAmount);
 
@@ -297,7 +371,7 @@ public:
         bool collisionWithTrack = false;
         for (const auto& proposedVertex : proposedVertices)
         {
-            if (!track.isPointInsideTrack(proposedVertex))
+            if (track.signedDistance(proposedVertex) < 0.0f)
             {
                 collisionWithTrack = true;
                 break;
@@ -307,15 +381,7 @@ public:
         bool collisionWithEnemies = false;
         if (!collisionWithTrack)
         {
-            for (const auto& enemy : enemies)
-            {
-                if (enemy.level == 4) continue; 
-                if (CollisionUtils::checkPolygonPolygonCollision(proposedVertices, enemy.vertices))
-                {
-                    collisionWithEnemies = true;
-                    break;
-                }
-            }
+            collisionWithEnemies = collidesWithEnemies(proposedVertices, enemies, enemyHash);
         }
 
         if (!collisionWithTrack && !collisionWithEnemies)
@@ -339,6 +405,14 @@ public:
         }
     }
 
+    // Toca um som do jogo (se houver mixer), com a panorâmica pela posição em relação ao tanque.
+    void playSound(int sound, const Vector2& position, float volume = 1.0f)
+    {
+        if (!audio) return;
+        float pan = std::max(-1.0f, std::min(1.0f, (position.x - pivot.x) / TANK_SOUND_PAN_DISTANCE));
+        audio->play(sound, volume, pan);
+    }
+
     // Dispara um projétil na direção do mouse.
     // Considera o estado das habilidades Tiro Rápido e Super Rajada para modificar o disparo.
     void shoot(float fps, float mouseX, float mouseY)
@@ -360,9 +434,10 @@ public:
             float barrelLength = bodyH * 0.6f; 
             Vector2 startPos(pivot.x + turretDirection.x * barrelLength, pivot.y + turretDirection.y * barrelLength);
             float projectileSpeed = 600.0f;
-            projectiles.emplace_back(startPos, turretDirection, projectileSpeed, projectileW, projectileH, Projectile::Owner::PLAYER, playerProjectileDamage * 1.5f); 
+            projectiles.spawn(startPos, turretDirection, projectileSpeed, projectileW, projectileH, ProjectileOwner::PLAYER, playerProjectileDamage * 1.5f); 
             
             superBurst.recordBurstShot(fps);
+            playSound(SOUND_SHOT, startPos);
         }
         else if (tryRapidFire)
         {
@@ -373,9 +448,10 @@ public:
             float barrelLength = bodyH * 0.6f; 
             Vector2 startPos(pivot.x + turretDirection.x * barrelLength, pivot.y + turretDirection.y * barrelLength);
             float projectileSpeed = 600.0f;
-            projectiles.emplace_back(startPos, turretDirection, projectileSpeed, projectileW, projectileH, Projectile::Owner::PLAYER, playerProjectileDamage);
+            projectiles.spawn(startPos, turretDirection, projectileSpeed, projectileW, projectileH, ProjectileOwner::PLAYER, playerProjectileDamage);
             
             rapidFire.recordBurstShot(fps); 
+            playSound(SOUND_SHOT, startPos, 0.7f);
         }
         else if (!rapidFire.isEffectActive() && !superBurst.isEffectActive() && canShootRegular) 
         {
@@ -386,69 +462,134 @@ public:
             float barrelLength = bodyH * 0.6f; 
             Vector2 startPos(pivot.x + turretDirection.x * barrelLength, pivot.y + turretDirection.y * barrelLength);
             float projectileSpeed = 600.0f;
-            projectiles.emplace_back(startPos, turretDirection, projectileSpeed, projectileW, projectileH, Projectile::Owner::PLAYER, playerProjectileDamage);
+            projectiles.spawn(startPos, turretDirection, projectileSpeed, projectileW, projectileH, ProjectileOwner::PLAYER, playerProjectileDamage);
 
             cooldownTimer = cooldown * fps; 
+            playSound(SOUND_SHOT, startPos);
         }
     }
 
+    // Inimigo atingido por um tiro do jogador que foi de from até to neste passo (-1 = nenhum),
+    // pelo teste contínuo contra o círculo de raio size de cada inimigo. Vale o primeiro
+    // atingido ao longo do passo (t, o tempo de impacto); em empate, o de menor índice.
+    static int findEnemyHit(const Vector2& from, const Vector2& to, const EnemyStore& enemies,
+                            const SpatialHash& enemyHash, float& hitTime)
+    {
+        int hitHandle = -1;
+        hitTime = 2.0f;
+        enemyHash.query(std::min(from.x, to.x), std::min(from.y, to.y), std::max(from.x, to.x), std::max(from.y, to.y),
+                        [&](int handle) {
+            const Enemy& enemy = enemies[handle];
+            if (enemy.isDestroyed()) return true;
+
+            float t;
+            if (CollisionUtils::sweepPointCircle(from, to, enemy.position, enemy.size, t) &&
+                (t < hitTime || (t == hitTime && handle < hitHandle)))
+            {
+                hitHandle = handle;
+                hitTime = t;
+            }
+            return true;
+        });
+        return hitHandle;
+    }
+
     // Atualiza a posição dos projéteis e verifica colisões.
     // Projéteis do jogador colidem com inimigos, e estilhaços de inimigos colidem com o jogador.
     // Projéteis são removidos se colidirem ou saírem da pista.
-    void updateProjectiles(float fps, const Track& track, std::vector<Enemy> &enemies)
+    // Cada projétil do jogador só é testado contra os inimigos próximos (SpatialHash).
+    // As colisões são contínuas: cada projétil é testado ao longo de todo o passo (de onde
+    // estava até onde chegou) e vale o primeiro contato (inimigo, tanque ou borda), então
+    // projéteis rápidos ou passos longos não atravessam inimigos pequenos nem bordas finas.
+    // O movimento e os testes de colisão rodam em paralelo (JobSystem), sem alterar nada;
+    // dano, explosões e remoções são aplicados depois, em série e na mesma ordem de antes.
+    // Um inimigo só deixa de ser atingível ao ser destruído, então o alvo calculado em
+    // paralelo só é procurado de novo se ele foi destruído por um projétil anterior.
+    void updateProjectiles(float fps, const Track& track, EnemyStore& enemies, const SpatialHash& enemyHash)
     {
-        for (auto &proj : projectiles)
-        {
-            proj.move(fps); 
-        }
+        JobSystem& jobs = JobSystem::shared();
+        float dt = 1.0f / fps;
+        int count = projectiles.size();
+        projectileHits.resize(count);
+        projectileHitTimes.resize(count);
+        projectileExitTimes.resize(count);
+        projectileOrigin.resize(count);
+        vertices.prepareAxes();
+
+        jobs.parallelFor(count, PROJECTILES_MIN_PER_JOB, [&](int begin, int end) {
+            projectiles.move(dt, begin, end);
+            for (int i = begin; i < end; ++i)
+            {
+                const Vector2 to = projectiles.getPosition(i);
+                const Vector2 from = to - projectiles.getVelocity(i) * dt;
+                int hit = -1;
+                float hitTime = 2.0f;
+                if (projectiles.getOwner(i) == ProjectileOwner::PLAYER) 
+                {
+                    hit = findEnemyHit(from, to, enemies, enemyHash, hitTime);
+                }
+                else if (projectiles.getOwner(i) == ProjectileOwner::ENEMY_SHRAPNEL) 
+                {
+                    float shrapnelRadius = (projectiles.getWidth(i) + projectiles.getHeight(i)) / 4.0f; 
+                    if (shrapnelRadius < 1.0f) shrapnelRadius = 1.0f; 
+                    if (CollisionUtils::sweepCirclePolygon(this->vertices, from, to, shrapnelRadius, hitTime)) hit = 1;
+                }
+                float exitTime;
+                projectileHits[i] = hit;
+                projectileHitTimes[i] = hitTime;
+                projectileExitTimes[i] = track.sweepBoundary(from, to, exitTime) ? exitTime : 2.0f;
+                projectileOrigin[i] = i;
+            }
+        });
 
-        for (auto it_proj = projectiles.begin(); it_proj != projectiles.end(); )
+        // Remoções trocam o projétil atual pelo último do pool, então i só avança
+        // quando o projétil atual permanece.
+        for (int i = 0; i < projectiles.size(); )
         {
             bool projectile_removed = false;
+            const Vector2 to = projectiles.getPosition(i);
+            const Vector2 from = to - projectiles.getVelocity(i) * dt;
+            int origin = projectileOrigin[i];
+            float exitTime = projectileExitTimes[origin];
 
-            if (it_proj->ownerType == Projectile::Owner::PLAYER) 
+            if (projectiles.getOwner(i) == ProjectileOwner::PLAYER) 
             {
-                for (auto &enemy : enemies)
+                int hitHandle = projectileHits[origin];
+                float hitTime = projectileHitTimes[origin];
+                if (hitHandle != -1 && enemies[hitHandle].isDestroyed())
                 {
-                    if (enemy.isDestroyed()) continue;
-
-                    float dx = it_proj->position.x - enemy.position.x;
-                    float dy = it_proj->position.y - enemy.position.y;
-                    float distanceSq = dx * dx + dy * dy;
-                    float enemyCollisionRadius = enemy.size; 
-
-                    if (distanceSq < (enemyCollisionRadius * enemyCollisionRadius))
-                    {
-                        enemy.takeDamage(static_cast<int>(it_proj->damage));
-                        addExplosion(it_proj->position, 1.0f); 
-                        it_proj = projectiles.erase(it_proj); 
-                        projectile_removed = true;
-                        break; 
-                    }
+                    hitHandle = findEnemyHit(from, to, enemies, enemyHash, hitTime);
+                }
+                if (hitHandle != -1 && hitTime <= exitTime)
+                {
+                    enemies[hitHandle].takeDamage(static_cast<int>(projectiles.getDamage(i)));
+                    addExplosion(from + (to - from) * hitTime, 1.0f); 
+                    removeProjectile(i);
+                    projectile_removed = true;
                 }
             }
-            else if (it_proj->ownerType == Projectile::Owner::ENEMY_SHRAPNEL) 
+            else if (projectiles.getOwner(i) == ProjectileOwner::ENEMY_SHRAPNEL) 
             {
-                float shrapnelRadius = (it_proj->width + it_proj->height) / 4.0f; 
-                if (shrapnelRadius < 1.0f) shrapnelRadius = 1.0f; 
-
-                if (CollisionUtils::checkPolygonCircleCollision(this->vertices, it_proj->position, shrapnelRadius))
+                float hitTime = projectileHitTimes[origin];
+                if (projectileHits[origin] != -1 && hitTime <= exitTime)
                 {
-                    this->takeDamage(it_proj->damage); 
-                    addExplosion(it_proj->position, 0.7f); 
-                    it_proj = projectiles.erase(it_proj);
+                    this->takeDamage(projectiles.getDamage(i)); 
+                    addExplosion(from + (to - from) * hitTime, 0.7f); 
+                    removeProjectile(i);
                     projectile_removed = true;
                 }
             }
 
             if (!projectile_removed) {
-                if (!track.isPointInsideTrack(it_proj->position)) {
-                    if(it_proj->ownerType == Projectile::Owner::PLAYER) { 
-                        this->addExplosion(it_proj->position, 0.6f); 
+                if (exitTime <= 1.0f) {
+                    if(projectiles.getOwner(i) == ProjectileOwner::PLAYER) { 
+                        this->addExplosion(from + (to - from) * exitTime, 0.6f); 
                     }
-                    it_proj = projectiles.erase(it_proj);
+                    removeProjectile(i);
+                } else if (projectiles.getLifetime(i) <= 0.0f) {
+                    removeProjectile(i);
                 } else {
-                    ++it_proj; 
+                    ++i; 
                 }
             }
         }
@@ -460,23 +601,29 @@ public:
         }
     }
 
-    // Adiciona uma nova explosão à lista de explosões ativas.
+    // Remove o projétil i do pool, acompanhando a troca com o último em projectileOrigin.
+    void removeProjectile(int i)
+    {
+        projectileOrigin[i] = projectileOrigin[projectiles.size() - 1];
+        projectiles.remove(i);
+    }
+
+    // Adiciona uma nova explosão ao pool de explosões ativas, com suas partículas, a
+    // queimadura que ela deixa no chão e o som (mais alto nas explosões maiores).
     void addExplosion(Vector2 position, float scale = 1.0f)
     {
-        activeExplosions.emplace_back(position, scale);
+        explosions.add(position, scale);
+        particles.emitExplosion(position, scale);
+        if (decals) decals->stampScorch(position, scale);
+        playSound(SOUND_EXPLOSION, position, std::min(1.0f, 0.4f + 0.25f * scale));
     }
 
-    // Atualiza o estado de todas as explosões ativas.
+    // Atualiza o estado de todas as explosões ativas e das partículas.
     // Remove explosões que não estão mais ativas.
     void updateExplosions(float fps)
     {
-        for (auto &exp : activeExplosions)
-        {
-            exp.update(fps);
-        }
-        activeExplosions.erase(std::remove_if(activeExplosions.begin(), activeExplosions.end(),
-                                              [](const Explosion& exp){ return !exp.active; }),
-                               activeExplosions.end());
+        particles.update(1.0f / fps);
+        explosions.update(fps);
     }
 
     // Verifica colisão entre o tanque e um inimigo específico.
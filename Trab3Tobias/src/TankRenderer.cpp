@@ -9,8 +9,9 @@
 #include "RapidFire.h"
 #include "SuperBurst.h"
 #include "Shield.h"
-#include "Projectile.h"
+#include "ProjectilePool.h"
 #include "Explosion.h"
+#include "Sprites.h"
 #include <cmath> 
 #include <cstdio> 
 
@@ -19,22 +20,22 @@ TankRenderer::TankRenderer(const Tank& tank) : tank_ref(tank)
 {
 }
 
-// Desenha todos os projéteis ativos associados ao tanque.
-void TankRenderer::drawProjectiles() const
+// Desenha os projéteis visíveis associados ao tanque (em lote, pelo pool).
+void TankRenderer::drawProjectiles(float minX, float minY, float maxX, float maxY) const
 {
-    for (const auto &proj : tank_ref.projectiles)
-    {
-        proj.draw();
-    }
+    tank_ref.projectiles.draw(minX, minY, maxX, maxY);
 }
 
-// Desenha todas as explosões ativas associadas ao tanque.
-void TankRenderer::drawExplosions() const
+// Desenha as explosões ativas visíveis associadas ao tanque (em lote, pelo pool).
+void TankRenderer::drawExplosions(float minX, float minY, float maxX, float maxY) const
 {
-    for (const auto &exp : tank_ref.activeExplosions)
-    {
-        exp.draw();
-    }
+    tank_ref.explosions.draw(minX, minY, maxX, maxY);
+}
+
+// Desenha as partículas visíveis associadas ao tanque (em lote, pelo sistema de partículas).
+void TankRenderer::drawParticles(float minX, float minY, float maxX, float maxY) const
+{
+    tank_ref.particles.draw(minX, minY, maxX, maxY);
 }
 
 // Desenha o corpo principal do tanque com detalhes de preenchimento e bordas.
@@ -90,23 +91,22 @@ void TankRenderer::desenhaDetalhado() const
     }
 }
 
-// Desenha a torre e o canhão do tanque, orientados pela posição do mouse.
-// A cor da torre pode mudar se o escudo estiver ativo.
-void TankRenderer::desenhaTorre(float mouseX, float mouseY) const
+// Desenha a torre e o canhão de um tanque com as dimensões dadas, em pivot e girados de angle.
+// shieldPulse (0 a 1) mistura as cores normais com as do escudo.
+void TankRenderer::drawTurretShape(const Vector2& pivot, float angle, float bodyW, float bodyH, float shieldPulse)
 {
-    float angle = atan2(mouseY - tank_ref.pivot.y, mouseX - tank_ref.pivot.x);
-    float towerW = tank_ref.bodyW * 0.5f;
-    float towerH = tank_ref.bodyH * 0.6f;
-    float barrelL = tank_ref.bodyW * 1.0f;
-    float barrelW = tank_ref.bodyH * 0.1f;
+    float towerW = bodyW * 0.5f;
+    float towerH = bodyH * 0.6f;
+    float barrelL = bodyW * 1.0f;
+    float barrelW = bodyH * 0.1f;
     float halfTW = towerW / 2.0f, halfTH = towerH / 2.0f;
     float halfBWid = barrelW / 2.0f;
 
     float r_base_turret = 0.1f, g_base_turret = 0.2f, b_base_turret = 0.1f;
     float r_turret_fill = r_base_turret, g_turret_fill = g_base_turret, b_turret_fill = b_base_turret;
 
-    if (tank_ref.shield.isEffectActive()) {
-        float pulse = tank_ref.shield.getEffectPulseFactor();
+    if (shieldPulse > 0.0f) {
+        float pulse = shieldPulse;
         float shieldTurretR_col = 0.05f, shieldTurretG_col = 0.2f, shieldTurretB_col = 0.6f;
         r_turret_fill = r_base_turret * (1.0f - pulse) + shieldTurretR_col * pulse;
         g_turret_fill = g_base_turret * (1.0f - pulse) + shieldTurretG_col * pulse;
@@ -118,10 +118,10 @@ void TankRenderer::desenhaTorre(float mouseX, float mouseY) const
     {
         float x1_local = -halfTW;
         float x2_local = halfTW;
-        float x1_world = tank_ref.pivot.x + cos(angle) * x1_local - sin(angle) * y_local;
-        float y1_world = tank_ref.pivot.y + sin(angle) * x1_local + cos(angle) * y_local;
-        float x2_world = tank_ref.pivot.x + cos(angle) * x2_local - sin(angle) * y_local;
-        float y2_world = tank_ref.pivot.y + sin(angle) * x2_local + cos(angle) * y_local;
+        float x1_world = pivot.x + cos(angle) * x1_local - sin(angle) * y_local;
+        float y1_world = pivot.y + sin(angle) * x1_local + cos(angle) * y_local;
+        float x2_world = pivot.x + cos(angle) * x2_local - sin(angle) * y_local;
+        float y2_world = pivot.y + sin(angle) * x2_local + cos(angle) * y_local;
         CV::line(x1_world, y1_world, x2_world, y2_world);
     }
 
@@ -133,17 +133,17 @@ void TankRenderer::desenhaTorre(float mouseX, float mouseY) const
         float y1_local_barrel = y_local_barrel;
         float x2_local_barrel = barrelBaseX_local + barrelL;
         float y2_local_barrel = y_local_barrel;
-        float x1_world_barrel = tank_ref.pivot.x + cos(angle) * x1_local_barrel - sin(angle) * y1_local_barrel;
-        float y1_world_barrel = tank_ref.pivot.y + sin(angle) * x1_local_barrel + cos(angle) * y1_local_barrel;
-        float x2_world_barrel = tank_ref.pivot.x + cos(angle) * x2_local_barrel - sin(angle) * y2_local_barrel;
-        float y2_world_barrel = tank_ref.pivot.y + sin(angle) * x2_local_barrel + cos(angle) * y2_local_barrel;
+        float x1_world_barrel = pivot.x + cos(angle) * x1_local_barrel - sin(angle) * y1_local_barrel;
+        float y1_world_barrel = pivot.y + sin(angle) * x1_local_barrel + cos(angle) * y1_local_barrel;
+        float x2_world_barrel = pivot.x + cos(angle) * x2_local_barrel - sin(angle) * y2_local_barrel;
+        float y2_world_barrel = pivot.y + sin(angle) * x2_local_barrel + cos(angle) * y2_local_barrel;
         CV::line(x1_world_barrel, y1_world_barrel, x2_world_barrel, y2_world_barrel);
     }
 
     float borderR_turret_base_col = r_base_turret * 0.7f, borderG_turret_base_col = g_base_turret * 0.7f, borderB_turret_base_col = b_base_turret * 0.7f;
     float borderR_turret_col = borderR_turret_base_col, borderG_turret_col = borderG_turret_base_col, borderB_turret_col = borderB_turret_base_col;
-     if (tank_ref.shield.isEffectActive()) {
-        float pulse = tank_ref.shield.getEffectPulseFactor();
+     if (shieldPulse > 0.0f) {
+        float pulse = shieldPulse;
         float shieldTurretBorderR_col = 0.1f, shieldTurretBorderB_col = 0.7f; 
         float shieldTurretBorderG_val = 0.3f; 
 
@@ -161,8 +161,8 @@ void TankRenderer::desenhaTorre(float mouseX, float mouseY) const
     Vector2 tower_v_world[4];
     for(int i=0; i<4; ++i) {
         tower_v_world[i] = Vector2(
-            tank_ref.pivot.x + cos(angle) * tower_v_local[i].x - sin(angle) * tower_v_local[i].y,
-            tank_ref.pivot.y + sin(angle) * tower_v_local[i].x + cos(angle) * tower_v_local[i].y
+            pivot.x + cos(angle) * tower_v_local[i].x - sin(angle) * tower_v_local[i].y,
+            pivot.y + sin(angle) * tower_v_local[i].x + cos(angle) * tower_v_local[i].y
         );
     }
     for(int i=0; i<4; ++i) {
@@ -177,8 +177,8 @@ void TankRenderer::desenhaTorre(float mouseX, float mouseY) const
     Vector2 barrel_v_world[4];
      for(int i=0; i<4; ++i) {
         barrel_v_world[i] = Vector2(
-            tank_ref.pivot.x + cos(angle) * barrel_v_local[i].x - sin(angle) * barrel_v_local[i].y,
-            tank_ref.pivot.y + sin(angle) * barrel_v_local[i].x + cos(angle) * barrel_v_local[i].y
+            pivot.x + cos(angle) * barrel_v_local[i].x - sin(angle) * barrel_v_local[i].y,
+            pivot.y + sin(angle) * barrel_v_local[i].x + cos(angle) * barrel_v_local[i].y
         );
     }
     for(int i=0; i<4; ++i) {
@@ -186,6 +186,24 @@ void TankRenderer::desenhaTorre(float mouseX, float mouseY) const
     }
 }
 
+// Desenha a torre e o canhão do tanque, orientados pela posição do mouse.
+// A cor da torre pode mudar se o escudo estiver ativo. Com o atlas pronto, a torre é um
+// sprite; com o escudo, o sprite nas cores do escudo é desenhado por cima com a opacidade
+// do pulso (a mesma mistura de cores do desenho procedural).
+void TankRenderer::desenhaTorre(float mouseX, float mouseY) const
+{
+    float angle = atan2(mouseY - tank_ref.pivot.y, mouseX - tank_ref.pivot.x);
+    float pulse = tank_ref.shield.isEffectActive() ? tank_ref.shield.getEffectPulseFactor() : 0.0f;
+    const SpriteAtlas& atlas = SpriteAtlas::shared();
+    if (!atlas.isReady()) {
+        drawTurretShape(tank_ref.pivot, angle, tank_ref.bodyW, tank_ref.bodyH, pulse);
+        return;
+    }
+    float scaleX = tank_ref.bodyW / TANK_DEFAULT_WIDTH, scaleY = tank_ref.bodyH / TANK_DEFAULT_HEIGHT;
+    atlas.draw(SPRITE_TURRET, tank_ref.pivot, angle, scaleX, scaleY, 1.0f);
+    if (pulse > 0.0f) atlas.draw(SPRITE_TURRET_SHIELD, tank_ref.pivot, angle, scaleX, scaleY, pulse);
+}
+
 // Desenha a barra de vida acima do tanque, mostrando a porcentagem de vida restante.
 void TankRenderer::drawHealthBar() const
 {
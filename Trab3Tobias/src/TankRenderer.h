@@ -20,14 +20,19 @@ public:
     // Construtor que armazena uma referência ao tanque a ser renderizado.
     TankRenderer(const Tank& tank);
 
-    // Desenha os projéteis disparados pelo tanque.
-    void drawProjectiles() const;
-    // Desenha as explosões ativas.
-    void drawExplosions() const;
+    // Desenha os projéteis que cruzam a área visível dada (coordenadas do mundo).
+    void drawProjectiles(float minX, float minY, float maxX, float maxY) const;
+    // Desenha as explosões ativas que cruzam a área visível dada.
+    void drawExplosions(float minX, float minY, float maxX, float maxY) const;
+    // Desenha as partículas (explosões e poeira das esteiras) que cruzam a área visível dada.
+    void drawParticles(float minX, float minY, float maxX, float maxY) const;
     // Desenha o corpo detalhado do tanque, incluindo preenchimento e bordas.
     void desenhaDetalhado() const;
     // Desenha a torre e o canhão do tanque, orientados em direção ao mouse.
     void desenhaTorre(float mouseX, float mouseY) const;
+    // Desenha a torre de um tanque com as dimensões dadas, em pivot e girada de angle
+    // (desenho procedural, usado para montar o sprite e quando o atlas não está pronto).
+    static void drawTurretShape(const Vector2& pivot, float angle, float bodyW, float bodyH, float shieldPulse);
     // Desenha a barra de vida do tanque.
     void drawHealthBar() const;
     // Desenha os efeitos visuais do nitro quando ativo.
@@ -2,7 +2,13 @@
 // do aplicativo. Ele gerencia os diferentes estados da aplicação (Menu, Jogo, Editor de Pista),
 // lida com as transições entre esses estados, e coordena a renderização e
 // atualização da lógica com base no estado atual. Também gerencia a pista global
-// e os botões específicos do editor de pista.
+// e os botões específicos do editor de pista. No editor, a largura mínima real da pista
+// e os cruzamentos das bordas são exibidos a cada quadro, enquanto os pontos são arrastados.
+// O mundo (pista e cenário) pode ter várias telas (escala do mundo): no jogo a câmera segue
+// o tanque; no menu e no editor a câmera começa no centro do mundo e, no editor, rola
+// quando o mouse encosta nas bordas da tela.
+// Os efeitos sonoros são mixados por um AudioMixer da Tela, compartilhado pelas partidas;
+// sem dispositivo de áudio, a saída é um arquivo WAV (setAudioOutput).
 #ifndef ___TELA__H___
 #define ___TELA__H___
 
@@ -10,10 +16,19 @@
 #include "Menu.h"
 #include "Game.h"
 #include "Background.h" 
+#include "FrameArena.h"
+#include "Sprites.h"
+#include "Sounds.h"
+#include "AudioSink.h"
 #include <ctime>   
 #include <cstdlib> 
 #include <vector> 
 #include <string> 
+#include <cstdio>
+
+#define TRACK_EDITOR_MIN_WIDTH 80.0f // largura mínima da pista para o tanque caber
+#define TRACK_EDITOR_SCROLL_MARGIN 20  // distância da borda da tela em que o editor rola
+#define TRACK_EDITOR_SCROLL_STEP 8.0f  // pixels por quadro da rolagem do editor
 
 class Tela {
 public:
@@ -86,6 +101,9 @@ private:
     Background background; 
 
     int screenWidth, screenHeight;
+    int worldScale;               // lado do mundo, em telas
+    int worldWidth, worldHeight;
+    Camera view;                  // câmera do menu e do editor
     float currentFps;
 
     
@@ -94,26 +112,44 @@ private:
     int prevMousePressed;
     int currentKey;
 
+    std::string recordingPath; // se não vazio, cada partida é gravada neste arquivo
+    AudioMixer audio;          // efeitos sonoros das partidas (só roda com uma saída)
+    AudioSink* audioOutput;    // saída do mixer (nullptr = sem som)
+
 public:
-    // Construtor da classe Tela.
-    Tela(int sw, int sh)
+    // Pista circular padrão, centrada no mundo: a borda externa encosta em cima e embaixo do
+    // mundo e a largura é a da pista de uma tela (com escala 1, é a pista original). Pistas
+    // maiores têm mais pontos de controle, para manter a forma circular.
+    static Track makeDefaultTrack(int worldWidth, int worldHeight, int screenHeight, int worldScale) {
+        float trackWidth = screenHeight / 2.0f - screenHeight / 5.0f;
+        return Track(worldWidth, worldHeight, worldWidth / 2.0f, worldHeight / 2.0f,
+                     worldHeight / 2.0f - trackWidth, worldHeight / 2.0f, 10 * worldScale);
+    }
+
+    // Construtor da classe Tela. O mundo tem worldScale x worldScale telas.
+    Tela(int sw, int sh, int worldScale = 1)
         : 
           currentState(AppState::MENU),
           menuInstance(nullptr), 
           gameInstance(nullptr), 
-          globalTrack(sw, sh, sw / 2.0f, sh / 2.0f, sh / 5.0f, sh / 2.0f, 10), 
+          globalTrack(makeDefaultTrack(sw * worldScale, sh * worldScale, sh, worldScale)), 
           
           
           displayTrackEditorError(false), 
-          background(sw, sh),             
+          background(sw * worldScale, sh * worldScale, sw, sh),
           screenWidth(sw),                
           screenHeight(sh),               
+          worldScale(worldScale),
+          worldWidth(sw * worldScale),
+          worldHeight(sh * worldScale),
+          view((float)(sw * worldScale), (float)(sh * worldScale), (float)sw, (float)sh),
           currentFps(60.0f),              
           mouseX(0),                      
           mouseY(0),                      
           isMousePressed(0),              
           prevMousePressed(0),            
-          currentKey(-1)                  
+          currentKey(-1),
+          audioOutput(nullptr)
     {
         srand(time(0)); 
         CV::init(&this->screenWidth, &this->screenHeight, "GTA 2D - Refatorado");
@@ -139,29 +175,54 @@ public:
     ~Tela() {
         delete menuInstance;
         delete gameInstance;
+        audio.stop();
+        delete audioOutput;
     }
 
     // Renderiza o conteúdo da tela com base no estado atual da aplicação.
+    // Cada chamada é um quadro: os dados temporários do quadro anterior são descartados.
+    // No primeiro quadro, antes de limpar a tela, os sprites do jogo são montados no atlas.
     void render() {
+        FrameArena::shared().reset();
+        SpriteAtlas& atlas = SpriteAtlas::shared();
+        if (!atlas.isBaked()) {
+            registerGameSprites(atlas);
+            atlas.bake(screenWidth, screenHeight);
+        }
         CV::clear(0.0f, 0.0f, 0.0f); 
 
-        background.draw(screenWidth, screenHeight, globalTrack); 
+        if (currentState == AppState::GAME_PLAYING) {
+            // o jogo desenha o cenário com a própria câmera
+            if (gameInstance) {
+                gameInstance->render();
+            }
+            return;
+        }
+
+        view.begin();
+        background.draw(screenWidth, screenHeight, globalTrack, view); 
+        if (currentState == AppState::TRACK_EDITOR) {
+            globalTrack.renderTrack(view.getMinX(), view.getMinY(), view.getMaxX(), view.getMaxY()); 
+        }
+        Camera::end();
 
         if (currentState == AppState::MENU) {
             if (menuInstance) {
                 menuInstance->render();
             }
-        } else if (currentState == AppState::GAME_PLAYING) {
-            if (gameInstance) {
-                gameInstance->render();
-            }
         } else if (currentState == AppState::TRACK_EDITOR) {
-            globalTrack.renderTrack(); 
             CV::color(1,1,1);
             const char* editorMsg = "Para confirmar mudancas pressione \"Enter\"";
             
             CV::textStroke(30, screenHeight - 30, editorMsg, 0.1f, 1.5f);
 
+            char validationMsg[96];
+            snprintf(validationMsg, sizeof(validationMsg), "Largura minima: %.0f px   Cruzamentos das bordas: %d",
+                     globalTrack.getMinimumWidth(), globalTrack.getCrossingCount());
+            if (globalTrack.validateTrackWidth(TRACK_EDITOR_MIN_WIDTH)) CV::color(0.4f, 1.0f, 0.4f);
+            else CV::color(1.0f, 0.3f, 0.3f);
+            CV::textStroke(30, 30, validationMsg, 0.1f, 1.5f);
+
             
             for (const auto& btn : editorButtons) {
                 btn.draw();
@@ -206,11 +267,13 @@ public:
             
             if (currentKey == 13) { 
                 
-                float tankWidthForValidation = 80.0f; 
-                if (globalTrack.validateTrackWidth(tankWidthForValidation)) {
+                if (globalTrack.validateTrackWidth(TRACK_EDITOR_MIN_WIDTH)) {
                     globalTrack.setControlPointsVisibility(false); 
                     currentState = AppState::MENU;
                     displayTrackEditorError = false; 
+                } else if (globalTrack.getCrossingCount() > 0) {
+                    trackEditorErrorMessage = "As bordas da pista se cruzam";
+                    displayTrackEditorError = true;
                 } else {
                     trackEditorErrorMessage = "A largura da pista nao se adequa as dimensoes do tanque";
                     displayTrackEditorError = true;
@@ -231,10 +294,12 @@ public:
             
             
             if (!buttonClickedThisFrame) {
+                scrollEditorView();
+                Vector2 worldMouse = view.screenToWorld((float)mouseX, (float)mouseY);
                 if (isMousePressed == 1 && prevMousePressed == 0) {
-                    globalTrack.handleMousePress(mouseX, mouseY);
+                    globalTrack.handleMousePress((int)worldMouse.x, (int)worldMouse.y);
                 } else if (isMousePressed == 1 && prevMousePressed == 1) { 
-                    globalTrack.handleMouseDrag(mouseX, mouseY);
+                    globalTrack.handleMouseDrag((int)worldMouse.x, (int)worldMouse.y);
                 } else if (isMousePressed == 0 && prevMousePressed == 1) { 
                     globalTrack.handleMouseRelease();
                 }
@@ -243,9 +308,21 @@ public:
         prevMousePressed = isMousePressed;
     }
 
+    // Rola a câmera do editor quando o mouse está perto de uma borda da tela (só tem efeito
+    // se o mundo for maior que a tela). A rolagem é em pixels inteiros, para que os pontos
+    // arrastados continuem em coordenadas inteiras.
+    void scrollEditorView() {
+        float dx = 0.0f, dy = 0.0f;
+        if (mouseX < TRACK_EDITOR_SCROLL_MARGIN) dx = -TRACK_EDITOR_SCROLL_STEP;
+        else if (mouseX > screenWidth - TRACK_EDITOR_SCROLL_MARGIN) dx = TRACK_EDITOR_SCROLL_STEP;
+        if (mouseY < TRACK_EDITOR_SCROLL_MARGIN) dy = -TRACK_EDITOR_SCROLL_STEP;
+        else if (mouseY > screenHeight - TRACK_EDITOR_SCROLL_MARGIN) dy = TRACK_EDITOR_SCROLL_STEP;
+        if (dx != 0.0f || dy != 0.0f) view.scroll(dx, dy);
+    }
+
     // Executa a ação associada a um botão do editor de pista.
     void performEditorButtonAction(EditorButton::Action action) {
-        Vector2 defaultPos(screenWidth / 2.0f, screenHeight / 2.0f);
+        Vector2 defaultPos = view.screenToWorld(screenWidth / 2.0f, screenHeight / 2.0f);
         Vector2 newPointPos = defaultPos; 
         displayTrackEditorError = false; 
 
@@ -266,17 +343,46 @@ public:
                 globalTrack.deleteSelectedControlPoint();
                 break;
             case EditorButton::Action::RESET_TRACK: 
-                globalTrack = Track(screenWidth, screenHeight, screenWidth / 2.0f, screenHeight / 2.0f, screenHeight / 5.0f, screenHeight / 2.0f, 10);
+                globalTrack = makeDefaultTrack(worldWidth, worldHeight, screenHeight, worldScale);
                 globalTrack.setControlPointsVisibility(true); 
                 break;
         }
     }
 
+public:
+    // Define o arquivo em que as partidas serão gravadas (a última partida sobrescreve as anteriores).
+    void setRecordingPath(const char* path) {
+        recordingPath = path;
+    }
+
+    // Grava os efeitos sonoros de todas as partidas no arquivo WAV dado. Retorna false se o
+    // arquivo não pôde ser criado ou o mixer não pôde ser iniciado.
+    bool setAudioOutput(const char* path) {
+        if (audioOutput) return false;
+        WavFileSink* sink = new WavFileSink(path, AUDIO_SAMPLE_RATE);
+        if (!sink->isOpen()) {
+            delete sink;
+            return false;
+        }
+        registerGameSounds(audio);
+        if (!audio.start(sink)) {
+            delete sink;
+            return false;
+        }
+        audioOutput = sink;
+        return true;
+    }
+
 private:
     // Inicia o estado de jogo.
     void startGame() {
         delete gameInstance; 
-        gameInstance = new Game(screenWidth, screenHeight, globalTrack); 
+        gameInstance = new Game(screenWidth, screenHeight, globalTrack, (uint32_t)time(0)); 
+        gameInstance->setBackground(&background);
+        if (audio.isRunning()) gameInstance->setAudio(&audio);
+        if (!recordingPath.empty()) {
+            gameInstance->startRecording(recordingPath.c_str());
+        }
         currentState = AppState::GAME_PLAYING;
     }
 
@@ -3,28 +3,65 @@
 // utilizando curvas B-Spline para definir os limites interno e externo.
 // Funcionalidades incluem:
 // - Geração de pontos de controle iniciais para formar uma pista circular.
-// - Geração de pontos das curvas B-Spline a partir dos pontos de controle.
+// - Geração de pontos das curvas B-Spline a partir dos pontos de controle, por diferenças
+//   progressivas. Cada segmento recebe só os pontos necessários para que a poligonal fique
+//   a menos de TRACK_TESSELLATION_TOLERANCE pixels da curva (trechos retos têm poucos pontos,
+//   curvas fechadas têm mais). Ao arrastar um ponto de controle só os quatro segmentos que
+//   ele influencia são reavaliados; as arestas e a paridade da grade, o campo de distância
+//   e, se a quantidade de pontos não mudou, a curva central e as caixas dos trechos do
+//   desenho são atualizados apenas nesse trecho. Continuam sendo refeitos por inteiro a
+//   cada arraste: a soma acumulada do comprimento de arco depois do trecho, os baldes da
+//   grade (formato compacto, O(arestas + células)), a SpatialHash dos trechos (O(trechos))
+//   e a validação das bordas (ver abaixo).
+// - Revisões por segmento, para que outros caches (ex: Background) saibam quais segmentos
+//   das curvas mudaram desde a última vez que os consultaram (getDirtySegments).
+// - Tabela de comprimento de arco da curva central, para amostrar a pista por distância
+//   percorrida em O(log n) (listras centrais, trajetória do avião).
 // - Renderização da pista, incluindo asfalto, linhas de contorno e listras centrais.
 // - Manipulação interativa dos pontos de controle (adicionar, deletar, mover) no modo editor.
-// - Verificação se um ponto está dentro da área da pista.
-// - Validação da largura da pista para garantir que objetos (como o tanque) caibam.
+// - Verificação se um ponto está dentro da área da pista (acelerada por uma grade uniforme).
+// - Campo de distância com sinal da pista (profundidade de penetração e normal da borda) e
+//   teste contínuo de um ponto em movimento contra a borda (sweepBoundary, por sphere tracing).
+// - Validação geométrica da pista: hierarquias de caixas (SegmentBVH) sobre as arestas das
+//   duas curvas dão a largura mínima real (menor distância entre as bordas, sem depender de
+//   os pontos estarem emparelhados) e os cruzamentos das bordas consigo mesmas e entre si.
+//   A validação é refeita por inteiro a cada alteração, inclusive durante o arraste no
+//   editor: a largura mínima e os cruzamentos são globais (o mínimo antigo pode ter saído
+//   do trecho alterado), então as hierarquias são reconstruídas e todas as arestas consultadas.
 // - Fornecimento de acesso aos pontos das curvas para outras partes do jogo (ex: Background).
 #ifndef ___TRACK__H___
 #define ___TRACK__H___
 
 #include <vector>
+#include <algorithm>
 #include "gl_canvas2d.h"
 #include <cmath> 
 #include "Vector2.h" 
+#include "TrackGrid.h"
+#include "TrackSDF.h"
+#include "SegmentBVH.h"
+#include "SpatialHash.h"
 
 #define M_PI 3.14159265358979323846
 #define CONTROL_POINT_RADIUS 5 
+#define TRACK_GRID_CELL_SIZE 8.0f
+#define TRACK_SDF_TEXEL_SIZE 2.0f
+#define TRACK_SDF_MAX_DISTANCE 64.0f
+#define TRACK_TESSELLATION_TOLERANCE 0.25f // erro máximo da poligonal das curvas, em pixels
+#define TRACK_MIN_SAMPLES_PER_SEGMENT 2
+#define TRACK_MAX_SAMPLES_PER_SEGMENT 64
+#define TRACK_STRIPE_LENGTH 45.0f // comprimento de cada listra central (e de cada intervalo)
+#define TRACK_MAX_REPORTED_CROSSINGS 32 // cruzamentos das bordas guardados para exibição
+#define TRACK_SWEEP_MIN_STEP 0.25f  // menor avanço do sphere tracing, em pixels
+#define TRACK_SWEEP_MAX_STEPS 64
+#define TRACK_RENDER_PIECE_EDGES 16    // arestas por trecho no recorte do desenho
+#define TRACK_RENDER_CELL_SIZE 128.0f  // células da SpatialHash dos trechos
 
 class Track
 {
     std::vector<Vector2> innerControlPoints;
     std::vector<Vector2> outerControlPoints;
-    int screenWidth, screenHeight;
+    int worldWidth, worldHeight; // dimensões do mundo em que a pista está (pode ser maior que a tela)
 
     bool showPoints; 
     int draggingPointIndex; 
@@ -35,54 +72,163 @@ class Track
     std::vector<Vector2> innerCurvePoints;
     std::vector<Vector2> outerCurvePoints;
     std::vector<Vector2> centerCurvePoints; 
-    float curveGenerationStep = 0.02f; 
+    std::vector<float> centerArcLength; // comprimento da curva central até cada ponto; o último é o total
+    TrackGrid grid; // grade de aceleração para isPointInsideTrack
+    TrackSDF sdf;   // campo de distância com sinal da área dirigível
+    struct PieceBox {
+        float minX, minY, maxX, maxY;
+    };
+    std::vector<PieceBox> pieceBoxes; // caixa de cada trecho da pista (ver buildRenderPieces)
+    SpatialHash pieceHash;          // caixas dos trechos da pista, para o recorte do desenho
+    std::vector<int> visiblePieces; // trechos a desenhar no quadro atual
 
-    // Gera os pontos de uma curva B-Spline e os armazena em outCurvePoints.
-    // Utiliza os pontos de controle fornecidos para calcular os pontos da curva.
-    void generateBSplineCurvePoints(const std::vector<Vector2>& controlPoints, std::vector<Vector2>& outCurvePoints)
+    // validação geométrica das bordas
+    SegmentBVH innerBVH, outerBVH;
+    float minimumWidth;                       // menor distância entre as curvas interna e externa
+    Vector2 minimumWidthInner, minimumWidthOuter; // pontos das bordas onde a largura é mínima
+    int crossingCount;                        // número de pares de arestas das bordas que se cruzam
+    std::vector<Vector2> crossings;           // até TRACK_MAX_REPORTED_CROSSINGS pontos de cruzamento
+
+    // O segmento i de uma curva (pontos de controle i..i+3) ocupa os pontos
+    // [segmentStart[i], segmentStart[i + 1]) da curva.
+    std::vector<int> innerSegmentStart;
+    std::vector<int> outerSegmentStart;
+    std::vector<Vector2> segmentScratch; // pontos reavaliados de um trecho, reaproveitado entre arrastes
+
+    unsigned revision;         // muda a cada alteração das curvas
+    unsigned topologyRevision; // última alteração que mudou o número de segmentos das curvas
+    std::vector<unsigned> innerSegmentRevision; // revisão da última alteração de cada segmento
+    std::vector<unsigned> outerSegmentRevision;
+
+    // Revisões são únicas entre todas as pistas, para que um consumidor que passe a
+    // observar outra pista (ex: pista do editor recriada) perceba a troca.
+    static unsigned nextRevision()
     {
-        outCurvePoints.clear();
-        if (controlPoints.size() < 4) return;
+        static unsigned counter = 0;
+        return ++counter;
+    }
 
-        bool firstPointOfCurve = true;
-        for (size_t i = 0; i < controlPoints.size() - 3; ++i)
-        {
-            for (float t = 0.0f; t <= 1.0f; t += curveGenerationStep)
-            {
-                
-                if (!firstPointOfCurve && t == 0.0f) {
-                    continue;
-                }
+    // Coeficientes de P(t) = a t^3 + b t^2 + c t + d do segmento B-Spline cúbico uniforme
+    // de pontos de controle p[0..3].
+    static void segmentCoefficients(const Vector2* p, Vector2& a, Vector2& b, Vector2& c, Vector2& d)
+    {
+        a = (p[3] - p[0] + (p[1] - p[2]) * 3.0f) * (1.0f / 6.0f);
+        b = (p[0] - p[1] * 2.0f + p[2]) * 0.5f;
+        c = (p[2] - p[0]) * 0.5f;
+        d = (p[0] + p[1] * 4.0f + p[2]) * (1.0f / 6.0f);
+    }
 
-                float t2 = t * t;
-                float t3 = t2 * t;
+    // Número de pontos do segmento para que a poligonal fique a no máximo
+    // TRACK_TESSELLATION_TOLERANCE pixels da curva: com passo h em t, a corda se afasta
+    // no máximo h^2 max|P''| / 8, e P''(t) = 6at + 2b é linear, com máximo em t = 0 ou 1.
+    static int segmentSampleCount(const Vector2* p)
+    {
+        Vector2 a, b, c, d;
+        segmentCoefficients(p, a, b, c, d);
+        float maxSecondDerivative = std::max((b * 2.0f).length(), (a * 6.0f + b * 2.0f).length());
+        int n = (int)std::ceil(std::sqrt(maxSecondDerivative / (8.0f * TRACK_TESSELLATION_TOLERANCE)));
+        return std::max(TRACK_MIN_SAMPLES_PER_SEGMENT, std::min(TRACK_MAX_SAMPLES_PER_SEGMENT, n));
+    }
 
-                float b0 = (-t3 + 3*t2 - 3*t + 1) / 6.0f;
-                float b1 = (3*t3 - 6*t2 + 0*t + 4) / 6.0f;
-                float b2 = (-3*t3 + 3*t2 + 3*t + 1) / 6.0f;
-                float b3 = (t3) / 6.0f;
+    // Avalia o segmento de pontos de controle p[0..3] em n valores de t igualmente espaçados
+    // em [0, 1), por diferenças progressivas: o polinômio é avaliado uma vez e os demais
+    // pontos saem de somas.
+    static void evaluateSegment(const Vector2* p, int n, Vector2* out)
+    {
+        Vector2 a, b, c, d;
+        segmentCoefficients(p, a, b, c, d);
+        float h = 1.0f / n;
+        float h2 = h * h, h3 = h2 * h;
+        Vector2 f = d;
+        Vector2 d1 = a * h3 + b * h2 + c * h;
+        Vector2 d2 = a * (6.0f * h3) + b * (2.0f * h2);
+        Vector2 d3 = a * (6.0f * h3);
+        for (int k = 0; k < n; ++k) {
+            out[k] = f;
+            f = f + d1;
+            d1 = d1 + d2;
+            d2 = d2 + d3;
+        }
+    }
 
-                float x = b0 * controlPoints[i].x + b1 * controlPoints[i+1].x + b2 * controlPoints[i+2].x + b3 * controlPoints[i+3].x;
-                float y = b0 * controlPoints[i].y + b1 * controlPoints[i+1].y + b2 * controlPoints[i+2].y + b3 * controlPoints[i+3].y;
-                
-                outCurvePoints.push_back(Vector2(x, y));
-                firstPointOfCurve = false;
-            }
+    // As curvas interna e externa têm o mesmo número de segmentos.
+    bool curvesArePaired() const
+    {
+        return innerControlPoints.size() == outerControlPoints.size() && innerControlPoints.size() >= 4;
+    }
+
+    // Número de pontos que o segmento da curva exige. Se as curvas têm o mesmo número de
+    // segmentos, os segmentos de mesmo índice usam a mesma quantidade (a maior das duas), para
+    // que pontos de mesmo índice correspondam ao mesmo parâmetro: o asfalto, a curva central
+    // e a validação da largura dependem disso.
+    int requiredSamples(bool inner, int segment) const
+    {
+        if (curvesArePaired()) {
+            return std::max(segmentSampleCount(&innerControlPoints[segment]), segmentSampleCount(&outerControlPoints[segment]));
         }
+        const std::vector<Vector2>& controlPoints = inner ? innerControlPoints : outerControlPoints;
+        return segmentSampleCount(&controlPoints[segment]);
     }
 
-    // Gera os pontos da curva central da pista, calculados como a média
-    // dos pontos correspondentes das curvas interna e externa.
+    // Gera os pontos de uma curva B-Spline fechada. Os vetores só são realocados se crescerem.
+    void generateBSplineCurvePoints(bool inner)
+    {
+        const std::vector<Vector2>& controlPoints = inner ? innerControlPoints : outerControlPoints;
+        std::vector<Vector2>& curvePoints = inner ? innerCurvePoints : outerCurvePoints;
+        std::vector<int>& segmentStart = inner ? innerSegmentStart : outerSegmentStart;
+        if (controlPoints.size() < 4) {
+            curvePoints.clear();
+            segmentStart.assign(1, 0);
+            return;
+        }
+        int segments = (int)controlPoints.size() - 3;
+        segmentStart.resize(segments + 1);
+        segmentStart[0] = 0;
+        for (int i = 0; i < segments; ++i) {
+            segmentStart[i + 1] = segmentStart[i] + requiredSamples(inner, i);
+        }
+        curvePoints.resize(segmentStart[segments]);
+        for (int i = 0; i < segments; ++i) {
+            evaluateSegment(&controlPoints[i], segmentStart[i + 1] - segmentStart[i], &curvePoints[segmentStart[i]]);
+        }
+    }
+
+    // Gera os pontos da curva central da pista (a média dos pontos correspondentes das curvas
+    // interna e externa) e sua tabela de comprimento de arco acumulado.
     void generateCenterCurvePoints()
     {
         centerCurvePoints.clear();
+        centerArcLength.clear();
         if (innerCurvePoints.size() != outerCurvePoints.size() || innerCurvePoints.empty()) {
-            
             return;
         }
-        for (size_t i = 0; i < innerCurvePoints.size(); ++i) {
-            
-            centerCurvePoints.push_back((innerCurvePoints[i] + outerCurvePoints[i]) * 0.5f);
+        size_t n = innerCurvePoints.size();
+        centerCurvePoints.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            centerCurvePoints[i] = (innerCurvePoints[i] + outerCurvePoints[i]) * 0.5f;
+        }
+        centerArcLength.resize(n + 1);
+        centerArcLength[0] = 0.0f;
+        for (size_t i = 0; i < n; ++i) {
+            centerArcLength[i + 1] = centerArcLength[i] + (centerCurvePoints[(i + 1) % n] - centerCurvePoints[i]).length();
+        }
+    }
+
+    // Atualiza a curva central nos pontos [firstPoint, firstPoint + count) (circular), depois
+    // de as curvas interna e externa mudarem só nesses pontos, sem mudar de tamanho. A tabela
+    // de comprimento de arco é uma soma acumulada, então é refeita a partir da primeira aresta
+    // alterada (dando o mesmo resultado de generateCenterCurvePoints).
+    void updateCenterCurvePoints(int firstPoint, int count)
+    {
+        size_t n = centerCurvePoints.size();
+        for (int k = 0; k < count; ++k) {
+            size_t i = (firstPoint + k) % n;
+            centerCurvePoints[i] = (innerCurvePoints[i] + outerCurvePoints[i]) * 0.5f;
+        }
+        // a aresta anterior ao trecho também termina em um ponto alterado
+        size_t from = (firstPoint == 0 || firstPoint + count > (int)n) ? 0 : firstPoint - 1;
+        for (size_t i = from; i < n; ++i) {
+            centerArcLength[i + 1] = centerArcLength[i] + (centerCurvePoints[(i + 1) % n] - centerCurvePoints[i]).length();
         }
     }
 
@@ -90,32 +236,249 @@ class Track
     // Chamado quando os pontos de controle são modificados.
     void regenerateCurvePoints()
     {
-        generateBSplineCurvePoints(innerControlPoints, innerCurvePoints);
-        generateBSplineCurvePoints(outerControlPoints, outerCurvePoints);
+        generateBSplineCurvePoints(true);
+        generateBSplineCurvePoints(false);
         generateCenterCurvePoints(); 
+        buildRenderPieces();
+        grid.build(outerCurvePoints, innerCurvePoints, TRACK_GRID_CELL_SIZE);
+        sdf.build(grid);
+
+        revision = topologyRevision = nextRevision();
+        innerSegmentRevision.assign(innerSegmentStart.size() - 1, revision);
+        outerSegmentRevision.assign(outerSegmentStart.size() - 1, revision);
+        updateValidation();
     }
 
-    // Implementa o algoritmo de Ray Casting (PNPOLY) para verificar se um ponto
-    // está dentro de um polígono definido por uma lista de vértices.
-    // Retorna true se o ponto estiver dentro, false caso contrário.
-    bool isPointInPolygon(const Vector2& testPoint, const std::vector<Vector2>& polygon) const
-    {
-        int nvert = polygon.size();
-        if (nvert < 3) return false;
-        bool c = false;
-        float testx = testPoint.x;
-        float testy = testPoint.y;
-        for (int i = 0, j = nvert - 1; i < nvert; j = i++) {
-            float vertix_i = polygon[i].x;
-            float vertiy_i = polygon[i].y;
-            float vertix_j = polygon[j].x;
-            float vertiy_j = polygon[j].y;
-            
-            if (((vertiy_i > testy) != (vertiy_j > testy)) &&
-                (testx < (vertix_j - vertix_i) * (testy - vertiy_i) / std::max(0.00001f, std::fabs(vertiy_j - vertiy_i)) + vertix_i))
-                c = !c;
+    // Indica se algum segmento do trecho [firstSegment, firstSegment + count) (circular) passou
+    // a exigir outra quantidade de pontos.
+    bool sampleCountsChanged(bool inner, int firstSegment, int count) const
+    {
+        const std::vector<int>& segmentStart = inner ? innerSegmentStart : outerSegmentStart;
+        int segments = (int)segmentStart.size() - 1;
+        for (int k = 0; k < count; ++k) {
+            int i = (firstSegment + k) % segments;
+            if (segmentStart[i + 1] - segmentStart[i] != requiredSamples(inner, i)) return true;
+        }
+        return false;
+    }
+
+    // Reavalia os segmentos [firstSegment, firstSegment + count) de uma curva (sem dar a volta)
+    // com a quantidade de pontos que cada um exige agora e substitui esses pontos na curva.
+    // Enquanto gridValid for true, atualiza também a grade no trecho, expandindo a caixa
+    // alterada; gridValid passa a false se a grade precisa ser reconstruída.
+    void retessellateRun(bool inner, int firstSegment, int count, bool& gridValid, float& minX, float& minY, float& maxX, float& maxY)
+    {
+        const std::vector<Vector2>& controlPoints = inner ? innerControlPoints : outerControlPoints;
+        std::vector<Vector2>& curvePoints = inner ? innerCurvePoints : outerCurvePoints;
+        std::vector<int>& segmentStart = inner ? innerSegmentStart : outerSegmentStart;
+        int segments = (int)segmentStart.size() - 1;
+
+        int first = segmentStart[firstSegment];
+        int oldCount = segmentStart[firstSegment + count] - first;
+        segmentScratch.clear();
+        for (int i = firstSegment; i < firstSegment + count; ++i) {
+            int n = requiredSamples(inner, i);
+            size_t at = segmentScratch.size();
+            segmentScratch.resize(at + n);
+            evaluateSegment(&controlPoints[i], n, &segmentScratch[at]);
+            segmentStart[i + 1] = segmentStart[i] + n;
+        }
+        int newCount = (int)segmentScratch.size();
+        for (int i = firstSegment + count + 1; i <= segments; ++i) {
+            segmentStart[i] += newCount - oldCount;
+        }
+
+        if (newCount > oldCount) {
+            curvePoints.insert(curvePoints.begin() + first + oldCount, newCount - oldCount, Vector2());
+        } else if (newCount < oldCount) {
+            curvePoints.erase(curvePoints.begin() + first + newCount, curvePoints.begin() + first + oldCount);
+        }
+        std::copy(segmentScratch.begin(), segmentScratch.end(), curvePoints.begin() + first);
+
+        if (!gridValid) return;
+        float x0, y0, x1, y1;
+        unsigned char curveFlag = inner ? TrackGrid::INSIDE_INNER : TrackGrid::INSIDE_OUTER;
+        if (!grid.updateCurve(curvePoints, curveFlag, first, oldCount, newCount, x0, y0, x1, y1)) {
+            gridValid = false;
+            return;
+        }
+        minX = std::min(minX, x0); minY = std::min(minY, y0);
+        maxX = std::max(maxX, x1); maxY = std::max(maxY, y1);
+    }
+
+    // Recalcula apenas os quatro segmentos influenciados pelo ponto de controle único index
+    // (depois de ele ser movido), e atualiza a grade e o campo de distância nesse trecho.
+    // Se a quantidade de pontos desses segmentos mudar, a outra curva também é refeita no
+    // trecho, para manter os pontos das duas curvas emparelhados, e a curva central e os
+    // trechos do desenho são refeitos inteiros (os índices dos pontos seguintes mudam).
+    // A validação (updateValidation) é sempre refeita inteira.
+    void updateCurveAroundControlPoint(bool isInner, int index)
+    {
+        const std::vector<Vector2>& controlPoints = isInner ? innerControlPoints : outerControlPoints;
+        const std::vector<int>& segmentStart = isInner ? innerSegmentStart : outerSegmentStart;
+        int segments = (int)controlPoints.size() - 3;
+        if (segments < 4 || (int)segmentStart.size() != segments + 1) {
+            regenerateCurvePoints();
+            return;
+        }
+
+        int firstSegment = (index - 3 + segments) % segments;
+        const int count = 4;
+        bool updateOtherCurve = curvesArePaired() && sampleCountsChanged(!isInner, firstSegment, count);
+        // sem mudança na quantidade de pontos, a curva central e os trechos do desenho
+        // continuam emparelhados com as bordas e só mudam nos pontos do trecho
+        bool sameSize = !updateOtherCurve && !sampleCountsChanged(isInner, firstSegment, count) &&
+                        !centerCurvePoints.empty() && centerCurvePoints.size() == innerCurvePoints.size() &&
+                        innerCurvePoints.size() == outerCurvePoints.size();
+
+        revision = nextRevision();
+        bool gridUpdated = true;
+        float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+        for (int c = 0; c < (updateOtherCurve ? 2 : 1); ++c) {
+            bool inner = (c == 0) ? isInner : !isInner;
+            // o trecho circular é dividido em até dois trechos sem volta
+            int firstRun = std::min(count, segments - firstSegment);
+            retessellateRun(inner, firstSegment, firstRun, gridUpdated, minX, minY, maxX, maxY);
+            if (firstRun < count) {
+                retessellateRun(inner, 0, count - firstRun, gridUpdated, minX, minY, maxX, maxY);
+            }
+            std::vector<unsigned>& segmentRevision = inner ? innerSegmentRevision : outerSegmentRevision;
+            for (int k = 0; k < count; ++k) {
+                segmentRevision[(firstSegment + k) % segments] = revision;
+            }
+        }
+        if (sameSize) {
+            int firstPoint, pointCount;
+            getSegmentPointSpan(isInner, firstSegment, count, firstPoint, pointCount);
+            updateCenterCurvePoints(firstPoint, pointCount);
+            updateRenderPieces(firstPoint, pointCount);
+        } else {
+            generateCenterCurvePoints();
+            buildRenderPieces();
+        }
+
+        if (gridUpdated) {
+            sdf.update(grid, minX, minY, maxX, maxY);
+        } else {
+            grid.build(outerCurvePoints, innerCurvePoints, TRACK_GRID_CELL_SIZE);
+            sdf.build(grid);
+        }
+        updateValidation();
+    }
+
+    // Produto vetorial (b - a) x (c - a): > 0 se c está à esquerda de a->b.
+    static float orient(const Vector2& a, const Vector2& b, const Vector2& c)
+    {
+        return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    }
+
+    // Verifica se as arestas p->q e a->b se cruzam (toques em vértices não contam, como
+    // em TrackGrid) e preenche o ponto de cruzamento.
+    static bool edgesCross(const Vector2& p, const Vector2& q, const Vector2& a, const Vector2& b, Vector2& at)
+    {
+        float d1 = orient(a, b, p), d2 = orient(a, b, q);
+        float d3 = orient(p, q, a), d4 = orient(p, q, b);
+        if (((d1 > 0) == (d2 > 0)) || ((d3 > 0) == (d4 > 0))) return false;
+        if (d1 == d2) return false;
+        at = p + (q - p) * (d1 / (d1 - d2));
+        return true;
+    }
+
+    // Procura cruzamentos entre as arestas de curve e as arestas da hierarquia bvh.
+    // Se sameCurve, a hierarquia é da própria curve: cada par é testado uma vez e arestas
+    // vizinhas (que compartilham um ponto) são ignoradas.
+    void findCrossings(const std::vector<Vector2>& curve, const SegmentBVH& bvh, bool sameCurve)
+    {
+        int n = (int)curve.size();
+        for (int i = 0; i < n; ++i) {
+            const Vector2& p = curve[i];
+            const Vector2& q = curve[(i + 1) % n];
+            bvh.forEachEdgeInBox(std::min(p.x, q.x), std::min(p.y, q.y), std::max(p.x, q.x), std::max(p.y, q.y),
+                                 [&](const SegmentBVH::Edge& e) {
+                if (sameCurve) {
+                    if (e.index <= i || e.index == i + 1 || (i == 0 && e.index == n - 1)) return;
+                }
+                Vector2 at;
+                if (!edgesCross(p, q, e.a, e.b, at)) return;
+                if ((int)crossings.size() < TRACK_MAX_REPORTED_CROSSINGS) crossings.push_back(at);
+                crossingCount++;
+            });
+        }
+    }
+
+    // Reduz a largura mínima com a distância dos pontos de from até as arestas da hierarquia
+    // to (curva oposta). Cada consulta só procura arestas mais próximas que a menor largura
+    // já encontrada, então a maioria termina perto da raiz.
+    void findMinimumWidth(const std::vector<Vector2>& from, const SegmentBVH& to, bool fromInner)
+    {
+        for (const auto& p : from) {
+            Vector2 closest;
+            int edge;
+            float d = to.closestDistanceSquared(p, minimumWidth * minimumWidth, closest, edge);
+            if (edge >= 0) {
+                minimumWidth = std::sqrt(d);
+                minimumWidthInner = fromInner ? p : closest;
+                minimumWidthOuter = fromInner ? closest : p;
+            }
+        }
+    }
+
+    // Refaz a validação geométrica das bordas: reconstrói as hierarquias das duas curvas,
+    // procura cruzamentos e, se não houver, calcula a largura mínima real. Como a distância mínima entre duas
+    // poligonais que não se cruzam é atingida em um vértice de uma delas, basta consultar a
+    // distância de cada ponto até a curva oposta: O(n log n) no total.
+    void updateValidation()
+    {
+        innerBVH.build(innerCurvePoints);
+        outerBVH.build(outerCurvePoints);
+        minimumWidth = 1e30f;
+        crossingCount = 0;
+        crossings.clear();
+        if (innerBVH.empty() || outerBVH.empty()) {
+            minimumWidth = 0.0f;
+            return;
+        }
+
+        findCrossings(innerCurvePoints, innerBVH, true);
+        findCrossings(outerCurvePoints, outerBVH, true);
+        findCrossings(innerCurvePoints, outerBVH, false);
+        // com as bordas se cruzando a largura não tem sentido
+        if (crossingCount > 0) {
+            minimumWidth = 0.0f;
+            return;
+        }
+
+        // a distância entre pontos emparelhados é um limite superior que já corta as consultas
+        if (innerCurvePoints.size() == outerCurvePoints.size()) {
+            for (size_t i = 0; i < innerCurvePoints.size(); ++i) {
+                float d = (innerCurvePoints[i] - outerCurvePoints[i]).length();
+                if (d < minimumWidth) {
+                    minimumWidth = d;
+                    minimumWidthInner = innerCurvePoints[i];
+                    minimumWidthOuter = outerCurvePoints[i];
+                }
+            }
+        }
+        findMinimumWidth(innerCurvePoints, outerBVH, true);
+        findMinimumWidth(outerCurvePoints, innerBVH, false);
+    }
+
+    // Desenha o resultado da validação (no editor): o trecho de largura mínima em ciano e
+    // os cruzamentos das bordas em vermelho.
+    void drawValidation()
+    {
+        if (crossingCount == 0 && minimumWidth > 0.0f) {
+            CV::color(0.0f, 1.0f, 1.0f);
+            CV::line(minimumWidthInner, minimumWidthOuter);
+            CV::circle(minimumWidthInner.x, minimumWidthInner.y, 3, 8);
+            CV::circle(minimumWidthOuter.x, minimumWidthOuter.y, 3, 8);
+        }
+        CV::color(1.0f, 0.1f, 0.1f);
+        for (const auto& c : crossings) {
+            CV::circle(c.x, c.y, 6, 12);
+            CV::line(c.x - 4, c.y - 4, c.x + 4, c.y + 4);
+            CV::line(c.x - 4, c.y + 4, c.x + 4, c.y - 4);
         }
-        return c;
     }
 
     // Desenha uma curva na tela a partir de uma lista de pontos.
@@ -161,18 +524,167 @@ class Track
         }
     }
 
+    // Caixas dos trechos de TRACK_RENDER_PIECE_EDGES arestas consecutivas das curvas
+    // emparelhadas (asfalto, listras e contornos), para o recorte do desenho. O handle de
+    // cada trecho na SpatialHash é seu índice: o trecho k cobre as arestas
+    // [k * TRACK_RENDER_PIECE_EDGES, (k + 1) * TRACK_RENDER_PIECE_EDGES).
+    void buildRenderPieces()
+    {
+        size_t n = centerCurvePoints.size();
+        pieceBoxes.resize((n + TRACK_RENDER_PIECE_EDGES - 1) / TRACK_RENDER_PIECE_EDGES);
+        for (size_t piece = 0; piece < pieceBoxes.size(); ++piece) {
+            computePieceBox(piece);
+        }
+        insertRenderPieces();
+    }
+
+    // Recalcula a caixa do trecho piece a partir das bordas.
+    void computePieceBox(size_t piece)
+    {
+        size_t n = centerCurvePoints.size();
+        size_t first = piece * TRACK_RENDER_PIECE_EDGES, last = std::min(n, first + TRACK_RENDER_PIECE_EDGES);
+        const float margin = 2.0f; // meia largura das listras
+        float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+        for (size_t i = first; i <= last; ++i) {
+            // a curva central fica entre as duas bordas, então a caixa delas a contém
+            const Vector2& a = innerCurvePoints[i % n];
+            const Vector2& b = outerCurvePoints[i % n];
+            minX = std::min(minX, std::min(a.x, b.x)); maxX = std::max(maxX, std::max(a.x, b.x));
+            minY = std::min(minY, std::min(a.y, b.y)); maxY = std::max(maxY, std::max(a.y, b.y));
+        }
+        PieceBox box = { minX - margin, minY - margin, maxX + margin, maxY + margin };
+        pieceBoxes[piece] = box;
+    }
+
+    // Remonta a SpatialHash dos trechos com as caixas de pieceBoxes (O(trechos)).
+    void insertRenderPieces()
+    {
+        pieceHash.clear();
+        for (const auto& box : pieceBoxes) {
+            pieceHash.insert(box.minX, box.minY, box.maxX, box.maxY);
+        }
+        pieceHash.build();
+    }
+
+    // Atualiza só as caixas dos trechos que contêm os pontos [firstPoint, firstPoint + count)
+    // (circular) das bordas, que mudaram sem mudar de quantidade.
+    void updateRenderPieces(int firstPoint, int count)
+    {
+        size_t n = centerCurvePoints.size();
+        size_t previous = pieceBoxes.size();
+        for (int k = 0; k < count; ++k) {
+            size_t i = (firstPoint + k) % n;
+            // o primeiro ponto de um trecho também é o último do trecho anterior
+            size_t pieces[2] = { ((i + n - 1) % n) / TRACK_RENDER_PIECE_EDGES, i / TRACK_RENDER_PIECE_EDGES };
+            for (size_t piece : pieces) {
+                if (piece == previous) continue;
+                computePieceBox(piece);
+                previous = piece;
+            }
+        }
+        insertRenderPieces();
+    }
+
+    // Desenha as listras centrais das arestas [first, last) da curva central.
+    void drawStripes(size_t first, size_t last)
+    {
+        float stripeWidth = 4.0f;
+        // as listras são medidas pelo comprimento de arco da curva central, então têm
+        // o mesmo tamanho independentemente de quantos pontos cada segmento tem
+        const float period = 2.0f * TRACK_STRIPE_LENGTH;
+        size_t n = centerCurvePoints.size();
+
+        for (size_t i = first; i < last; ++i)
+        {
+            Vector2 p_start_center = centerCurvePoints[i];
+            Vector2 p_end_center = centerCurvePoints[(i + 1) % n];
+            float s0 = centerArcLength[i], s1 = centerArcLength[i + 1];
+            if (s1 - s0 < 0.01f) continue;
+
+            Vector2 tangent = (p_end_center - p_start_center) * (1.0f / (s1 - s0));
+            Vector2 normal = tangent.perpendicular() * (stripeWidth / 2.0f);
+
+            // recorta as listras que cruzam este trecho da poligonal
+            for (float s = s0; s < s1; )
+            {
+                float periodStart = std::floor(s / period) * period;
+                if (s - periodStart >= TRACK_STRIPE_LENGTH) {
+                    s = std::min(s1, periodStart + period);
+                    continue;
+                }
+                float e = std::min(s1, periodStart + TRACK_STRIPE_LENGTH);
+                Vector2 a = p_start_center + tangent * (s - s0);
+                Vector2 b = p_start_center + tangent * (e - s0);
+                float vx[4] = { a.x - normal.x, a.x + normal.x, b.x + normal.x, b.x - normal.x };
+                float vy[4] = { a.y - normal.y, a.y + normal.y, b.y + normal.y, b.y - normal.y };
+                CV::polygonFill(vx, vy, 4);
+                s = e;
+            }
+        }
+    }
+
+    // Desenha os trechos de visiblePieces (camada por camada: asfalto, listras e contornos)
+    // e, no editor, a validação e os pontos de controle.
+    void renderPieces()
+    {
+        size_t n = centerCurvePoints.size();
+
+        CV::color(0.2f, 0.2f, 0.25f);
+        for (int piece : visiblePieces) {
+            size_t first = (size_t)piece * TRACK_RENDER_PIECE_EDGES, last = std::min(n, first + TRACK_RENDER_PIECE_EDGES);
+            for (size_t i = first; i < last; ++i) {
+                Vector2 o1 = outerCurvePoints[i];
+                Vector2 i1 = innerCurvePoints[i];
+                Vector2 o2 = outerCurvePoints[(i + 1) % n];
+                Vector2 i2 = innerCurvePoints[(i + 1) % n];
+                CV::triangleFill(o1, i1, i2);
+                CV::triangleFill(o1, i2, o2);
+            }
+        }
+
+        CV::color(1.0f, 0.85f, 0.0f);
+        for (int piece : visiblePieces) {
+            size_t first = (size_t)piece * TRACK_RENDER_PIECE_EDGES;
+            drawStripes(first, std::min(n, first + TRACK_RENDER_PIECE_EDGES));
+        }
+
+        if (n == 0) {
+            // curvas com números de pontos diferentes (no editor): só os contornos, inteiros
+            drawCurveFromPoints(innerCurvePoints);
+            drawCurveFromPoints(outerCurvePoints);
+        } else {
+            CV::color(0, 0, 0);
+            for (int piece : visiblePieces) {
+                size_t first = (size_t)piece * TRACK_RENDER_PIECE_EDGES;
+                size_t last = std::min(n - 1, first + TRACK_RENDER_PIECE_EDGES); // os contornos não fecham
+                for (size_t i = first; i < last; ++i) {
+                    CV::line(innerCurvePoints[i], innerCurvePoints[i + 1]);
+                    CV::line(outerCurvePoints[i], outerCurvePoints[i + 1]);
+                }
+            }
+        }
+
+        if (showPoints)
+        {
+            drawValidation();
+            drawControlPoints();
+        }
+    }
+
 public:
     // Construtor da classe Track.
     // Inicializa a pista com pontos de controle formando um círculo.
-    // Parâmetros definem dimensões da tela, centro e raios da pista inicial, e número de pontos.
-    Track(int screenWidth, int screenHeight, float centerX, float centerY, float innerRadius, float outerRadius, int numPoints = 6)
+    // Parâmetros definem dimensões do mundo, centro e raios da pista inicial, e número de pontos.
+    Track(int worldWidth, int worldHeight, float centerX, float centerY, float innerRadius, float outerRadius, int numPoints = 6)
     {
-        this->screenWidth = screenWidth;
-        this->screenHeight = screenHeight;
+        this->worldWidth = worldWidth;
+        this->worldHeight = worldHeight;
         this->showPoints = false; 
         this->draggingPointIndex = -1;
         this->selectedPointIndex = -1; 
         this->selectedPointIsInner = false; 
+        sdf.setResolution(TRACK_SDF_TEXEL_SIZE, TRACK_SDF_MAX_DISTANCE);
+        pieceHash = SpatialHash(TRACK_RENDER_CELL_SIZE);
 
         for (int i = 0; i < numPoints; ++i)
         {
@@ -195,88 +707,28 @@ public:
         regenerateCurvePoints(); 
     }
 
-    // Renderiza a pista completa na tela.
+    // Renderiza a pista completa.
     // Inclui o asfalto, as listras centrais amarelas, as linhas de contorno
     // e os pontos de controle (se a visibilidade estiver ativa).
     void renderTrack()
     {
-        
-        CV::color(0.2f, 0.2f, 0.25f); 
-        if (innerCurvePoints.size() > 1 && innerCurvePoints.size() == outerCurvePoints.size())
-        {
-            size_t numPoints = innerCurvePoints.size();
-            for (size_t i = 0; i < numPoints; ++i)
-            {
-                Vector2 o1 = outerCurvePoints[i];
-                Vector2 i1 = innerCurvePoints[i];
-                
-                Vector2 o2 = outerCurvePoints[(i + 1) % numPoints];
-                Vector2 i2 = innerCurvePoints[(i + 1) % numPoints];
-
-                
-                CV::triangleFill(o1, i1, i2); 
-                CV::triangleFill(o1, i2, o2); 
-            }
-        }
-
-        
-        CV::color(1.0f, 0.85f, 0.0f); 
-        if (centerCurvePoints.size() > 1)
-        {
-            float stripeWidth = 4.0f;   
-            int stripePatternUnitLength = 15; 
-                                             
-            bool drawCurrentSegmentAsStripe = true;
-            int patternCounter = 0;
-
-            for (size_t i = 0; i < centerCurvePoints.size() - 1; ++i)
-            {
-                patternCounter++;
-                if (patternCounter >= stripePatternUnitLength) {
-                    drawCurrentSegmentAsStripe = !drawCurrentSegmentAsStripe; 
-                    patternCounter = 0;
-                }
-
-                if (!drawCurrentSegmentAsStripe) {
-                    continue; 
-                }
-
-                Vector2 p_start_center = centerCurvePoints[i];
-                Vector2 p_end_center = centerCurvePoints[i+1];
-
-                Vector2 tangent = (p_end_center - p_start_center);
-                
-                if (tangent.lengthSquared() < 0.0001f) continue; 
-                tangent.normalize();
-                Vector2 normal = tangent.perpendicular(); 
-
-                
-                std::vector<Vector2> stripeRectVertices;
-                stripeRectVertices.push_back(p_start_center - normal * (stripeWidth / 2.0f));
-                stripeRectVertices.push_back(p_start_center + normal * (stripeWidth / 2.0f));
-                stripeRectVertices.push_back(p_end_center   + normal * (stripeWidth / 2.0f));
-                stripeRectVertices.push_back(p_end_center   - normal * (stripeWidth / 2.0f));
-                
-                
-                float vx[4], vy[4];
-                for(int k=0; k<4; ++k) {
-                    vx[k] = stripeRectVertices[k].x;
-                    vy[k] = stripeRectVertices[k].y;
-                }
-                CV::polygonFill(vx, vy, 4); 
-            }
+        visiblePieces.clear();
+        for (int piece = 0; piece < pieceHash.size(); ++piece) {
+            visiblePieces.push_back(piece);
         }
+        renderPieces();
+    }
 
-        
-        
-        drawCurveFromPoints(innerCurvePoints);
-        drawCurveFromPoints(outerCurvePoints);
-
-        
-        if (showPoints)
-        {
-            drawControlPoints();
-        }
+    // Renderiza só os trechos da pista cuja caixa cruza a área visível dada (coordenadas
+    // do mundo): o custo depende do que aparece na tela e não do tamanho da pista.
+    void renderTrack(float minX, float minY, float maxX, float maxY)
+    {
+        visiblePieces.clear();
+        pieceHash.query(minX, minY, maxX, maxY, [this](int piece) {
+            visiblePieces.push_back(piece);
+            return true;
+        });
+        renderPieces();
     }
 
     // Alterna a visibilidade dos pontos de controle na tela.
@@ -327,7 +779,7 @@ public:
     }
 
     // Lida com o arrastar do mouse quando um ponto de controle está selecionado.
-    // Atualiza a posição do ponto de controle arrastado e recalcula as curvas da pista.
+    // Atualiza a posição do ponto de controle arrastado e recalcula o trecho afetado das curvas.
     void handleMouseDrag(int mouseX, int mouseY)
     {
         if (draggingPointIndex != -1 && showPoints)
@@ -338,6 +790,7 @@ public:
             } else {
                 pointToDrag = &outerControlPoints[draggingPointIndex];
             }
+            if (pointToDrag->x == mouseX && pointToDrag->y == mouseY) return;
             pointToDrag->set(mouseX, mouseY);
             if (draggingPointIndex < 3) {
                 if (draggingInnerPoint) {
@@ -346,7 +799,7 @@ public:
                     outerControlPoints[outerControlPoints.size() - 3 + draggingPointIndex].set(mouseX, mouseY);
                 }
             }
-            regenerateCurvePoints(); 
+            updateCurveAroundControlPoint(draggingInnerPoint, draggingPointIndex); 
         }
     }
 
@@ -365,11 +818,61 @@ public:
 
     // Verifica se um ponto (Vector2) está dentro da área da pista.
     // Um ponto está na pista se estiver dentro da curva externa e fora da curva interna.
+    // A consulta usa a grade reconstruída em regenerateCurvePoints (O(1) em média).
     bool isPointInsideTrack(const Vector2& point) const
     {
-        if (outerCurvePoints.empty() || innerCurvePoints.empty()) return false;
-        
-        return isPointInPolygon(point, outerCurvePoints) && !isPointInPolygon(point, innerCurvePoints);
+        return grid.isInside(point);
+    }
+
+    // Retorna a distância com sinal do ponto até a borda da pista:
+    // positiva dentro da pista, negativa fora (profundidade de penetração).
+    float signedDistance(const Vector2& point) const
+    {
+        return sdf.sample(point);
+    }
+
+    // Igual a signedDistance, preenchendo também a normal da borda (aponta para dentro da pista).
+    float signedDistance(const Vector2& point, Vector2& normal) const
+    {
+        return sdf.sample(point, normal);
+    }
+
+    // Teste contínuo de um ponto que vai de from até to contra a borda da pista.
+    // Retorna true se o ponto sai da pista durante o passo e preenche t (0 a 1), a fração
+    // do passo em que ele cruza a borda (t = 0 se from já está fora).
+    // Sphere tracing: a distância até a borda limita quanto o ponto pode avançar sem cruzá-la
+    // (a interpolação bilinear varia no máximo sqrt(2) pixels por pixel, daí o fator 0.7);
+    // um ponto longe da borda é resolvido com uma única consulta ao campo, e bordas finas
+    // não são atravessadas mesmo com passos longos.
+    bool sweepBoundary(const Vector2& from, const Vector2& to, float& t) const
+    {
+        Vector2 d = to - from;
+        float length = d.length();
+        float s = 0.0f;
+        for (int step = 0; step < TRACK_SWEEP_MAX_STEPS; ++step) {
+            float distance = sdf.sample(from + d * s);
+            if (distance < 0.0f) {
+                t = s;
+                return true;
+            }
+            if (s >= 1.0f || length <= 0.0f) return false;
+            // o resto do passo cabe na distância garantida: não cruza a borda
+            if (s + distance * 0.7f / length >= 1.0f) return false;
+            s = std::min(1.0f, s + std::max(distance * 0.7f, TRACK_SWEEP_MIN_STEP) / length);
+        }
+        // passos demais (trajetória rente à borda): decide pelo ponto final
+        if (sdf.sample(to) < 0.0f) {
+            t = 1.0f;
+            return true;
+        }
+        return false;
+    }
+
+    // Altera a resolução do campo de distância (tamanho do texel em pixels) e o reconstrói.
+    void setDistanceFieldResolution(float texelSize, float maxDistance = TRACK_SDF_MAX_DISTANCE)
+    {
+        sdf.setResolution(texelSize, maxDistance);
+        sdf.build(grid);
     }
 
     // Adiciona um novo ponto de controle à curva interna ou externa.
@@ -444,21 +947,23 @@ public:
     }
 
     // Valida se a largura da pista é suficiente para acomodar um objeto de uma determinada largura.
-    // Verifica a distância entre os pontos correspondentes das curvas interna e externa.
-    // Retorna true se a pista for larga o suficiente em todos os pontos, false caso contrário.
+    // Usa a largura mínima real (menor distância entre as bordas) da última validação.
+    // Retorna false se a pista for estreita demais em algum ponto ou se as bordas se cruzam.
     bool validateTrackWidth(float objectWidth) const {
-        if (innerCurvePoints.empty() || outerCurvePoints.empty() || innerCurvePoints.size() != outerCurvePoints.size()) {
+        if (innerCurvePoints.empty() || outerCurvePoints.empty()) {
             return false; 
         }
+        return crossingCount == 0 && minimumWidth >= objectWidth;
+    }
 
-        for (size_t i = 0; i < innerCurvePoints.size(); ++i) {
-            
-            float distance = (innerCurvePoints[i] - outerCurvePoints[i]).length();
-            if (distance < objectWidth) {
-                return false; 
-            }
-        }
-        return true; 
+    // Menor distância entre as curvas interna e externa (0 se as bordas se cruzam).
+    float getMinimumWidth() const {
+        return minimumWidth;
+    }
+
+    // Número de pares de arestas das bordas que se cruzam (0 em uma pista válida).
+    int getCrossingCount() const {
+        return crossingCount;
     }
 
     // Retorna uma referência constante ao vetor de pontos da curva externa.
@@ -472,14 +977,135 @@ public:
         return innerCurvePoints;
     }
 
-    // Retorna a largura da tela.
-    int getScreenWidth() const {
-        return screenWidth;
+    // Retorna os pontos de controle (incluindo os três repetidos que fecham a curva).
+    const std::vector<Vector2>& getInnerControlPoints() const {
+        return innerControlPoints;
+    }
+
+    const std::vector<Vector2>& getOuterControlPoints() const {
+        return outerControlPoints;
+    }
+
+    // Substitui os pontos de controle (no formato de getInnerControlPoints) e regenera a pista.
+    // Usado para reconstruir a pista de uma partida gravada.
+    void setControlPoints(const std::vector<Vector2>& inner, const std::vector<Vector2>& outer) {
+        innerControlPoints = inner;
+        outerControlPoints = outer;
+        selectedPointIndex = -1;
+        draggingPointIndex = -1;
+        regenerateCurvePoints();
+    }
+
+    // Revisão atual das curvas (muda a cada alteração).
+    unsigned getRevision() const {
+        return revision;
+    }
+
+    // Preenche o trecho circular [firstSegment, firstSegment + segmentCount) de segmentos da
+    // curva (interna ou externa) que mudou depois da revisão sinceRevision; segmentCount = 0 se
+    // nada mudou. Retorna false se o número de segmentos da curva mudou nesse intervalo
+    // (o consumidor deve se reconstruir inteiro).
+    bool getDirtySegments(unsigned sinceRevision, bool inner, int& firstSegment, int& segmentCount) const {
+        firstSegment = segmentCount = 0;
+        if (topologyRevision > sinceRevision) return false;
+
+        const std::vector<unsigned>& segmentRevision = inner ? innerSegmentRevision : outerSegmentRevision;
+        int segments = (int)segmentRevision.size();
+        int start = -1;
+        for (int i = 0; i < segments && start < 0; ++i) {
+            if (segmentRevision[i] > sinceRevision) start = i;
+        }
+        if (start < 0) return true;
+
+        // o trecho é o complemento da maior sequência circular de segmentos inalterados
+        int longestClean = -1, longestEnd = start, run = 0;
+        for (int k = 1; k <= segments; ++k) {
+            int i = (start + k) % segments;
+            if (segmentRevision[i] > sinceRevision) {
+                if (run > longestClean) {
+                    longestClean = run;
+                    longestEnd = i;
+                }
+                run = 0;
+            } else {
+                run++;
+            }
+        }
+        firstSegment = longestEnd;
+        segmentCount = segments - longestClean;
+        return true;
+    }
+
+    // Número de segmentos da curva interna ou externa.
+    int getSegmentCount(bool inner) const {
+        return (int)(inner ? innerSegmentStart : outerSegmentStart).size() - 1;
+    }
+
+    // Converte o trecho circular de segmentos [firstSegment, firstSegment + segmentCount) no
+    // trecho circular de pontos da curva [firstPoint, firstPoint + pointCount).
+    void getSegmentPointSpan(bool inner, int firstSegment, int segmentCount, int& firstPoint, int& pointCount) const {
+        const std::vector<int>& segmentStart = inner ? innerSegmentStart : outerSegmentStart;
+        int segments = (int)segmentStart.size() - 1;
+        firstPoint = pointCount = 0;
+        if (segments <= 0 || segmentCount <= 0) return;
+        segmentCount = std::min(segmentCount, segments);
+        firstPoint = segmentStart[firstSegment];
+        int end = firstSegment + segmentCount;
+        if (end <= segments) {
+            pointCount = segmentStart[end] - firstPoint;
+        } else {
+            pointCount = segmentStart[segments] - firstPoint + segmentStart[end - segments];
+        }
+    }
+
+    // Segmento ao qual pertence o ponto pointIndex da curva (busca binária).
+    int getSegmentOfPoint(bool inner, int pointIndex) const {
+        const std::vector<int>& segmentStart = inner ? innerSegmentStart : outerSegmentStart;
+        if (segmentStart.size() < 2) return 0;
+        int segment = (int)(std::upper_bound(segmentStart.begin(), segmentStart.end(), pointIndex) - segmentStart.begin()) - 1;
+        return std::max(0, std::min((int)segmentStart.size() - 2, segment));
+    }
+
+    // Comprimento total da curva central (fechada), em pixels.
+    float getCenterLength() const {
+        return centerArcLength.empty() ? 0.0f : centerArcLength.back();
+    }
+
+    // Ponto da curva central a uma distância s (ao longo da curva) do seu primeiro ponto,
+    // preenchendo também a tangente unitária nesse ponto. s dá a volta na curva.
+    // Busca binária na tabela de comprimento de arco: O(log n).
+    Vector2 sampleCenterAtDistance(float s, Vector2& tangent) const {
+        tangent.set(1.0f, 0.0f);
+        if (centerCurvePoints.empty()) return Vector2(worldWidth / 2.0f, worldHeight / 2.0f);
+        float length = getCenterLength();
+        size_t n = centerCurvePoints.size();
+        if (length <= 0.0f) return centerCurvePoints[0];
+        s = std::fmod(s, length);
+        if (s < 0.0f) s += length;
+
+        size_t i = (size_t)(std::upper_bound(centerArcLength.begin(), centerArcLength.end(), s) - centerArcLength.begin());
+        i = std::max((size_t)1, std::min(n, i)) - 1;
+        const Vector2& a = centerCurvePoints[i];
+        const Vector2& b = centerCurvePoints[(i + 1) % n];
+        float segmentLength = centerArcLength[i + 1] - centerArcLength[i];
+        if (segmentLength <= 0.0f) return a;
+        tangent = (b - a) * (1.0f / segmentLength);
+        return a + (b - a) * ((s - centerArcLength[i]) / segmentLength);
+    }
+
+    Vector2 sampleCenterAtDistance(float s) const {
+        Vector2 tangent;
+        return sampleCenterAtDistance(s, tangent);
+    }
+
+    // Retorna a largura do mundo.
+    int getWorldWidth() const {
+        return worldWidth;
     }
 
-    // Retorna a altura da tela.
-    int getScreenHeight() const {
-        return screenHeight;
+    // Retorna a altura do mundo.
+    int getWorldHeight() const {
+        return worldHeight;
     }
 };
 
@@ -0,0 +1,287 @@
+// Este arquivo define a classe TrackGrid, uma grade uniforme de aceleração
+// para o teste "ponto dentro da pista". A grade cobre a caixa envolvente da curva
+// externa e guarda, para cada célula:
+// - as arestas (das curvas interna e externa) que passam pela célula (baldes);
+// - se o centro da célula está dentro da curva externa e/ou da curva interna.
+// Células sem arestas são inteiramente dentro ou fora, e a consulta é uma leitura.
+// Em células de borda, a paridade do centro é corrigida contando apenas os
+// cruzamentos do segmento centro->ponto com as poucas arestas daquele balde.
+// A grade é reconstruída sempre que as curvas da pista são regeneradas; quando só um
+// trecho de uma curva muda (edição de um ponto de controle), updateCurve substitui apenas
+// as arestas do trecho (que pode ganhar ou perder arestas) e corrige a paridade dos centros desfazendo a contribuição das
+// arestas antigas e refazendo a das novas. Os baldes, por estarem em formato compacto e
+// indexarem as arestas (cujos índices mudam se o trecho ganha ou perde arestas), ainda são
+// remontados inteiros, em O(arestas + células).
+#ifndef ___TRACK_GRID__H___
+#define ___TRACK_GRID__H___
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include "Vector2.h"
+
+class TrackGrid
+{
+public:
+    // Bits de estado do centro de cada célula
+    enum CellFlags {
+        INSIDE_OUTER = 1,
+        INSIDE_INNER = 2
+    };
+
+private:
+    struct Edge {
+        Vector2 a, b;
+        unsigned char curve; // INSIDE_OUTER ou INSIDE_INNER: qual paridade a aresta altera
+    };
+
+    float cellSize;
+    float originX, originY;
+    int cellsX, cellsY;
+
+    std::vector<Edge> edges;                // arestas da curva externa, seguidas das da interna
+    int innerEdgeStart;                     // índice da primeira aresta da curva interna
+    std::vector<unsigned char> centerFlags; // CellFlags por célula
+    std::vector<int> bucketStart;           // índice inicial de cada célula em bucketEdges (cellsX*cellsY + 1)
+    std::vector<int> bucketEdges;           // índices de arestas, agrupados por célula
+
+    // Produto vetorial (b - a) x (c - a): > 0 se c está à esquerda de a->b.
+    static float orient(const Vector2& a, const Vector2& b, const Vector2& c)
+    {
+        return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    }
+
+    // Cruzamento entre os segmentos p->q e a->b. O uso de "> 0" nos dois lados
+    // torna a contagem consistente quando o segmento passa exatamente por um vértice.
+    static bool segmentsCross(const Vector2& p, const Vector2& q, const Vector2& a, const Vector2& b)
+    {
+        return ((orient(a, b, p) > 0) != (orient(a, b, q) > 0)) &&
+               ((orient(p, q, a) > 0) != (orient(p, q, b) > 0));
+    }
+
+    // Adiciona as arestas fechadas de uma curva à lista.
+    void appendCurveEdges(const std::vector<Vector2>& curve, unsigned char flag)
+    {
+        size_t n = curve.size();
+        if (n < 3) return;
+        for (size_t i = 0; i < n; ++i) {
+            Edge e;
+            e.a = curve[i];
+            e.b = curve[(i + 1) % n];
+            e.curve = flag;
+            edges.push_back(e);
+        }
+    }
+
+    void edgeCellRange(const Edge& e, int& cx0, int& cy0, int& cx1, int& cy1) const
+    {
+        cx0 = std::max(0, (int)std::floor((std::min(e.a.x, e.b.x) - originX) / cellSize));
+        cy0 = std::max(0, (int)std::floor((std::min(e.a.y, e.b.y) - originY) / cellSize));
+        cx1 = std::min(cellsX - 1, (int)std::floor((std::max(e.a.x, e.b.x) - originX) / cellSize));
+        cy1 = std::min(cellsY - 1, (int)std::floor((std::max(e.a.y, e.b.y) - originY) / cellSize));
+    }
+
+    // Monta os baldes em formato compacto (contagem + prefixo + preenchimento).
+    void buildBuckets()
+    {
+        int numCells = cellsX * cellsY;
+        bucketStart.assign(numCells + 1, 0);
+        int cx0, cy0, cx1, cy1;
+        for (size_t i = 0; i < edges.size(); ++i) {
+            edgeCellRange(edges[i], cx0, cy0, cx1, cy1);
+            for (int cy = cy0; cy <= cy1; ++cy)
+                for (int cx = cx0; cx <= cx1; ++cx)
+                    bucketStart[cy * cellsX + cx + 1]++;
+        }
+        for (int c = 0; c < numCells; ++c) {
+            bucketStart[c + 1] += bucketStart[c];
+        }
+        bucketEdges.assign(bucketStart[numCells], 0);
+        std::vector<int> fill(bucketStart.begin(), bucketStart.end() - 1);
+        for (size_t i = 0; i < edges.size(); ++i) {
+            edgeCellRange(edges[i], cx0, cy0, cx1, cy1);
+            for (int cy = cy0; cy <= cy1; ++cy)
+                for (int cx = cx0; cx <= cx1; ++cx)
+                    bucketEdges[fill[cy * cellsX + cx]++] = (int)i;
+        }
+    }
+
+    // Calcula a paridade dos centros das células linha a linha (varredura horizontal),
+    // com a mesma regra de meia-abertura do PNPOLY.
+    void buildCenterFlags()
+    {
+        centerFlags.assign(cellsX * cellsY, 0);
+        std::vector<std::pair<float, unsigned char> > crossings;
+        for (int cy = 0; cy < cellsY; ++cy) {
+            float y = originY + (cy + 0.5f) * cellSize;
+            crossings.clear();
+            for (size_t i = 0; i < edges.size(); ++i) {
+                const Edge& e = edges[i];
+                if ((e.a.y > y) != (e.b.y > y)) {
+                    float x = e.a.x + (e.b.x - e.a.x) * (y - e.a.y) / (e.b.y - e.a.y);
+                    crossings.push_back(std::make_pair(x, e.curve));
+                }
+            }
+            std::sort(crossings.begin(), crossings.end());
+
+            // Percorre da direita para a esquerda: a paridade de um centro é o número de
+            // cruzamentos à sua direita (raio em +x, como no PNPOLY).
+            unsigned char flags = 0;
+            int k = (int)crossings.size() - 1;
+            for (int cx = cellsX - 1; cx >= 0; --cx) {
+                float x = originX + (cx + 0.5f) * cellSize;
+                while (k >= 0 && crossings[k].first > x) {
+                    flags ^= crossings[k].second;
+                    --k;
+                }
+                centerFlags[cy * cellsX + cx] = flags;
+            }
+        }
+    }
+
+    // Inverte a paridade dos centros à esquerda do cruzamento da aresta com cada linha,
+    // ou seja, adiciona (ou remove) a contribuição da aresta calculada em buildCenterFlags.
+    void toggleEdgeCrossings(const Edge& e)
+    {
+        int cy0 = std::max(0, (int)std::floor((std::min(e.a.y, e.b.y) - originY) / cellSize) - 1);
+        int cy1 = std::min(cellsY - 1, (int)std::floor((std::max(e.a.y, e.b.y) - originY) / cellSize) + 1);
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            float y = originY + (cy + 0.5f) * cellSize;
+            if ((e.a.y > y) == (e.b.y > y)) continue;
+            float x = e.a.x + (e.b.x - e.a.x) * (y - e.a.y) / (e.b.y - e.a.y);
+            unsigned char* row = &centerFlags[cy * cellsX];
+            for (int cx = 0; cx < cellsX && originX + (cx + 0.5f) * cellSize < x; ++cx) {
+                row[cx] ^= e.curve;
+            }
+        }
+    }
+
+    bool containsPoint(const Vector2& p) const
+    {
+        return p.x > originX && p.y > originY &&
+               p.x < originX + cellsX * cellSize && p.y < originY + cellsY * cellSize;
+    }
+
+public:
+    TrackGrid() : cellSize(8.0f), originX(0), originY(0), cellsX(0), cellsY(0), innerEdgeStart(0) {}
+
+    // Reconstrói a grade a partir das curvas externa e interna (polígonos fechados).
+    void build(const std::vector<Vector2>& outerCurve, const std::vector<Vector2>& innerCurve, float newCellSize)
+    {
+        cellSize = newCellSize;
+        edges.clear();
+        cellsX = cellsY = 0;
+        if (outerCurve.size() < 3 || innerCurve.size() < 3) {
+            centerFlags.clear();
+            bucketStart.clear();
+            bucketEdges.clear();
+            return;
+        }
+
+        float minX = outerCurve[0].x, maxX = minX, minY = outerCurve[0].y, maxY = minY;
+        const std::vector<Vector2>* curves[2] = { &outerCurve, &innerCurve };
+        for (int c = 0; c < 2; ++c) {
+            for (size_t i = 0; i < curves[c]->size(); ++i) {
+                const Vector2& p = (*curves[c])[i];
+                minX = std::min(minX, p.x); maxX = std::max(maxX, p.x);
+                minY = std::min(minY, p.y); maxY = std::max(maxY, p.y);
+            }
+        }
+        originX = minX - cellSize;
+        originY = minY - cellSize;
+        cellsX = (int)std::ceil((maxX - originX) / cellSize) + 1;
+        cellsY = (int)std::ceil((maxY - originY) / cellSize) + 1;
+
+        appendCurveEdges(outerCurve, INSIDE_OUTER);
+        innerEdgeStart = (int)edges.size();
+        appendCurveEdges(innerCurve, INSIDE_INNER);
+        buildBuckets();
+        buildCenterFlags();
+    }
+
+    // Substitui as arestas da curva (INSIDE_OUTER ou INSIDE_INNER) que saem dos pontos
+    // [first, first + oldCount) por arestas que saem dos pontos [first, first + newCount) da
+    // curva nova (o trecho não dá a volta; o resto da curva só é deslocado). Preenche a caixa
+    // que contém as arestas antigas e novas do trecho (a região em que a cobertura pode ter
+    // mudado). Retorna false, sem alterar a grade, se os tamanhos não são coerentes ou se o
+    // trecho saiu da área da grade; nesse caso é preciso chamar build.
+    bool updateCurve(const std::vector<Vector2>& curve, unsigned char flag, int first, int oldCount, int newCount,
+                     float& minX, float& minY, float& maxX, float& maxY)
+    {
+        int base = (flag == INSIDE_OUTER) ? 0 : innerEdgeStart;
+        int nOld = (flag == INSIDE_OUTER) ? innerEdgeStart : (int)edges.size() - innerEdgeStart;
+        int nNew = (int)curve.size();
+        if (cellsX == 0 || nOld < 3 || nNew - newCount != nOld - oldCount) return false;
+        if (first < 0 || first + oldCount > nOld || oldCount >= nOld || newCount >= nNew) return false;
+        for (int k = 0; k < newCount; ++k) {
+            if (!containsPoint(curve[first + k])) return false;
+        }
+
+        minX = minY = 1e30f;
+        maxX = maxY = -1e30f;
+        // desfaz as arestas antigas; a aresta anterior ao trecho também termina em um ponto alterado
+        for (int k = -1; k < oldCount; ++k) {
+            const Edge& e = edges[base + (first + k + nOld) % nOld];
+            minX = std::min(minX, std::min(e.a.x, e.b.x)); maxX = std::max(maxX, std::max(e.a.x, e.b.x));
+            minY = std::min(minY, std::min(e.a.y, e.b.y)); maxY = std::max(maxY, std::max(e.a.y, e.b.y));
+            toggleEdgeCrossings(e);
+        }
+
+        if (newCount > oldCount) {
+            edges.insert(edges.begin() + base + first + oldCount, newCount - oldCount, Edge());
+        } else if (newCount < oldCount) {
+            edges.erase(edges.begin() + base + first + newCount, edges.begin() + base + first + oldCount);
+        }
+        if (flag == INSIDE_OUTER) innerEdgeStart += newCount - oldCount;
+
+        for (int k = -1; k < newCount; ++k) {
+            int i = (first + k + nNew) % nNew;
+            Edge& e = edges[base + i];
+            e.a = curve[i];
+            e.b = curve[(i + 1) % nNew];
+            e.curve = flag;
+            minX = std::min(minX, std::min(e.a.x, e.b.x)); maxX = std::max(maxX, std::max(e.a.x, e.b.x));
+            minY = std::min(minY, std::min(e.a.y, e.b.y)); maxY = std::max(maxY, std::max(e.a.y, e.b.y));
+            toggleEdgeCrossings(e);
+        }
+        buildBuckets();
+        return true;
+    }
+
+    // Retorna os CellFlags do ponto (dentro da curva externa / interna).
+    unsigned char queryFlags(const Vector2& point) const
+    {
+        if (cellsX == 0) return 0;
+        int cx = (int)std::floor((point.x - originX) / cellSize);
+        int cy = (int)std::floor((point.y - originY) / cellSize);
+        if (cx < 0 || cy < 0 || cx >= cellsX || cy >= cellsY) return 0;
+
+        int cell = cy * cellsX + cx;
+        unsigned char flags = centerFlags[cell];
+        int begin = bucketStart[cell], end = bucketStart[cell + 1];
+        if (begin == end) return flags;
+
+        Vector2 center(originX + (cx + 0.5f) * cellSize, originY + (cy + 0.5f) * cellSize);
+        for (int k = begin; k < end; ++k) {
+            const Edge& e = edges[bucketEdges[k]];
+            if (segmentsCross(center, point, e.a, e.b)) {
+                flags ^= e.curve;
+            }
+        }
+        return flags;
+    }
+
+    // Um ponto está na pista se estiver dentro da curva externa e fora da interna.
+    bool isInside(const Vector2& point) const
+    {
+        return queryFlags(point) == INSIDE_OUTER;
+    }
+
+    float getCellSize() const { return cellSize; }
+    float getOriginX() const { return originX; }
+    float getOriginY() const { return originY; }
+    int getCellsX() const { return cellsX; }
+    int getCellsY() const { return cellsY; }
+};
+
+#endif
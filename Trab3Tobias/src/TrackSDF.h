@@ -0,0 +1,224 @@
+// Este arquivo define a classe TrackSDF, um campo de distância com sinal (SDF)
+// da área dirigível da pista, amostrado em uma grade de resolução configurável.
+// Convenção de sinal:
+// - valor positivo: o ponto está na pista, a essa distância (em pixels) da borda mais próxima;
+// - valor negativo: o ponto está fora da pista, e o módulo é a profundidade de penetração.
+// O gradiente do campo aponta para dentro da pista, servindo de normal da superfície.
+// O campo é construído a partir da máscara de cobertura (TrackGrid) usando a
+// transformada de distância euclidiana exata de Felzenszwalb-Huttenlocher,
+// separável: uma passada por linhas e outra por colunas, ambas em paralelo.
+// Os valores são truncados em +-maxDistance, já que só a vizinhança da borda importa.
+// Por isso uma alteração local da pista só muda o campo a até maxDistance da região
+// alterada: update recalcula apenas essa região, usando como sementes os texels de uma
+// janela com mais maxDistance de margem, e o resultado é igual ao de uma reconstrução.
+#ifndef ___TRACK_SDF__H___
+#define ___TRACK_SDF__H___
+
+#include <vector>
+#include <cmath>
+#include "Vector2.h"
+#include "TrackGrid.h"
+#include "Parallel.h"
+
+#define SDF_INFINITY 1e20f
+
+class TrackSDF
+{
+    float texelSize;
+    float maxDistance;
+    float originX, originY;
+    int width, height;
+    std::vector<float> distances;
+
+    // Transformada de distância 1D (quadrado da distância) sobre f[0..n), com envelope
+    // inferior de parábolas. v, z e d são buffers de trabalho do chamador.
+    static void distanceTransform1D(const float* f, int n, float* d, int* v, float* z)
+    {
+        int k = 0;
+        v[0] = 0;
+        z[0] = -SDF_INFINITY;
+        z[1] = SDF_INFINITY;
+        for (int q = 1; q < n; ++q) {
+            if (f[q] >= SDF_INFINITY) continue;
+            if (f[v[k]] >= SDF_INFINITY) {
+                v[k] = q;
+                continue;
+            }
+            float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+            while (s <= z[k]) {
+                --k;
+                s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+            }
+            ++k;
+            v[k] = q;
+            z[k] = s;
+            z[k + 1] = SDF_INFINITY;
+        }
+        if (f[v[0]] >= SDF_INFINITY) {
+            for (int q = 0; q < n; ++q) d[q] = SDF_INFINITY;
+            return;
+        }
+        k = 0;
+        for (int q = 0; q < n; ++q) {
+            while (z[k + 1] < q) ++k;
+            float dq = (float)(q - v[k]);
+            d[q] = dq * dq + f[v[k]];
+        }
+    }
+
+    // Transformada 2D de uma janela w x h: field entra com 0 nos texels-semente e SDF_INFINITY
+    // nos demais, e sai com o quadrado da distância (em texels) até a semente mais próxima.
+    static void distanceTransform2D(std::vector<float>& field, int w, int h)
+    {
+        float* data = &field[0];
+
+        // passada por colunas: cada thread processa um conjunto de colunas
+        parallelForRanges(w, [=](int begin, int end) {
+            std::vector<float> f(h), d(h), z(h + 1);
+            std::vector<int> v(h);
+            for (int x = begin; x < end; ++x) {
+                for (int y = 0; y < h; ++y) f[y] = data[y * w + x];
+                distanceTransform1D(&f[0], h, &d[0], &v[0], &z[0]);
+                for (int y = 0; y < h; ++y) data[y * w + x] = d[y];
+            }
+        }, 32);
+
+        // passada por linhas
+        parallelForRanges(h, [=](int begin, int end) {
+            std::vector<float> d(w), z(w + 1);
+            std::vector<int> v(w);
+            for (int y = begin; y < end; ++y) {
+                float* row = data + y * w;
+                distanceTransform1D(row, w, &d[0], &v[0], &z[0]);
+                for (int x = 0; x < w; ++x) row[x] = d[x];
+            }
+        }, 32);
+    }
+
+    float texel(int x, int y) const
+    {
+        x = x < 0 ? 0 : (x >= width ? width - 1 : x);
+        y = y < 0 ? 0 : (y >= height ? height - 1 : y);
+        return distances[y * width + x];
+    }
+
+    // Calcula os texels [x0, x1) x [y0, y1). As transformadas de distância rodam em uma
+    // janela com margem de maxDistance (mais um texel), o suficiente para conter a semente
+    // mais próxima de todo texel da região cuja distância não é truncada.
+    void computeRegion(const TrackGrid& grid, int x0, int y0, int x1, int y1)
+    {
+        if (x0 >= x1 || y0 >= y1) return;
+        int margin = (int)std::ceil(maxDistance / texelSize) + 1;
+        int wx0 = std::max(0, x0 - margin), wy0 = std::max(0, y0 - margin);
+        int wx1 = std::min(width, x1 + margin), wy1 = std::min(height, y1 + margin);
+        int w = wx1 - wx0, h = wy1 - wy0;
+        int count = w * h;
+
+        std::vector<unsigned char> inside(count);
+        float ox = originX + wx0 * texelSize, oy = originY + wy0 * texelSize, ts = texelSize;
+        unsigned char* mask = &inside[0];
+        parallelForRanges(h, [=, &grid](int begin, int end) {
+            for (int y = begin; y < end; ++y) {
+                for (int x = 0; x < w; ++x) {
+                    mask[y * w + x] = grid.isInside(Vector2(ox + x * ts, oy + y * ts)) ? 1 : 0;
+                }
+            }
+        }, 16);
+
+        // distância até o exterior (para texels dentro) e até o interior (para texels fora)
+        std::vector<float> toOutside(count), toInside(count);
+        for (int i = 0; i < count; ++i) {
+            toOutside[i] = inside[i] ? SDF_INFINITY : 0.0f;
+            toInside[i] = inside[i] ? 0.0f : SDF_INFINITY;
+        }
+        distanceTransform2D(toOutside, w, h);
+        distanceTransform2D(toInside, w, h);
+
+        // A borda real fica entre dois texels vizinhos: desconta meio texel.
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; ++x) {
+                int i = (y - wy0) * w + (x - wx0);
+                float d = inside[i] ? (std::sqrt(toOutside[i]) - 0.5f) : -(std::sqrt(toInside[i]) - 0.5f);
+                d *= texelSize;
+                if (d > maxDistance) d = maxDistance;
+                if (d < -maxDistance) d = -maxDistance;
+                distances[y * width + x] = d;
+            }
+        }
+    }
+
+public:
+    TrackSDF() : texelSize(4.0f), maxDistance(64.0f), originX(0), originY(0), width(0), height(0) {}
+
+    // Define a resolução do campo (tamanho do texel em pixels) e a distância de truncamento.
+    // Tem efeito na próxima chamada de build.
+    void setResolution(float newTexelSize, float newMaxDistance)
+    {
+        texelSize = newTexelSize > 0.5f ? newTexelSize : 0.5f;
+        maxDistance = newMaxDistance;
+    }
+
+    // Reconstrói o campo a partir da grade de cobertura da pista.
+    void build(const TrackGrid& grid)
+    {
+        distances.clear();
+        width = height = 0;
+        if (grid.getCellsX() == 0) return;
+
+        // a área da grade já tem uma margem fora da curva externa; o campo adiciona
+        // maxDistance de cada lado para que a penetração fique bem definida perto da borda
+        originX = grid.getOriginX() - maxDistance;
+        originY = grid.getOriginY() - maxDistance;
+        width = (int)std::ceil((grid.getCellsX() * grid.getCellSize() + 2.0f * maxDistance) / texelSize) + 1;
+        height = (int)std::ceil((grid.getCellsY() * grid.getCellSize() + 2.0f * maxDistance) / texelSize) + 1;
+        distances.assign(width * height, 0.0f);
+        computeRegion(grid, 0, 0, width, height);
+    }
+
+    // Recalcula o campo depois de uma alteração da pista contida na caixa dada (em pixels),
+    // com a grade já atualizada. O tamanho do campo não muda.
+    void update(const TrackGrid& grid, float minX, float minY, float maxX, float maxY)
+    {
+        if (width == 0) {
+            build(grid);
+            return;
+        }
+        int x0 = (int)std::floor((minX - maxDistance - originX) / texelSize) - 1;
+        int y0 = (int)std::floor((minY - maxDistance - originY) / texelSize) - 1;
+        int x1 = (int)std::ceil((maxX + maxDistance - originX) / texelSize) + 2;
+        int y1 = (int)std::ceil((maxY + maxDistance - originY) / texelSize) + 2;
+        computeRegion(grid, std::max(0, x0), std::max(0, y0), std::min(width, x1), std::min(height, y1));
+    }
+
+    // Retorna a distância com sinal no ponto (interpolação bilinear).
+    // Fora da área do campo retorna -maxDistance (longe da pista).
+    float sample(const Vector2& point) const
+    {
+        if (width == 0) return -maxDistance;
+        float fx = (point.x - originX) / texelSize;
+        float fy = (point.y - originY) / texelSize;
+        if (fx < 0 || fy < 0 || fx > width - 1 || fy > height - 1) return -maxDistance;
+
+        int x0 = (int)fx, y0 = (int)fy;
+        float tx = fx - x0, ty = fy - y0;
+        float top = texel(x0, y0) + (texel(x0 + 1, y0) - texel(x0, y0)) * tx;
+        float bottom = texel(x0, y0 + 1) + (texel(x0 + 1, y0 + 1) - texel(x0, y0 + 1)) * tx;
+        return top + (bottom - top) * ty;
+    }
+
+    // Retorna a distância com sinal e preenche normal com o gradiente normalizado
+    // (diferenças centrais de um texel), que aponta para dentro da pista.
+    float sample(const Vector2& point, Vector2& normal) const
+    {
+        float h = texelSize;
+        float gx = sample(Vector2(point.x + h, point.y)) - sample(Vector2(point.x - h, point.y));
+        float gy = sample(Vector2(point.x, point.y + h)) - sample(Vector2(point.x, point.y - h));
+        normal = Vector2(gx, gy).normalizedSafe();
+        return sample(point);
+    }
+
+    float getTexelSize() const { return texelSize; }
+    float getMaxDistance() const { return maxDistance; }
+};
+
+#endif
@@ -134,6 +134,30 @@ void CV::polygonFill(float vx[], float vy[], int elems)
    glEnd();
 }
 
+//desenha um lote de primitivas com arrays de vertices (uma unica chamada de desenho)
+static void drawArrays(GLenum mode, const float *vertices, const float *colors, int n_vertices)
+{
+   if( n_vertices <= 0 || vertices == NULL || colors == NULL )
+      return;
+   glEnableClientState(GL_VERTEX_ARRAY);
+   glEnableClientState(GL_COLOR_ARRAY);
+   glVertexPointer(2, GL_FLOAT, 0, vertices);
+   glColorPointer(3, GL_FLOAT, 0, colors);
+   glDrawArrays(mode, 0, n_vertices);
+   glDisableClientState(GL_COLOR_ARRAY);
+   glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+void CV::trianglesFill(const float *vertices, const float *colors, int n_vertices)
+{
+   drawArrays(GL_TRIANGLES, vertices, colors, n_vertices);
+}
+
+void CV::lines(const float *vertices, const float *colors, int n_vertices)
+{
+   drawArrays(GL_LINES, vertices, colors, n_vertices);
+}
+
 // existem outras fontes de texto que podem ser usadas
 //   GLUT_BITMAP_9_BY_15
 //   GLUT_BITMAP_TIMES_ROMAN_10
@@ -236,6 +260,19 @@ void CV::translate(Vector2 offset)
    glTranslated(offset.x, offset.y, 0);
 }
 
+// camera 2D: desloca a projecao ortografica, entao continua valendo com translate().
+void CV::camera(float x, float y)
+{
+   glMatrixMode(GL_PROJECTION);
+   glLoadIdentity();
+#if Y_CANVAS_CRESCE_PARA_CIMA == TRUE
+   gluOrtho2D(x, x + *scrWidth, y, y + *scrHeight);
+#else
+   gluOrtho2D(x, x + *scrWidth, y + *scrHeight, y);
+#endif
+   glMatrixMode(GL_MODELVIEW);
+}
+
 void CV::color(float r, float g, float b)
 {
    glColor3d(r, g, b);
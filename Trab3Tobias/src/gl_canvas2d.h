@@ -41,6 +41,10 @@ public:
     static void polygon(float vx[], float vy[], int n_elems);
     static void polygonFill(float vx[], float vy[], int n_elems);
 
+    //desenho em lote: vertices (x,y) e cores (r,g,b) intercalados, um por vertice.
+    static void trianglesFill(const float *vertices, const float *colors, int n_vertices); //a cada 3 vertices, um triangulo
+    static void lines(const float *vertices, const float *colors, int n_vertices); //a cada 2 vertices, uma linha
+
     //centro e raio do circulo
     static void circle( float x, float y, float radius, int div );
     static void circle( Vector2 pos, float radius, int div );
@@ -68,6 +72,10 @@ public:
     static void translate(float x, float y);
     static void translate(Vector2 pos);
 
+    //camera 2D: o ponto (x,y) do mundo passa a ser o canto inferior esquerdo da tela.
+    //camera(0, 0) volta a desenhar em coordenadas da tela.
+    static void camera(float x, float y);
+
     //funcao de inicializacao da Canvas2D. Recebe a largura, altura, e um titulo para a janela
     static void init(int *w, int *h, const char *title);
 
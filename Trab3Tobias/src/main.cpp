@@ -4,9 +4,12 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "gl_canvas2d.h"
 #include "Frames.h"
 #include "Tela.h"
+#include "Benchmark.h"
+#include "Replay.h"
 
 
 float fps = 60;
@@ -76,9 +79,55 @@ void mouse(int button, int state, int wheel, int direction, int x, int y)
     
 }
 
-int main(void)
+// "--bench" executa o benchmark de estresse sem abrir janela.
+// "--replay <arquivo>" reproduz e confere uma partida gravada, sem abrir janela
+// (com "--audio <saida.wav>" depois do arquivo, grava também os efeitos sonoros).
+// "--record <arquivo>" joga normalmente, gravando as entradas da partida no arquivo.
+// "--world <n>" usa um mundo de n x n telas, com a câmera seguindo o tanque (pode ser
+// combinado com "--record").
+// "--audio <arquivo.wav>" grava os efeitos sonoros das partidas no arquivo.
+int main(int argc, char *argv[])
 {
-    tela = new Tela(screenWidth, screenHeight);
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0)
+    {
+        Benchmark(screenWidth, screenHeight).run();
+        return 0;
+    }
+    if (argc > 2 && strcmp(argv[1], "--replay") == 0)
+    {
+        const char *audioPath = (argc > 4 && strcmp(argv[3], "--audio") == 0) ? argv[4] : NULL;
+        return ReplayRunner::run(argv[2], audioPath);
+    }
+
+    int worldScale = 1;
+    const char *recordingPath = NULL;
+    const char *audioPath = NULL;
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (strcmp(argv[i], "--world") == 0)
+        {
+            worldScale = atoi(argv[i + 1]);
+            if (worldScale < 1) worldScale = 1;
+        }
+        else if (strcmp(argv[i], "--record") == 0)
+        {
+            recordingPath = argv[i + 1];
+        }
+        else if (strcmp(argv[i], "--audio") == 0)
+        {
+            audioPath = argv[i + 1];
+        }
+    }
+
+    tela = new Tela(screenWidth, screenHeight, worldScale);
+    if (recordingPath)
+    {
+        tela->setRecordingPath(recordingPath);
+    }
+    if (audioPath && !tela->setAudioOutput(audioPath))
+    {
+        printf("audio: nao foi possivel gravar em %s\n", audioPath);
+    }
 
     CV::run();
 }